@@ -32,6 +32,12 @@ then
         printf "%s\n" "list(APPEND $cmake_defines_var PROJECT_TARGET_ANALOG_FILTER_EMA)" >> "$out_cmakelists"
     fi
 
+    # scan recently moved inputs more often than idle ones (multiplexed inputs only)
+    if [[ "$($yaml_parser "$yaml_file" analog.activityScan)" == "true" ]]
+    then
+        printf "%s\n" "list(APPEND $cmake_defines_var PROJECT_TARGET_ADC_ACTIVITY_SCAN)" >> "$out_cmakelists"
+    fi
+
     analog_in_type=$($yaml_parser "$yaml_file" analog.type)
 
     declare -i nr_of_analog_inputs
@@ -192,17 +192,40 @@ then
 
             number_of_rows=$($yaml_parser "$yaml_file" buttons.rows.pins --length)
 
+            unset port_duplicates
+            unset port_array
+            unset index_array
+            unset port_array_unique
+            declare -A port_duplicates
+            declare -a port_array
+            declare -a index_array
+            declare -a port_array_unique
+
            for ((i=0; i<number_of_rows; i++))
             do
                 port=$($yaml_parser "$yaml_file" buttons.rows.pins.["$i"].port)
                 index=$($yaml_parser "$yaml_file" buttons.rows.pins.["$i"].index)
 
+                port_array+=("$port")
+                index_array+=("$index")
+
                 {
                     printf "%s\n" "#define PIN_PORT_DIN_${i} CORE_MCU_IO_PIN_PORT_DEF(${port})"
                     printf "%s\n" "#define PIN_INDEX_DIN_${i} CORE_MCU_IO_PIN_INDEX_DEF(${index})"
                 } >> "$out_header"
+
+                if [[ -z ${port_duplicates[$port]} ]]
+                then
+                    port_array_unique+=("$port")
+                fi
+
+                port_duplicates["$port"]=1
             done
 
+            # rows are scanned port by port: generate list of unique row ports and
+            # port/pin index of each row within that list
+            printf "%s\n" "#define PROJECT_TARGET_NR_OF_DIGITAL_INPUT_PORTS ${#port_array_unique[@]}" >> "$out_header"
+
             {
                 printf "%s\n" "namespace gen {"
                 printf "%s\n" "constexpr inline core::mcu::io::pin_t BUTTON_PIN[PROJECT_TARGET_NR_OF_BUTTON_ROWS] = {"
@@ -213,6 +236,42 @@ then
                 printf "%s\n" "core::mcu::io::pin_t{PIN_PORT_DIN_${i}, PIN_INDEX_DIN_${i}}," >> "$out_header"
             done
 
+            {
+                printf "%s\n" "};"
+                printf "%s\n" "constexpr inline core::mcu::io::pinPort_t DIGITAL_IN_PORT[PROJECT_TARGET_NR_OF_DIGITAL_INPUT_PORTS] = {"
+            } >> "$out_header"
+
+            for ((i=0; i<${#port_array_unique[@]}; i++))
+            do
+                printf "%s\n" "CORE_MCU_IO_PIN_PORT_DEF(${port_array_unique[$i]})," >> "$out_header"
+            done
+
+            {
+                printf "%s\n" "};"
+                printf "%s\n" "constexpr inline uint8_t BUTTON_PORT_INDEX[PROJECT_TARGET_NR_OF_BUTTON_ROWS] = {"
+            } >> "$out_header"
+
+            for ((i=0; i<number_of_rows; i++))
+            do
+                for ((port=0; port<${#port_array_unique[@]}; port++))
+                do
+                    if [[ ${port_array[$i]} == "${port_array_unique[$port]}" ]]
+                    then
+                        printf "%s\n" "$port," >> "$out_header"
+                    fi
+                done
+            done
+
+            {
+                printf "%s\n" "};"
+                printf "%s\n" "constexpr inline uint8_t BUTTON_PIN_INDEX[PROJECT_TARGET_NR_OF_BUTTON_ROWS] = {"
+            } >> "$out_header"
+
+            for ((i=0; i<number_of_rows; i++))
+            do
+                printf "%s\n" "${index_array[i]}," >> "$out_header"
+            done
+
             {
                 printf "%s\n" "};"
                 printf "%s\n" "}"
@@ -22,6 +22,20 @@ then
             printf "%s\n" "list(APPEND $cmake_defines_var PROJECT_TARGET_SUPPORT_SOFT_PWM)"
         } >> "$out_cmakelists"
 
+        # Optional binary code modulation dimming with specified amount of bit planes
+        bcm_bits=$($yaml_parser "$yaml_file" leds.external.bcmBits)
+
+        if [[ $bcm_bits != "null" ]]
+        then
+            if [[ $bcm_bits -lt 6 || $bcm_bits -gt 8 ]]
+            then
+                echo "Amount of BCM bit planes must be in range 6-8"
+                exit 1
+            fi
+
+            printf "%s\n" "list(APPEND $cmake_defines_var PROJECT_TARGET_LEDS_EXT_BCM_BITS=$bcm_bits)" >> "$out_cmakelists"
+        fi
+
         unset port_duplicates
         unset port_array
         unset index_array
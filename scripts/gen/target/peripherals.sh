@@ -207,10 +207,36 @@ then
         fi
 
         printf "%s\n" "list(APPEND $cmake_defines_var PROJECT_TARGET_SUPPORTED_NR_OF_TOUCHSCREEN_COMPONENTS=$nr_of_touchscreen_components)" >> "$out_cmakelists"
+
+        # Maximum amount of registers written in a single frame for displays which support bulk writes
+        touchscreen_max_frame_registers=$($yaml_parser "$yaml_file" uart.touchscreen.maxFrameRegisters | grep -v null | awk '{print$1}END{if(NR==0)print 16}')
+
+        printf "%s\n" "list(APPEND $cmake_defines_var PROJECT_TARGET_TOUCHSCREEN_MAX_FRAME_REGISTERS=$touchscreen_max_frame_registers)" >> "$out_cmakelists"
     else
         printf "%s\n" "list(APPEND $cmake_defines_var PROJECT_TARGET_SUPPORTED_NR_OF_TOUCHSCREEN_COMPONENTS=0)" >> "$out_cmakelists"
     fi
 
+    if [[ "$($yaml_parser "$yaml_file" uart.logger)" != "null" ]]
+    then
+        uart_channel_logger=$($yaml_parser "$yaml_file" uart.logger.channel)
+
+        if [[ $uart_channel_logger == "null" ]]
+        then
+            echo "Logger UART channel left unspecified"
+            exit 1
+        fi
+
+        if [[ -n "$uart_channel_usb_link" && $uart_channel_usb_link -eq $uart_channel_logger ]] || \
+           [[ -n "$uart_channel_din_midi" && $uart_channel_din_midi -eq $uart_channel_logger ]] || \
+           [[ -n "$uart_channel_touchscreen" && $uart_channel_touchscreen -eq $uart_channel_logger ]]
+        then
+            echo "Logger UART channel cannot be shared with other UART peripherals"
+            exit 1
+        fi
+
+        printf "%s\n" "list(APPEND $cmake_defines_var PROJECT_TARGET_UART_CHANNEL_LOGGER=$uart_channel_logger)" >> "$out_cmakelists"
+    fi
+
     if [[ "$use_custom_uart_pins" -eq 1 ]]
     then
         {
@@ -113,6 +113,8 @@ namespace database
                 CHANNEL,
                 LOWER_OFFSET,
                 UPPER_OFFSET,
+                AFTERTOUCH_RATE,
+                AFTERTOUCH_SLEW,
                 AMOUNT
             };
 
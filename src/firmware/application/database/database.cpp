@@ -37,22 +37,13 @@ using namespace lib::lessdb;
 database::Admin::Admin(Hwa&    hwa,
                        Layout& layout)
     : LessDb::LessDb(hwa)
+    , _hwa(hwa)
     , _layout(layout)
     , INITIALIZE_DATA(hwa.initializeDatabase())
 {
-    ConfigHandler.registerConfig(
-        sys::Config::block_t::GLOBAL,
-        // read
-        [this](uint8_t section, size_t index, uint16_t& value)
-        {
-            return sysConfigGet(static_cast<sys::Config::Section::global_t>(section), index, value);
-        },
-
-        // write
-        [this](uint8_t section, size_t index, uint16_t value)
-        {
-            return sysConfigSet(static_cast<sys::Config::Section::global_t>(section), index, value);
-        });
+    ConfigHandler.registerConfig<&database::Admin::sysConfigGet, &database::Admin::sysConfigSet>(sys::Config::block_t::GLOBAL,
+                                                                                                 this,
+                                                                                                 { sys::Config::Section::global_t::SYSTEM_SETTINGS });
 }
 
 bool database::Admin::init(Handlers& handlers)
@@ -68,6 +59,8 @@ bool database::Admin::init()
         return false;
     }
 
+    _systemBlockValid = false;
+
     uint32_t systemBlockUsage = 0;
 
     // set only system block for now
@@ -145,6 +138,13 @@ bool database::Admin::isInitialized()
     return _initialized;
 }
 
+/// Performs single step of background storage maintenance.
+/// Should be called from main loop.
+void database::Admin::updateStorage()
+{
+    _hwa.update();
+}
+
 /// Performs full factory reset of data in database.
 bool database::Admin::factoryReset()
 {
@@ -153,6 +153,9 @@ bool database::Admin::factoryReset()
         _handlers->factoryResetStart();
     }
 
+    // system block copy needs to be reloaded after everything has been reset
+    _systemBlockValid = false;
+
     if (!clear())
     {
         return false;
@@ -173,6 +176,8 @@ bool database::Admin::factoryReset()
             return false;
         }
 
+        _systemBlockValid = false;
+
         for (int i = _supportedPresets - 1; i >= 0; i--)
         {
             if (!setPresetInternal(i))
@@ -403,25 +408,68 @@ std::optional<uint8_t> database::Admin::sysConfigSet(sys::Config::Section::globa
     return result;
 }
 
-uint16_t database::Admin::readSystemBlock(size_t index)
+/// Reads entire system block into RAM with a single layout switch.
+bool database::Admin::loadSystemBlock()
 {
-    uint16_t value = 0;
+    bool retVal = true;
 
     SYSTEM_BLOCK_ENTER(
-        value = LessDb::read(0,
-                             static_cast<uint8_t>(Config::Section::system_t::SYSTEM_SETTINGS),
-                             index);)
+        for (size_t i = 0; i < _systemBlock.size(); i++)
+        {
+            uint32_t value = 0;
+
+            if (!LessDb::read(0, static_cast<uint8_t>(Config::Section::system_t::SYSTEM_SETTINGS), i, value))
+            {
+                retVal = false;
+                break;
+            }
 
-    return value;
+            _systemBlock[i] = value;
+        })
+
+    _systemBlockValid = retVal;
+
+    return retVal;
+}
+
+uint16_t database::Admin::readSystemBlock(size_t index)
+{
+    if (index >= _systemBlock.size())
+    {
+        return 0;
+    }
+
+    if (!_systemBlockValid)
+    {
+        loadSystemBlock();
+    }
+
+    return _systemBlock[index];
 }
 
 bool database::Admin::updateSystemBlock(size_t index, uint16_t value)
 {
+    if (index >= _systemBlock.size())
+    {
+        return false;
+    }
+
+    if (_systemBlockValid && (_systemBlock[index] == value))
+    {
+        // nothing to write
+        return true;
+    }
+
     bool retVal = false;
 
     SYSTEM_BLOCK_ENTER(
         retVal = LessDb::update(0, static_cast<uint8_t>(Config::Section::system_t::SYSTEM_SETTINGS), index, value);)
 
+    if (retVal)
+    {
+        _systemBlock[index] = value;
+    }
+
     return retVal;
 }
 
@@ -22,6 +22,7 @@ limitations under the License.
 #include "deps.h"
 #include "application/system/config.h"
 
+#include <array>
 #include <type_traits>
 #include <optional>
 
@@ -104,6 +105,7 @@ namespace database
         void    registerHandlers(Handlers& handlers);
         bool    setPresetPreserveState(bool state);
         bool    getPresetPreserveState();
+        void    updateStorage();
 
         static constexpr Config::block_t BLOCK(Config::Section::global_t section)
         {
@@ -141,6 +143,7 @@ namespace database
         }
 
         private:
+        Hwa&      _hwa;
         Layout&   _layout;
         Handlers* _handlers = nullptr;
 
@@ -159,6 +162,15 @@ namespace database
         uint16_t _uid              = 0;
         bool     _initialized      = false;
 
+        /// RAM copy of the system block.
+        /// System block is shared between all presets and accessing it in database requires
+        /// switching the layout back and forth, so it's read once and served from here.
+        /// This stands in for compile-time address tables, which LessDb doesn't support (see AppLayout).
+        std::array<uint16_t, static_cast<size_t>(Config::systemSetting_t::AMOUNT)> _systemBlock = {};
+
+        /// Set once system block copy matches the database contents.
+        bool _systemBlockValid = false;
+
         void                   customInitGlobal();
         void                   customInitButtons();
         void                   customInitEncoders();
@@ -169,6 +181,7 @@ namespace database
         bool                   isSignatureValid();
         bool                   setUID();
         bool                   setPresetInternal(uint8_t preset);
+        bool                   loadSystemBlock();
         uint16_t               readSystemBlock(size_t index);
         bool                   updateSystemBlock(size_t index, uint16_t value);
         std::optional<uint8_t> sysConfigGet(sys::Config::Section::global_t section, size_t index, uint16_t& value);
@@ -26,6 +26,7 @@ namespace database
     {
         public:
         virtual bool initializeDatabase() = 0;
+        virtual void update()             = 0;
     };
 
     // Database has circular dependency problem: to define layout, details are needed
@@ -50,6 +50,42 @@ namespace database
                                       }
                                       break;
 
+                                      case messaging::systemMessage_t::CONFIG_TRANSACTION_START:
+                                      {
+                                          _writeToCache = true;
+                                      }
+                                      break;
+
+                                      case messaging::systemMessage_t::CONFIG_TRANSACTION_END:
+                                      {
+                                          // all values changed within the transaction are flushed at once
+                                          // this includes the writes deferred due to traffic as well
+                                          board::nvm::writeCacheToFlash();
+                                          _writeToCache = false;
+                                          _cachePending = false;
+                                      }
+                                      break;
+
+                                      case messaging::systemMessage_t::TRAFFIC_ACTIVE:
+                                      {
+                                          _trafficActive = true;
+                                      }
+                                      break;
+
+                                      case messaging::systemMessage_t::TRAFFIC_IDLE:
+                                      {
+                                          _trafficActive = false;
+
+                                          if (_cachePending && !_writeToCache)
+                                          {
+                                              // store everything changed during the performance
+                                              // page transfer, if needed, happens now
+                                              board::nvm::writeCacheToFlash();
+                                              _cachePending = false;
+                                          }
+                                      }
+                                      break;
+
                                       default:
                                           break;
                                       }
@@ -85,16 +121,56 @@ namespace database
 
         bool write(uint32_t address, uint32_t value, database::Admin::sectionParameterType_t type) override
         {
-            return board::nvm::write(address, value, boardParamType(type), _writeToCache);
+            // Writing to flash can take a long time once emulated EEPROM page needs to be transferred.
+            // Avoid that while there's MIDI traffic: keep the changes in cache until idle.
+            bool cacheOnly = _writeToCache || _trafficActive;
+
+            if (!cacheOnly)
+            {
+                // Skip writes which wouldn't change anything: erased memory reads as 0, so
+                // after factory reset only values which differ from that end up being stored.
+                // Cached writes are always passed through since reads might not reflect the cache.
+                uint32_t currentValue = 0;
+
+                if (board::nvm::read(address, currentValue, boardParamType(type)) && (currentValue == value))
+                {
+                    return true;
+                }
+            }
+
+            if (!board::nvm::write(address, value, boardParamType(type), cacheOnly))
+            {
+                return false;
+            }
+
+            if (cacheOnly)
+            {
+                _cachePending = true;
+            }
+
+            return true;
         }
 
         bool initializeDatabase() override
         {
+#ifdef OPENDECK_USE_NVM_INCREMENTAL_TRANSFER
+            // factory page is in emulated EEPROM library format and isn't used
+            return true;
+#else
             return PROJECT_MCU_DATABASE_INIT_DATA;
+#endif
+        }
+
+        void update() override
+        {
+            // erasing flash stalls everything: postpone it until the traffic stops
+            board::nvm::update(!_trafficActive);
         }
 
         private:
-        bool _writeToCache = false;
+        bool _writeToCache  = false;
+        bool _trafficActive = false;
+        bool _cachePending  = false;
 
         board::nvm::parameterType_t boardParamType(database::Admin::sectionParameterType_t type)
         {
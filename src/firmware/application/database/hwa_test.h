@@ -132,7 +132,12 @@ namespace database
 
         bool write(uint32_t address, uint32_t value, lib::lessdb::sectionParameterType_t type) override
         {
+            _writes++;
+
 #ifdef PROJECT_MCU_USE_EMU_EEPROM
+            // each write is appended to emulated EEPROM page as a single 32-bit record
+            _bytesWritten += sizeof(uint32_t);
+
             uint16_t tempData;
 
             switch (type)
@@ -164,6 +169,7 @@ namespace database
             case lib::lessdb::sectionParameterType_t::HALF_BYTE:
             {
                 _memoryArray.at(address) = value;
+                _bytesWritten += sizeof(uint8_t);
             }
             break;
 
@@ -171,11 +177,14 @@ namespace database
             {
                 _memoryArray.at(address + 0) = (value >> 0) & (uint16_t)0xFF;
                 _memoryArray.at(address + 1) = (value >> 8) & (uint16_t)0xFF;
+                _bytesWritten += sizeof(uint16_t);
             }
             break;
 
             default:
             {
+                _bytesWritten += sizeof(uint32_t);
+
                 // case lib::lessdb::sectionParameterType_t::DWORD:
                 _memoryArray.at(address + 0) = (value >> 0) & (uint32_t)0xFF;
                 _memoryArray.at(address + 1) = (value >> 8) & (uint32_t)0xFF;
@@ -194,6 +203,22 @@ namespace database
             return true;
         }
 
+        void update() override
+        {
+        }
+
+        void resetStats()
+        {
+            _writes       = 0;
+            _bytesWritten = 0;
+        }
+
+        /// Amount of write requests received from database.
+        size_t _writes = 0;
+
+        /// Amount of bytes written to the memory.
+        size_t _bytesWritten = 0;
+
         private:
 #ifdef PROJECT_MCU_USE_EMU_EEPROM
         class HwaEmuEeprom : public lib::emueeprom::Hwa
@@ -29,6 +29,10 @@ limitations under the License.
 
 namespace database
 {
+    /// Sections are kept in std::vector instead of constexpr tables with precomputed offsets:
+    /// LessDb::setLayout() takes the blocks as vectors and calculates the addresses itself.
+    /// Layout switching cost this causes is avoided for the only block accessed outside of
+    /// the active preset (system block) by keeping its RAM copy in Admin.
     class AppLayout : public database::Layout
     {
         public:
@@ -410,6 +414,24 @@ namespace database
                 lib::lessdb::autoIncrementSetting_t::DISABLE,
                 0,
             },
+
+            // fsr aftertouch rate section
+            {
+                io::analog::Collection::SIZE(),
+                lib::lessdb::sectionParameterType_t::BYTE,
+                lib::lessdb::preserveSetting_t::DISABLE,
+                lib::lessdb::autoIncrementSetting_t::DISABLE,
+                0,
+            },
+
+            // fsr aftertouch slew section
+            {
+                io::analog::Collection::SIZE(),
+                lib::lessdb::sectionParameterType_t::HALF_BYTE,
+                lib::lessdb::preserveSetting_t::DISABLE,
+                lib::lessdb::autoIncrementSetting_t::DISABLE,
+                0,
+            },
         };
 
         std::vector<lib::lessdb::Section> _ledSections = {
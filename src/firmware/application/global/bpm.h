@@ -65,6 +65,37 @@ namespace global
             return false;
         }
 
+        /// Follows the tempo of the incoming MIDI clock.
+        /// Deviations smaller than FOLLOW_HYSTERESIS_X10 are ignored so that
+        /// the tempo doesn't toggle between two neighbouring values.
+        /// param [in]: bpmX10  Estimated tempo multiplied by 10.
+        void follow(uint32_t bpmX10)
+        {
+            uint32_t current    = static_cast<uint32_t>(_bpm) * 10;
+            uint32_t difference = bpmX10 > current ? bpmX10 - current : current - bpmX10;
+
+            if (difference < FOLLOW_HYSTERESIS_X10)
+            {
+                return;
+            }
+
+            uint32_t newBpm = (bpmX10 + 5) / 10;
+
+            if (newBpm < MIN_BPM)
+            {
+                newBpm = MIN_BPM;
+            }
+            else if (newBpm > MAX_BPM)
+            {
+                newBpm = MAX_BPM;
+            }
+
+            if (newBpm != _bpm)
+            {
+                set(newBpm);
+            }
+        }
+
         uint8_t value()
         {
             return _bpm;
@@ -78,9 +109,13 @@ namespace global
         private:
         Bpm() = default;
 
-        using BpmIncDec = util::IncDec<uint8_t, 10, 255>;
+        static constexpr uint8_t MIN_BPM = 10;
+        static constexpr uint8_t MAX_BPM = 255;
+
+        using BpmIncDec = util::IncDec<uint8_t, MIN_BPM, MAX_BPM>;
 
-        static constexpr uint32_t PPQN = 24;
+        static constexpr uint32_t PPQN                  = 24;
+        static constexpr uint32_t FOLLOW_HYSTERESIS_X10 = 7;
 
         uint8_t _bpm = 120;
 
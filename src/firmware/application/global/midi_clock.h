@@ -0,0 +1,250 @@
+/*
+
+Copyright Igor Petrovic
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#pragma once
+
+#include <inttypes.h>
+#include <stddef.h>
+
+namespace global
+{
+    /// Tracks incoming MIDI clock.
+    /// Pulse times are filtered with second-order (alpha-beta) PLL which estimates
+    /// both the pulse period and the phase of the clock. Components which follow the
+    /// clock use the smoothed phase instead of raw pulses so that the jitter of incoming
+    /// clock (typical for USB clock from DAWs) isn't visible on outputs.
+    class MidiClock
+    {
+        public:
+        // This class can be used across various application modules but
+        // state must be preserved - hence the singleton approach.
+
+        static MidiClock& instance()
+        {
+            static MidiClock clock;
+            return clock;
+        }
+
+        struct Stats
+        {
+            /// Average absolute difference between received and predicted pulse time.
+            uint32_t averageJitterUs = 0;
+
+            /// Largest absolute difference between received and predicted pulse time.
+            uint32_t maxJitterUs = 0;
+
+            /// Amount of pulses received since the stats have been reset.
+            uint32_t pulses = 0;
+        };
+
+        /// Resets the phase of the clock. Called on MIDI start.
+        /// Tempo estimate is preserved.
+        void start()
+        {
+            _pulses         = 0;
+            _reportedPulses = 0;
+            _lastPulseValid = false;
+        }
+
+        /// Clears all tracking state, including tempo estimate and stats.
+        void reset()
+        {
+            *this = MidiClock();
+        }
+
+        /// Registers received clock pulse.
+        /// param [in]: timeMs  Time in milliseconds at which the pulse has been received.
+        void pulse(uint32_t timeMs)
+        {
+            const uint32_t TIME_US = timeMs * 1000;
+
+            _pulses++;
+
+            if (!_lastPulseValid)
+            {
+                _lastPulseValid = true;
+                _lastPulseUs    = TIME_US;
+                _correctedUs    = TIME_US;
+                return;
+            }
+
+            const uint32_t INTERVAL = TIME_US - _lastPulseUs;
+            _lastPulseUs            = TIME_US;
+
+            // clock has been stopped in between or this is the first interval: (re)lock
+            if (!_periodUs || (INTERVAL > MAX_PERIOD_US))
+            {
+                relock(INTERVAL, TIME_US);
+                return;
+            }
+
+            int32_t  error    = static_cast<int32_t>(TIME_US - (_correctedUs + _periodUs));
+            uint32_t absError = error < 0 ? -error : error;
+
+            if (absError > _periodUs)
+            {
+                // sudden tempo change: relock if the error persists
+                if (++_outliers >= RELOCK_OUTLIERS)
+                {
+                    relock(INTERVAL, TIME_US);
+                    return;
+                }
+
+                // otherwise limit the influence of single outlier
+                error = error < 0 ? -static_cast<int32_t>(_periodUs) : static_cast<int32_t>(_periodUs);
+            }
+            else
+            {
+                _outliers = 0;
+            }
+
+            _correctedUs += _periodUs + (error / PHASE_GAIN_DIVIDER);
+            _periodUs = static_cast<uint32_t>(static_cast<int32_t>(_periodUs) + (error / PERIOD_GAIN_DIVIDER));
+
+            if (_periodUs < MIN_PERIOD_US)
+            {
+                _periodUs = MIN_PERIOD_US;
+            }
+
+            if (_lockedPulses < LOCK_PULSES)
+            {
+                _lockedPulses++;
+                return;
+            }
+
+            // jitter is tracked only once the filter is locked
+            _stats.pulses++;
+            _jitterSumUs += absError;
+            _stats.averageJitterUs = _jitterSumUs / _stats.pulses;
+
+            if (absError > _stats.maxJitterUs)
+            {
+                _stats.maxJitterUs = absError;
+            }
+        }
+
+        /// Returns true once the tempo estimate is stable.
+        bool locked()
+        {
+            return _lockedPulses >= LOCK_PULSES;
+        }
+
+        /// Returns the amount of pulses since start based on the smoothed clock phase.
+        /// Until the clock is locked, the amount of received pulses is returned.
+        /// Returned value never decreases between two starts.
+        /// param [in]: timeMs  Current time in milliseconds.
+        uint32_t pulses(uint32_t timeMs)
+        {
+            uint32_t pulses = _pulses;
+
+            if (locked())
+            {
+                auto elapsed = static_cast<int32_t>((timeMs * 1000) - _correctedUs);
+
+                if (elapsed < 0)
+                {
+                    // smoothed time of the last received pulse hasn't been reached yet
+                    pulses--;
+                }
+                else if (static_cast<uint32_t>(elapsed) >= _periodUs)
+                {
+                    // late pulse: run ahead of received ones by at most one pulse
+                    pulses++;
+                }
+            }
+
+            if (pulses > _reportedPulses)
+            {
+                _reportedPulses = pulses;
+            }
+
+            return _reportedPulses;
+        }
+
+        /// Returns the estimated pulse period in microseconds.
+        uint32_t periodUs()
+        {
+            return _periodUs;
+        }
+
+        /// Returns the estimated tempo multiplied by 10.
+        uint32_t bpmX10()
+        {
+            if (!_periodUs)
+            {
+                return 0;
+            }
+
+            return ((60000000UL * 10 / PPQN) + (_periodUs / 2)) / _periodUs;
+        }
+
+        const Stats& stats()
+        {
+            return _stats;
+        }
+
+        void resetStats()
+        {
+            _stats       = {};
+            _jitterSumUs = 0;
+        }
+
+        private:
+        MidiClock() = default;
+
+        static constexpr uint32_t PPQN = 24;
+
+        /// Pulse period at 10 BPM (slowest supported tempo) - longer intervals mean that the clock has been stopped.
+        static constexpr uint32_t MAX_PERIOD_US = 60000000 / PPQN / 10;
+
+        /// Pulse period at 1000 BPM.
+        static constexpr uint32_t MIN_PERIOD_US = 60000000 / PPQN / 1000;
+
+        /// Phase (alpha) and period (beta) gains of the filter: 1/4 and 1/32.
+        /// Beta is kept below alpha^2 / (2 - alpha) so that the loop doesn't overshoot.
+        static constexpr int32_t PHASE_GAIN_DIVIDER  = 4;
+        static constexpr int32_t PERIOD_GAIN_DIVIDER = 32;
+
+        /// Amount of filtered pulses (one quarter note) after which the estimate is considered stable.
+        static constexpr uint8_t LOCK_PULSES = PPQN;
+
+        /// Amount of successive pulses with error larger than the period after which the filter relocks.
+        static constexpr uint8_t RELOCK_OUTLIERS = 3;
+
+        bool     _lastPulseValid = false;
+        uint32_t _lastPulseUs    = 0;
+        uint32_t _correctedUs    = 0;
+        uint32_t _periodUs       = 0;
+        uint32_t _pulses         = 0;
+        uint32_t _reportedPulses = 0;
+        uint8_t  _lockedPulses   = 0;
+        uint8_t  _outliers       = 0;
+        uint64_t _jitterSumUs    = 0;
+        Stats    _stats          = {};
+
+        void relock(uint32_t interval, uint32_t timeUs)
+        {
+            _periodUs     = interval > MAX_PERIOD_US ? 0 : interval;
+            _correctedUs  = timeUs;
+            _lockedPulses = 0;
+            _outliers     = 0;
+        }
+    };
+}    // namespace global
+
+#define MidiClock global::MidiClock::instance()
@@ -23,6 +23,7 @@ limitations under the License.
 #include "application/util/conversion/conversion.h"
 #include "application/util/configurable/configurable.h"
 
+#include "core/mcu.h"
 #include "core/util/util.h"
 
 using namespace io::analog;
@@ -46,24 +47,18 @@ Analog::Analog(Hwa&      hwa,
                               }
                               break;
 
+                              case messaging::systemMessage_t::PRESET_CHANGED:
+                              {
+                                  publishScanList();
+                              }
+                              break;
+
                               default:
                                   break;
                               }
                           });
 
-    ConfigHandler.registerConfig(
-        sys::Config::block_t::ANALOG,
-        // read
-        [this](uint8_t section, size_t index, uint16_t& value)
-        {
-            return sysConfigGet(static_cast<sys::Config::Section::analog_t>(section), index, value);
-        },
-
-        // write
-        [this](uint8_t section, size_t index, uint16_t value)
-        {
-            return sysConfigSet(static_cast<sys::Config::Section::analog_t>(section), index, value);
-        });
+    ConfigHandler.registerConfig<&Analog::sysConfigGet, &Analog::sysConfigSet>(sys::Config::block_t::ANALOG, this);
 }
 
 bool Analog::init()
@@ -73,9 +68,20 @@ bool Analog::init()
         reset(i);
     }
 
+    publishScanList();
+
     return true;
 }
 
+void Analog::publishScanList()
+{
+    // disabled inputs are skipped by the ADC so that the enabled ones get sampled more often
+    for (size_t i = 0; i < Collection::SIZE(GROUP_ANALOG_INPUTS); i++)
+    {
+        _hwa.setEnabled(i, _database.read(database::Config::Section::analog_t::ENABLE, i));
+    }
+}
+
 void Analog::updateSingle(size_t index, bool forceRefresh)
 {
     if (index >= maxComponentUpdateIndex())
@@ -87,14 +93,14 @@ void Analog::updateSingle(size_t index, bool forceRefresh)
     {
         uint16_t value;
 
-        if (!_hwa.value(index, value))
+        if (_hwa.value(index, value))
         {
-            return;
+            processSaxBreathController(index, value);
+            processReading(index, value);
         }
 
-        processSaxBreathController(index, value);
-
-        processReading(index, value);
+        // pending aftertouch is sent once the rate limit allows it, even without new readings
+        updateAftertouch(index);
     }
     else
     {
@@ -254,6 +260,10 @@ void Analog::processReading(size_t index, uint16_t value)
         {
             send = true;
         }
+        else if (fsrState(index))
+        {
+            setAftertouch(index, filterDescriptor.pressure);
+        }
     }
     break;
 
@@ -363,6 +373,11 @@ bool Analog::checkFSRvalue(size_t index, Descriptor& descriptor)
         {
             // sensor is really pressed
             setFSRstate(index, true);
+
+            // aftertouch starts from zero for each note and follows only after the note is sent
+            _aftertouch[index]              = {};
+            _aftertouch[index].lastSendTime = core::mcu::timing::ms();
+
             return true;
         }
     }
@@ -371,6 +386,10 @@ bool Analog::checkFSRvalue(size_t index, Descriptor& descriptor)
         if (fsrState(index))
         {
             setFSRstate(index, false);
+
+            // no aftertouch after note off
+            _aftertouch[index].pending = false;
+
             return true;
         }
     }
@@ -378,6 +397,80 @@ bool Analog::checkFSRvalue(size_t index, Descriptor& descriptor)
     return false;
 }
 
+/// Stores new aftertouch pressure of pressed FSR sensor.
+/// Pressure is sent by updateAftertouch at most at configured rate: if several readings
+/// are received in the meantime, only the latest one is sent.
+void Analog::setAftertouch(size_t index, uint16_t pressure)
+{
+    if (!_database.read(database::Config::Section::analog_t::AFTERTOUCH_RATE, index))
+    {
+        return;
+    }
+
+    auto& aftertouch = _aftertouch[index];
+
+    if (pressure > midi::MAX_VALUE_7BIT)
+    {
+        pressure = midi::MAX_VALUE_7BIT;
+    }
+
+    aftertouch.target  = pressure;
+    aftertouch.pending = aftertouch.target != aftertouch.sent;
+}
+
+void Analog::updateAftertouch(size_t index)
+{
+    auto& aftertouch = _aftertouch[index];
+
+    if (!aftertouch.pending)
+    {
+        return;
+    }
+
+    const uint32_t RATE = _database.read(database::Config::Section::analog_t::AFTERTOUCH_RATE, index);
+
+    if (!RATE)
+    {
+        aftertouch.pending = false;
+        return;
+    }
+
+    if ((core::mcu::timing::ms() - aftertouch.lastSendTime) < (1000 / RATE))
+    {
+        return;
+    }
+
+    uint8_t value = aftertouch.target;
+    auto    slew  = _database.read(database::Config::Section::analog_t::AFTERTOUCH_SLEW, index);
+
+    if (slew)
+    {
+        // move towards the latest pressure by the part of the difference, but at least by 1
+        // so that the latest pressure is always reached
+        int16_t diff = static_cast<int16_t>(aftertouch.target) - static_cast<int16_t>(aftertouch.sent);
+        int16_t step = diff / (1 << slew);
+
+        if (!step)
+        {
+            step = diff > 0 ? 1 : -1;
+        }
+
+        value = aftertouch.sent + step;
+    }
+
+    aftertouch.sent         = value;
+    aftertouch.lastSendTime = core::mcu::timing::ms();
+    aftertouch.pending      = aftertouch.sent != aftertouch.target;
+
+    Descriptor descriptor;
+    fillDescriptor(index, descriptor);
+
+    descriptor.event.message = midi::messageType_t::AFTER_TOUCH_POLY;
+    descriptor.event.value   = value;
+
+    MidiDispatcher.notify(messaging::eventType_t::ANALOG, descriptor.event);
+}
+
 void Analog::sendMessage(size_t index, Descriptor& descriptor)
 {
     auto eventType         = messaging::eventType_t::ANALOG;
@@ -438,6 +531,7 @@ void Analog::sendMessage(size_t index, Descriptor& descriptor)
 void Analog::reset(size_t index)
 {
     setFSRstate(index, false);
+    _aftertouch[index] = {};
     _filter.reset(index);
     _lastValue[index] = 0xFFFF;
 }
@@ -532,9 +626,17 @@ std::optional<uint8_t> Analog::sysConfigSet(sys::Config::Section::analog_t secti
         break;
     }
 
-    return _database.update(util::Conversion::SYS_2_DB_SECTION(section), index, value)
-               ? sys::Config::Status::ACK
-               : sys::Config::Status::ERROR_WRITE;
+    if (!_database.update(util::Conversion::SYS_2_DB_SECTION(section), index, value))
+    {
+        return sys::Config::Status::ERROR_WRITE;
+    }
+
+    if ((section == sys::Config::Section::analog_t::ENABLE) && (index < Collection::SIZE(GROUP_ANALOG_INPUTS)))
+    {
+        _hwa.setEnabled(index, value);
+    }
+
+    return sys::Config::Status::ACK;
 }
 
 #endif
\ No newline at end of file
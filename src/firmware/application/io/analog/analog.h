@@ -68,18 +68,32 @@ namespace io::analog
             protocol::midi::messageType_t::INVALID,                 // RESERVED
         };
 
-        Hwa&      _hwa;
-        Filter&   _filter;
-        Database& _database;
-        uint8_t   _fsrPressed[Collection::SIZE() / 8 + 1] = {};
-        uint16_t  _lastValue[Collection::SIZE()]          = {};
-        uint8_t   _lastBreathValue                        = 0xFF;
+        /// Aftertouch output state of single FSR input.
+        /// Only the latest pressure is kept: readings received in between two messages are dropped.
+        struct Aftertouch
+        {
+            uint32_t lastSendTime = 0;
+            uint8_t  target       = 0;
+            uint8_t  sent         = 0;
+            bool     pending      = false;
+        };
+
+        Hwa&       _hwa;
+        Filter&    _filter;
+        Database&  _database;
+        uint8_t    _fsrPressed[Collection::SIZE() / 8 + 1] = {};
+        uint16_t   _lastValue[Collection::SIZE()]          = {};
+        uint8_t    _lastBreathValue                        = 0xFF;
+        Aftertouch _aftertouch[Collection::SIZE()]         = {};
 
+        void                   publishScanList();
         void                   fillDescriptor(size_t index, Descriptor& descriptor);
         void                   processReading(size_t index, uint16_t value);
         void                   processSaxBreathController(size_t index, uint16_t value);
         bool                   checkPotentiometerValue(size_t index, Descriptor& descriptor);
         bool                   checkFSRvalue(size_t index, Descriptor& descriptor);
+        void                   setAftertouch(size_t index, uint16_t pressure);
+        void                   updateAftertouch(size_t index);
         void                   sendMessage(size_t index, Descriptor& descriptor);
         void                   setFSRstate(size_t index, bool state);
         bool                   fsrState(size_t index);
@@ -54,4 +54,12 @@ namespace io::analog
         VELOCITY,
         AFTERTOUCH
     };
+
+    /// Maximum amount of aftertouch messages per second for single FSR input.
+    /// Rate set to 0 disables aftertouch.
+    constexpr inline uint8_t MAX_AFTERTOUCH_RATE = 100;
+
+    /// Maximum aftertouch slew setting.
+    /// Each aftertouch message moves by 1/2^slew of the remaining difference: 0 disables smoothing.
+    constexpr inline uint8_t MAX_AFTERTOUCH_SLEW = 7;
 }    // namespace io::analog
\ No newline at end of file
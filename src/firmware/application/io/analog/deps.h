@@ -33,6 +33,7 @@ namespace io::analog
         virtual ~Hwa() = default;
 
         virtual bool    value(size_t index, uint16_t& value) = 0;
+        virtual void    setEnabled(size_t index, bool state) = 0;
         virtual uint8_t adcBits()                            = 0;
     };
 
@@ -46,6 +47,7 @@ namespace io::analog
             uint16_t lowerOffset = 0;
             uint16_t upperOffset = 0;
             uint16_t maxValue    = 127;
+            uint16_t pressure    = 0;    ///< Aftertouch pressure of FSR sensors, scaled to maxValue.
         };
 
         virtual ~Filter() = default;
@@ -19,6 +19,7 @@ limitations under the License.
 #pragma once
 
 #include "deps.h"
+#include "application/protocol/midi/common.h"
 
 #include "core/mcu.h"
 #include "core/util/util.h"
@@ -54,6 +55,11 @@ namespace io::analog
                 return isButtonFiltered(index, descriptor);
             }
 
+            if (descriptor.maxValue > protocol::midi::MAX_VALUE_7BIT)
+            {
+                return isHighResFiltered(index, descriptor, ADC_MIN_VALUE, ADC_MAX_VALUE);
+            }
+
             const bool FAST_FILTER    = (core::mcu::timing::ms() - _lastMovementTime[index]) < FAST_FILTER_ENABLE_AFTER_MS;
             const bool DIRECTION      = descriptor.value >= _lastValue[index];
             const auto OLD_MIDI_VALUE = core::util::MAP_RANGE(static_cast<uint32_t>(_lastValue[index]),
@@ -123,6 +129,15 @@ namespace io::analog
 
             if (descriptor.type == type_t::FSR)
             {
+                // pressure above the one needed for full velocity is used for aftertouch
+                descriptor.pressure = core::util::MAP_RANGE(core::util::CONSTRAIN(static_cast<uint32_t>(descriptor.value),
+                                                                                  static_cast<uint32_t>(_adcConfig.FSR_MAX_VALUE),
+                                                                                  static_cast<uint32_t>(_adcConfig.AFTERTOUCH_MAX_VALUE)),
+                                                            static_cast<uint32_t>(_adcConfig.FSR_MAX_VALUE),
+                                                            static_cast<uint32_t>(_adcConfig.AFTERTOUCH_MAX_VALUE),
+                                                            static_cast<uint32_t>(0),
+                                                            static_cast<uint32_t>(descriptor.maxValue));
+
                 descriptor.value = core::util::MAP_RANGE(core::util::CONSTRAIN(static_cast<uint32_t>(descriptor.value),
                                                                                static_cast<uint32_t>(_adcConfig.FSR_MIN_VALUE),
                                                                                static_cast<uint32_t>(_adcConfig.FSR_MAX_VALUE)),
@@ -185,6 +200,21 @@ namespace io::analog
         };
 
         static constexpr uint32_t FAST_FILTER_ENABLE_AFTER_MS = 50;
+
+        /// Amount of fractional bits used for readings of high resolution (14-bit) outputs.
+        static constexpr uint8_t HIGH_RES_FRACTION_BITS = 4;
+
+        /// Smoothing factor of high resolution readings: each reading contributes 1/2^shift of the difference.
+        static constexpr uint8_t HIGH_RES_EMA_SHIFT = 2;
+
+        /// Minimum movement, in fixed point ADC units, needed to emit new high resolution value.
+        /// Output steps of 14-bit values are smaller than single ADC step: this keeps the
+        /// ADC noise from being sent as movement.
+        static constexpr uint32_t HIGH_RES_NOISE_FLOOR = 1 << HIGH_RES_FRACTION_BITS;
+
+        /// Difference in fixed point ADC units after which high resolution readings aren't smoothed,
+        /// so that fast movements aren't delayed.
+        static constexpr uint32_t HIGH_RES_TRACK_THRESHOLD = 8 << HIGH_RES_FRACTION_BITS;
         static constexpr size_t   MEDIAN_SAMPLE_COUNT         = 3;
         static constexpr size_t   MEDIAN_MIDDLE_VALUE         = 1;
         static constexpr uint8_t  BUTTON_TYPE_DEBOUNCED_MASK  = 0b00000010;
@@ -207,6 +237,9 @@ namespace io::analog
         uint8_t  _lastDirection[io::analog::Collection::SIZE() / 8 + 1] = {};
         uint16_t _lastValue[io::analog::Collection::SIZE()]             = {};
 
+        /// Smoothed readings of high resolution outputs in fixed point.
+        uint16_t _highResValue[io::analog::Collection::SIZE()] = {};
+
         void setlastDirection(size_t index, bool state)
         {
             uint8_t arrayIndex  = index / 8;
@@ -247,6 +280,92 @@ namespace io::analog
             return _adcConfig.ADC_MAX_VALUE;
         }
 
+        /// Filters readings of analog inputs with 14-bit outputs.
+        /// Readings are smoothed and mapped to output range in fixed point, at full ADC resolution.
+        /// New value is reported only once the smoothed reading moves by more than single output
+        /// step or ADC noise, whichever is larger, so that the noise isn't sent as movement.
+        bool isHighResFiltered(size_t index, Descriptor& descriptor, uint16_t adcMinValue, uint16_t adcMaxValue)
+        {
+            const uint32_t MIN_VALUE = static_cast<uint32_t>(adcMinValue) << HIGH_RES_FRACTION_BITS;
+            const uint32_t RANGE     = static_cast<uint32_t>(adcMaxValue - adcMinValue) << HIGH_RES_FRACTION_BITS;
+            const uint32_t SAMPLE    = static_cast<uint32_t>(descriptor.value) << HIGH_RES_FRACTION_BITS;
+
+            if (!RANGE)
+            {
+                return false;
+            }
+
+            auto toOutput = [&](uint32_t value) -> uint32_t
+            {
+                // stored value could be out of range if offsets have changed in the meantime
+                if (value <= MIN_VALUE)
+                {
+                    return 0;
+                }
+
+                if ((value - MIN_VALUE) >= RANGE)
+                {
+                    return descriptor.maxValue;
+                }
+
+                // rounded instead of truncated so that both edges are reachable
+                return ((value - MIN_VALUE) * descriptor.maxValue + (RANGE / 2)) / RANGE;
+            };
+
+            const bool EDGE  = (descriptor.value == adcMinValue) || (descriptor.value == adcMaxValue);
+            const bool FIRST = _lastValue[index] == 0xFFFF;
+
+            if (FIRST || EDGE)
+            {
+                _highResValue[index] = SAMPLE;
+            }
+            else
+            {
+                int32_t diff = static_cast<int32_t>(SAMPLE) - static_cast<int32_t>(_highResValue[index]);
+
+                if (static_cast<uint32_t>(abs(diff)) > HIGH_RES_TRACK_THRESHOLD)
+                {
+                    _highResValue[index] = SAMPLE;
+                }
+                else
+                {
+                    _highResValue[index] += diff / (1 << HIGH_RES_EMA_SHIFT);
+                }
+            }
+
+            const uint32_t VALUE  = _highResValue[index];
+            const uint32_t OUTPUT = toOutput(VALUE);
+
+            if (!FIRST)
+            {
+                const uint32_t LAST_VALUE  = _lastValue[index];
+                const uint32_t LAST_OUTPUT = toOutput(LAST_VALUE);
+
+                if (OUTPUT == LAST_OUTPUT)
+                {
+                    return false;
+                }
+
+                // edge values are always reported so that the full range can be reached
+                if ((OUTPUT != 0) && (OUTPUT != descriptor.maxValue))
+                {
+                    const uint32_t OUTPUT_STEP = RANGE / descriptor.maxValue;
+                    const uint32_t HYSTERESIS  = OUTPUT_STEP > HIGH_RES_NOISE_FLOOR ? OUTPUT_STEP : HIGH_RES_NOISE_FLOOR;
+                    const uint32_t MOVEMENT    = VALUE > LAST_VALUE ? VALUE - LAST_VALUE : LAST_VALUE - VALUE;
+
+                    if (MOVEMENT < HYSTERESIS)
+                    {
+                        return false;
+                    }
+                }
+            }
+
+            _lastValue[index] = VALUE;
+            descriptor.value  = OUTPUT;
+
+            return true;
+        }
+
         bool isButtonFiltered(size_t index, Descriptor& descriptor)
         {
             bool newValue = false;
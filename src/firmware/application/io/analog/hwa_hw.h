@@ -33,6 +33,11 @@ namespace io::analog
             return board::io::analog::value(index, value);
         }
 
+        void setEnabled(size_t index, bool state) override
+        {
+            board::io::analog::setEnabled(index, state);
+        }
+
         uint8_t adcBits() override
         {
             // only 10 and 12-bit ADC supported
@@ -32,6 +32,10 @@ namespace io::analog
             return false;
         }
 
+        void setEnabled(size_t index, bool state) override
+        {
+        }
+
         uint8_t adcBits() override
         {
             return 0;
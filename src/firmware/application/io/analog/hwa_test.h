@@ -29,6 +29,10 @@ namespace io::analog
         public:
         HwaTest() = default;
 
+        void setEnabled(size_t index, bool state) override
+        {
+        }
+
         uint8_t adcBits() override
         {
             return 10;    // unused in tests
@@ -19,6 +19,7 @@ limitations under the License.
 #ifdef PROJECT_TARGET_SUPPORT_BUTTONS
 
 #include "buttons.h"
+#include "velocity.h"
 #include "application/system/config.h"
 #include "application/global/midi_program.h"
 #include "application/global/bpm.h"
@@ -96,19 +97,7 @@ Buttons::Buttons(Hwa&      hwa,
                               }
                           });
 
-    ConfigHandler.registerConfig(
-        sys::Config::block_t::BUTTONS,
-        // read
-        [this](uint8_t section, size_t index, uint16_t& value)
-        {
-            return sysConfigGet(static_cast<sys::Config::Section::button_t>(section), index, value);
-        },
-
-        // write
-        [this](uint8_t section, size_t index, uint16_t value)
-        {
-            return sysConfigSet(static_cast<sys::Config::Section::button_t>(section), index, value);
-        });
+    ConfigHandler.registerConfig<&Buttons::sysConfigGet, &Buttons::sysConfigSet>(sys::Config::block_t::BUTTONS, this);
 }
 
 bool Buttons::init()
@@ -135,30 +124,59 @@ void Buttons::updateSingle(size_t index, bool forceRefresh)
 
     if (!forceRefresh)
     {
-        if (!state(index, numberOfReadings, states))
-        {
-            return;
-        }
+        uint32_t interval = 0;
 
-        fillDescriptor(index, descriptor);
+        // time between the contacts of dual-contact key is captured once the key is fully pressed
+        bool struck = _hwa.contactInterval(index, interval);
+        bool filled = false;
 
-        for (uint8_t reading = 0; reading < numberOfReadings; reading++)
+        if (state(index, numberOfReadings, states))
         {
-            // when processing, newest sample has index 0
-            // start from oldest reading which is in upper bits
-            uint8_t processIndex = numberOfReadings - 1 - reading;
-            bool    state        = (states >> processIndex) & 0x01;
+            if (isSecondContact(index))
+            {
+                return;
+            }
 
-            if (!_filter.isFiltered(index, state))
+            fillDescriptor(index, descriptor);
+            filled = true;
+
+            for (uint8_t reading = 0; reading < numberOfReadings; reading++)
             {
-                continue;
+                // when processing, newest sample has index 0
+                // start from oldest reading which is in upper bits
+                uint8_t processIndex = numberOfReadings - 1 - reading;
+                bool    state        = (states >> processIndex) & 0x01;
+
+                if (!_filter.isFiltered(index, state))
+                {
+                    continue;
+                }
+
+                processButton(index, state, descriptor);
             }
+        }
 
-            processButton(index, state, descriptor);
+        // note on is sent after the readings so that readings taken before the strike can't turn it off
+        if (struck)
+        {
+            if (!filled)
+            {
+                fillDescriptor(index, descriptor);
+            }
+
+            if (descriptor.messageType == messageType_t::NOTE_DUAL_CONTACT)
+            {
+                sendDualContactNote(index, true, interval, descriptor);
+            }
         }
     }
     else
     {
+        if (isSecondContact(index))
+        {
+            return;
+        }
+
         fillDescriptor(index, descriptor);
 
         if (descriptor.type == type_t::LATCHING)
@@ -190,6 +208,13 @@ size_t Buttons::maxComponentUpdateIndex()
 /// param [in]: descriptor  Descriptor containing the entire configuration for the button.
 void Buttons::processButton(size_t index, bool reading, Descriptor& descriptor)
 {
+    // Note on of dual-contact key comes from the contact timing, not from the debounced state.
+    // Strike shorter than the debounce time is never seen as press, so note off can't wait for the change of state.
+    if ((descriptor.messageType == messageType_t::NOTE_DUAL_CONTACT) && !reading)
+    {
+        sendDualContactNote(index, false, 0, descriptor);
+    }
+
     // act on change of state only
     if (reading == state(index))
     {
@@ -212,6 +237,12 @@ void Buttons::processButton(size_t index, bool reading, Descriptor& descriptor)
     }
 #endif
 
+    if (descriptor.messageType == messageType_t::NOTE_DUAL_CONTACT)
+    {
+        // note on is sent once the time between the contacts is captured, note off is handled above
+        return;
+    }
+
     // don't process messageType_t::NONE type of message
     if (descriptor.messageType != messageType_t::NONE)
     {
@@ -918,12 +949,11 @@ void Buttons::sendMessage(size_t index, bool state, Descriptor& descriptor)
 
                 traceBuf[traceLen++] = 0xF7;
 
-                auto traceEvent       = descriptor.event;
-                traceEvent.sysEx      = traceBuf;
-                traceEvent.sysExLength = traceLen;
-                traceEvent.message    = midi::messageType_t::SYS_EX;
+                messaging::SysExView trace = {};
+                trace.data                 = traceBuf;
+                trace.length               = traceLen;
 
-                MidiDispatcher.notify(eventType, traceEvent);
+                SysExDispatcher.notify(eventType, trace);
 
                 LOG_INF("Custom SysEx trace: btn=%d len=%d varPos=%d varVal=%d",
                         static_cast<int>(index),
@@ -933,9 +963,14 @@ void Buttons::sendMessage(size_t index, bool state, Descriptor& descriptor)
             }
 #endif
 
-            descriptor.event.sysEx       = sysExBuf;
-            descriptor.event.sysExLength = length;
-            descriptor.event.message     = midi::messageType_t::SYS_EX;
+            // payload lives on the stack: send it right away, the regular event only reports the message type
+            messaging::SysExView sysEx = {};
+            sysEx.data                 = sysExBuf;
+            sysEx.length               = length;
+
+            SysExDispatcher.notify(eventType, sysEx);
+
+            descriptor.event.message = midi::messageType_t::SYS_EX;
         }
         break;
 
@@ -1062,6 +1097,55 @@ void Buttons::sendMessage(size_t index, bool state, Descriptor& descriptor)
     }
 }
 
+/// Sends note for dual-contact key.
+/// Note on is sent with the velocity calculated from the time between the contacts.
+/// Note off is sent only if the note is currently on.
+/// param [in]: index       Index of the key.
+/// param [in]: state       True for note on, false for note off.
+/// param [in]: interval    Time in microseconds between the contacts. Used only for note on.
+/// param [in]: descriptor  Descriptor containing the entire configuration for the button.
+void Buttons::sendDualContactNote(size_t index, bool state, uint32_t interval, Descriptor& descriptor)
+{
+    uint8_t arrayIndex = index / 8;
+    uint8_t bit        = index - 8 * arrayIndex;
+
+    if (core::util::BIT_READ(_dualContactNote[arrayIndex], bit))
+    {
+        // also covers the key being struck again before it has been released
+        messaging::Event offEvent = descriptor.event;
+        offEvent.value            = 0;
+        offEvent.message          = midi::messageType_t::NOTE_OFF;
+
+        MidiDispatcher.notify(messaging::eventType_t::BUTTON, offEvent);
+    }
+
+    if (state)
+    {
+        descriptor.event.value   = Velocity::value(interval, static_cast<velocityCurve_t>(descriptor.event.value));
+        descriptor.event.message = midi::messageType_t::NOTE_ON;
+
+        MidiDispatcher.notify(messaging::eventType_t::BUTTON, descriptor.event);
+    }
+
+    core::util::BIT_WRITE(_dualContactNote[arrayIndex], bit, state);
+}
+
+/// Checks whether the button is the second contact of dual-contact key.
+/// Second contact only times the strike and doesn't send anything on its own.
+/// param [in]: index    Button index to check.
+/// returns: True if the button is the second contact of dual-contact key.
+bool Buttons::isSecondContact(size_t index)
+{
+    auto first = _hwa.firstContact(index);
+
+    if (first == index)
+    {
+        return false;
+    }
+
+    return _database.read(database::Config::Section::button_t::MESSAGE_TYPE, first) == static_cast<uint32_t>(messageType_t::NOTE_DUAL_CONTACT);
+}
+
 /// Updates current state of button.
 /// param [in]: index       Button for which state is being changed.
 /// param [in]: state       New button state (true/pressed, false/released).
@@ -1118,6 +1202,11 @@ void Buttons::reset(size_t index)
 {
     setState(index, false);
     setLatchingState(index, false);
+
+    uint8_t arrayIndex = index / 8;
+    uint8_t bit        = index - 8 * arrayIndex;
+
+    core::util::BIT_WRITE(_dualContactNote[arrayIndex], bit, false);
 }
 
 void Buttons::fillDescriptor(size_t index, Descriptor& descriptor)
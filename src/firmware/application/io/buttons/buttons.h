@@ -94,6 +94,7 @@ namespace io::buttons
             protocol::midi::messageType_t::MMC_PLAY,                        // MMC_PLAY_STOP - modified to stop when needed
             protocol::midi::messageType_t::INVALID,                         // NOTE_LEGATO
             protocol::midi::messageType_t::SYS_EX,                          // CUSTOM_SYS_EX
+            protocol::midi::messageType_t::NOTE_ON,                         // NOTE_DUAL_CONTACT
         };
 
         Hwa&      _hwa;
@@ -102,6 +103,7 @@ namespace io::buttons
         uint8_t   _buttonPressed[Collection::SIZE() / 8 + 1]     = {};
         uint8_t   _lastLatchingState[Collection::SIZE() / 8 + 1] = {};
         uint8_t   _incDecValue[Collection::SIZE()]               = {};
+        uint8_t   _dualContactNote[Collection::SIZE() / 8 + 1]   = {};
 
         uint8_t _legatoActiveNote[16]  = {};
         uint8_t _legatoButtonCount[16] = {};
@@ -119,6 +121,8 @@ namespace io::buttons
         void                   fillDescriptor(size_t index, Descriptor& descriptor);
         void                   processButton(size_t index, bool reading, Descriptor& descriptor);
         void                   sendMessage(size_t index, bool state, Descriptor& descriptor);
+        void                   sendDualContactNote(size_t index, bool state, uint32_t interval, Descriptor& descriptor);
+        bool                   isSecondContact(size_t index);
         void                   setState(size_t index, bool state);
         void                   setLatchingState(size_t index, bool state);
         bool                   latchingState(size_t index);
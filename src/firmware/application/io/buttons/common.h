@@ -87,6 +87,17 @@ namespace io::buttons
         MMC_PLAY_STOP,                     ///< MMC Play/Stop toggle
         NOTE_LEGATO,                       ///< Legato note (no Note Off)
         CUSTOM_SYS_EX,                     ///< Custom SysEx (user-defined) message
+        NOTE_DUAL_CONTACT,                 ///< Note with velocity from the time between two contacts of the key
+                                           ///< VALUE selects the velocity curve (see velocityCurve_t)
         AMOUNT                             ///< Total number of message types
     };
+
+    /// Curves used to convert the speed of dual-contact key into note velocity.
+    enum class velocityCurve_t : uint8_t
+    {
+        LINEAR,    ///< Velocity proportional to key speed
+        SOFT,      ///< Higher velocities reached with less force
+        HARD,      ///< More force needed for higher velocities
+        AMOUNT     ///< Total number of velocity curves
+    };
 }    // namespace io::buttons
\ No newline at end of file
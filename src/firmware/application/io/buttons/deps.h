@@ -37,6 +37,13 @@ namespace io::buttons
         // should return true if the value has been refreshed, false otherwise
         virtual bool   state(size_t index, uint8_t& numberOfReadings, uint16_t& states) = 0;
         virtual size_t buttonToEncoderIndex(size_t index)                               = 0;
+
+        // should return true if the time between the contacts of dual-contact key has been captured
+        virtual bool contactInterval(size_t index, uint32_t& interval) = 0;
+
+        // should return the index of the first contact of the key to which the input belongs
+        // contacts are paired the same way as encoder inputs
+        virtual size_t firstContact(size_t index) = 0;
     };
 
     class Filter
@@ -48,6 +48,17 @@ namespace io::buttons
             return board::io::digital_in::encoderFromInput(index);
         }
 
+        bool contactInterval(size_t index, uint32_t& interval) override
+        {
+            return board::io::digital_in::contactInterval(index, interval);
+        }
+
+        size_t firstContact(size_t index) override
+        {
+            return board::io::digital_in::encoderComponentFromEncoder(board::io::digital_in::encoderFromInput(index),
+                                                                      board::io::digital_in::encoderComponent_t::A);
+        }
+
         private:
         board::io::digital_in::Readings _dInRead;
     };
@@ -36,5 +36,15 @@ namespace io::buttons
         {
             return 0;
         }
+
+        bool contactInterval(size_t index, uint32_t& interval) override
+        {
+            return false;
+        }
+
+        size_t firstContact(size_t index) override
+        {
+            return index;
+        }
     };
 }    // namespace io::buttons
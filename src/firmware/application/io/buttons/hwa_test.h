@@ -21,6 +21,7 @@ limitations under the License.
 #include "deps.h"
 
 #include <gmock/gmock.h>
+#include <map>
 
 namespace io::buttons
 {
@@ -35,5 +36,27 @@ namespace io::buttons
         {
             return index / 2;
         }
+
+        bool contactInterval(size_t index, uint32_t& interval) override
+        {
+            auto it = _contactInterval.find(index);
+
+            if (it == _contactInterval.end())
+            {
+                return false;
+            }
+
+            interval = it->second;
+            _contactInterval.erase(it);
+
+            return true;
+        }
+
+        size_t firstContact(size_t index) override
+        {
+            return buttonToEncoderIndex(index) * 2;
+        }
+
+        std::map<size_t, uint32_t> _contactInterval;
     };
 }    // namespace io::buttons
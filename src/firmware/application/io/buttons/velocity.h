@@ -0,0 +1,127 @@
+/*
+
+Copyright Igor Petrovic
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#pragma once
+
+#include "common.h"
+
+#include <inttypes.h>
+#include <stddef.h>
+#include <array>
+
+namespace io::buttons
+{
+    /// Approximates base 2 logarithm in fixed point.
+    /// Integer part is the position of the highest set bit, while the fraction is interpolated
+    /// linearly between two powers of two.
+    /// param [in]: value           Value for which the logarithm is calculated.
+    /// param [in]: fractionBits    Amount of fractional bits in the result.
+    /// returns: Approximation of log2(value) * 2^fractionBits.
+    constexpr uint32_t fixedLog2(uint32_t value, uint32_t fractionBits)
+    {
+        uint32_t exponent = 0;
+
+        while (value >> (exponent + 1))
+        {
+            exponent++;
+        }
+
+        uint32_t fraction = exponent >= fractionBits
+                                ? value >> (exponent - fractionBits)
+                                : value << (fractionBits - exponent);
+
+        return (exponent << fractionBits) | (fraction & ((1 << fractionBits) - 1));
+    }
+
+    /// Converts the time between closing of two contacts of dual-contact key into note velocity.
+    /// Key speed is measured on logarithmic scale of the time between the contacts so that the
+    /// whole range of playing, from the fastest to the slowest strikes, is spread evenly. The speed
+    /// is normalized to 0-127 range and mapped through the selected curve.
+    class Velocity
+    {
+        public:
+        Velocity() = delete;
+
+        /// Time in microseconds between the contacts at and below which the highest velocity is sent.
+        static constexpr uint32_t FASTEST_INTERVAL_US = 2000;
+
+        /// Time in microseconds between the contacts at and above which the lowest velocity is sent.
+        static constexpr uint32_t SLOWEST_INTERVAL_US = 80000;
+
+        /// Calculates note velocity.
+        /// param [in]: interval    Time in microseconds between closing of the two contacts.
+        /// param [in]: curve       Velocity curve. Linear curve is used for invalid values.
+        /// returns: Note velocity (1-127).
+        static uint8_t value(uint32_t interval, velocityCurve_t curve)
+        {
+            if (curve >= velocityCurve_t::AMOUNT)
+            {
+                curve = velocityCurve_t::LINEAR;
+            }
+
+            return CURVE[static_cast<uint8_t>(curve)][speed(interval)];
+        }
+
+        /// Calculates normalized key speed.
+        /// param [in]: interval    Time in microseconds between closing of the two contacts.
+        /// returns: Key speed where 0 corresponds to SLOWEST_INTERVAL_US and 127 to FASTEST_INTERVAL_US.
+        static uint8_t speed(uint32_t interval)
+        {
+            if (interval <= FASTEST_INTERVAL_US)
+            {
+                return MAX_SPEED;
+            }
+
+            if (interval >= SLOWEST_INTERVAL_US)
+            {
+                return 0;
+            }
+
+            return (MAX_SPEED * (LOG_SLOWEST - fixedLog2(interval, LOG2_FRACTION_BITS)) + (LOG_RANGE / 2)) / LOG_RANGE;
+        }
+
+        private:
+        static constexpr uint32_t MAX_SPEED          = 127;
+        static constexpr uint32_t MAX_VELOCITY       = 127;
+        static constexpr uint32_t LOG2_FRACTION_BITS = 8;
+        static constexpr uint32_t LOG_SLOWEST        = fixedLog2(SLOWEST_INTERVAL_US, LOG2_FRACTION_BITS);
+        static constexpr uint32_t LOG_RANGE          = LOG_SLOWEST - fixedLog2(FASTEST_INTERVAL_US, LOG2_FRACTION_BITS);
+
+        using curve_t = std::array<std::array<uint8_t, MAX_SPEED + 1>, static_cast<uint8_t>(velocityCurve_t::AMOUNT)>;
+
+        /// Velocity for each speed and curve, generated at compile time.
+        static constexpr curve_t CURVE = []()
+        {
+            curve_t curve = {};
+
+            constexpr uint32_t SCALE = MAX_SPEED * MAX_SPEED;
+
+            for (uint32_t speed = 0; speed <= MAX_SPEED; speed++)
+            {
+                const uint32_t INVERSE = MAX_SPEED - speed;
+
+                // velocity 0 would be note off: start from 1
+                curve[static_cast<uint8_t>(velocityCurve_t::LINEAR)][speed] = 1 + ((MAX_VELOCITY - 1) * speed + (MAX_SPEED / 2)) / MAX_SPEED;
+                curve[static_cast<uint8_t>(velocityCurve_t::SOFT)][speed]   = 1 + ((MAX_VELOCITY - 1) * (SCALE - INVERSE * INVERSE) + (SCALE / 2)) / SCALE;
+                curve[static_cast<uint8_t>(velocityCurve_t::HARD)][speed]   = 1 + ((MAX_VELOCITY - 1) * speed * speed + (SCALE / 2)) / SCALE;
+            }
+
+            return curve;
+        }();
+    };
+}    // namespace io::buttons
@@ -53,27 +53,31 @@ Encoders::Encoders(Hwa&      hwa,
                               {
                               case midi::messageType_t::CONTROL_CHANGE:
                               {
+                                  syncSettings();
+
                                   for (size_t i = 0; i < Collection::SIZE(); i++)
                                   {
-                                      if (!_database.read(database::Config::Section::encoder_t::REMOTE_SYNC, i))
+                                      const auto& SETTINGS = _settings[i];
+
+                                      if (!SETTINGS.remoteSync)
                                       {
                                           continue;
                                       }
 
-                                      if (_database.read(database::Config::Section::encoder_t::MODE, i) != static_cast<int32_t>(type_t::CONTROL_CHANGE))
+                                      if (SETTINGS.mode != type_t::CONTROL_CHANGE)
                                       {
                                           continue;
                                       }
 
                                       if (!USE_OMNI)
                                       {
-                                          if (_database.read(database::Config::Section::encoder_t::CHANNEL, i) != CHANNEL)
+                                          if (SETTINGS.channel != CHANNEL)
                                           {
                                               continue;
                                           }
                                       }
 
-                                      if (_database.read(database::Config::Section::encoder_t::MIDI_ID_1, i) != event.index)
+                                      if (SETTINGS.midiId1 != event.index)
                                       {
                                           continue;
                                       }
@@ -88,19 +92,25 @@ Encoders::Encoders(Hwa&      hwa,
                               }
                           });
 
-    ConfigHandler.registerConfig(
-        sys::Config::block_t::ENCODERS,
-        // read
-        [this](uint8_t section, size_t index, uint16_t& value)
-        {
-            return sysConfigGet(static_cast<sys::Config::Section::encoder_t>(section), index, value);
-        },
+    MidiDispatcher.listen(messaging::eventType_t::SYSTEM,
+                          [this](const messaging::Event& event)
+                          {
+                              switch (event.systemMessage)
+                              {
+                              case messaging::systemMessage_t::PRESET_CHANGED:
+                              case messaging::systemMessage_t::RESTORE_END:
+                              case messaging::systemMessage_t::FACTORY_RESET_END:
+                              {
+                                  loadSettings();
+                              }
+                              break;
 
-        // write
-        [this](uint8_t section, size_t index, uint16_t value)
-        {
-            return sysConfigSet(static_cast<sys::Config::Section::encoder_t>(section), index, value);
-        });
+                              default:
+                                  break;
+                              }
+                          });
+
+    ConfigHandler.registerConfig<&Encoders::sysConfigGet, &Encoders::sysConfigSet>(sys::Config::block_t::ENCODERS, this);
 }
 
 bool Encoders::init()
@@ -110,6 +120,8 @@ bool Encoders::init()
         reset(i);
     }
 
+    _settingsPreset = _database.getPreset();
+
     return true;
 }
 
@@ -120,7 +132,9 @@ void Encoders::updateSingle(size_t index, bool forceRefresh)
         return;
     }
 
-    if (!_database.read(database::Config::Section::encoder_t::ENABLE, index))
+    syncSettings();
+
+    if (!_settings[index].enabled)
     {
         return;
     }
@@ -173,7 +187,7 @@ void Encoders::processReading(size_t index, uint8_t pairValue, uint32_t sampleTi
     {
         if (position != position_t::STOPPED)
         {
-            if (_database.read(database::Config::Section::encoder_t::INVERT, index))
+            if (_settings[index].inverted)
             {
                 if (position == position_t::CCW)
                 {
@@ -185,23 +199,7 @@ void Encoders::processReading(size_t index, uint8_t pairValue, uint32_t sampleTi
                 }
             }
 
-            uint8_t encAcceleration = _database.read(database::Config::Section::encoder_t::ACCELERATION, index);
-
-            if (encAcceleration)
-            {
-                // when time difference between two movements is smaller than ENCODERS_SPEED_TIMEOUT,
-                // start accelerating
-                if ((sampleTime - _filter.lastMovementTime(index)) < ENCODERS_SPEED_TIMEOUT)
-                {
-                    _encoderSpeed[index] = core::util::CONSTRAIN(static_cast<uint8_t>(_encoderSpeed[index] + ENCODER_SPEED_CHANGE[encAcceleration]),
-                                                                 static_cast<uint8_t>(0),
-                                                                 ENCODER_ACC_STEP_INC[encAcceleration]);
-                }
-                else
-                {
-                    _encoderSpeed[index] = 0;
-                }
-            }
+            _encoderSpeed[index] = accelerate(index, sampleTime);
 
             Descriptor descriptor;
             fillDescriptor(index, position, descriptor);
@@ -213,9 +211,9 @@ void Encoders::processReading(size_t index, uint8_t pairValue, uint32_t sampleTi
 
 void Encoders::sendMessage(size_t index, position_t position, Descriptor& descriptor)
 {
-    auto    eventType = messaging::eventType_t::ENCODER;
-    bool    send      = true;
-    uint8_t steps     = (_encoderSpeed[index] > 0) ? _encoderSpeed[index] : 1;
+    auto     eventType = messaging::eventType_t::ENCODER;
+    bool     send      = true;
+    uint16_t steps     = (_encoderSpeed[index] > 0) ? _encoderSpeed[index] : 1;
 
     switch (descriptor.type)
     {
@@ -275,10 +273,11 @@ void Encoders::sendMessage(size_t index, position_t position, Descriptor& descri
 
         if (position == position_t::CCW)
         {
-            // ValueIncDecMIDI7Bit is used, but any type can be used when decrementing since the limit is 0 for all of them
-            _value[index] = ValueIncDecMIDI7Bit::decrement(_value[index],
-                                                           steps,
-                                                           ValueIncDecMIDI7Bit::type_t::EDGE);
+            // ValueIncDecMIDI14Bit is used, but any type which holds the value can be used when decrementing
+            // since the limit is 0 for all of them
+            _value[index] = ValueIncDecMIDI14Bit::decrement(_value[index],
+                                                            steps,
+                                                            ValueIncDecMIDI14Bit::type_t::EDGE);
         }
         else
         {
@@ -289,7 +288,7 @@ void Encoders::sendMessage(size_t index, position_t position, Descriptor& descri
             case type_t::SINGLE_NOTE_VARIABLE_VAL:
             {
                 _value[index] = ValueIncDecMIDI7Bit::increment(_value[index],
-                                                               steps,
+                                                               static_cast<uint8_t>(steps),
                                                                ValueIncDecMIDI7Bit::type_t::EDGE);
             }
             break;
@@ -310,8 +309,8 @@ void Encoders::sendMessage(size_t index, position_t position, Descriptor& descri
         }
 
         _value[index] = core::util::CONSTRAIN(static_cast<uint16_t>(_value[index]),
-                                              static_cast<uint16_t>(_database.read(database::Config::Section::encoder_t::LOWER_LIMIT, index)),
-                                              static_cast<uint16_t>(_database.read(database::Config::Section::encoder_t::UPPER_LIMIT, index)));
+                                              _settings[index].lowerLimit,
+                                              _settings[index].upperLimit);
 
         if (descriptor.type == type_t::CONTROL_CHANGE_14BIT)
         {
@@ -330,7 +329,7 @@ void Encoders::sendMessage(size_t index, position_t position, Descriptor& descri
     case type_t::SINGLE_NOTE_FIXED_VAL_ONE_DIR_0_OTHER_DIR:
     case type_t::TWO_NOTE_FIXED_VAL_BOTH_DIR:
     {
-        descriptor.event.value = _database.read(database::Config::Section::encoder_t::REPEATED_VALUE, index);
+        descriptor.event.value = _settings[index].repeatedValue;
 
         if (descriptor.type == type_t::SINGLE_NOTE_FIXED_VAL_ONE_DIR_0_OTHER_DIR)
         {
@@ -388,7 +387,9 @@ void Encoders::sendMessage(size_t index, position_t position, Descriptor& descri
 /// Sets the MIDI value of specified encoder to default.
 void Encoders::reset(size_t index)
 {
-    if (_database.read(database::Config::Section::encoder_t::MODE, index) == static_cast<int32_t>(type_t::PITCH_BEND))
+    loadSettings(index);
+
+    if (_settings[index].mode == type_t::PITCH_BEND)
     {
         _value[index] = 8192;
     }
@@ -401,6 +402,90 @@ void Encoders::reset(size_t index)
     _encoderSpeed[index]  = 0;
     _encoderData[index]   = 0;
     _encoderPulses[index] = 0;
+    _lastStepTime[index]  = 0;
+    _stepInterval[index]  = 0;
+}
+
+/// Reads all settings of specified encoder from database into RAM.
+void Encoders::loadSettings(size_t index)
+{
+    auto& settings = _settings[index];
+
+    settings.enabled       = _database.read(database::Config::Section::encoder_t::ENABLE, index);
+    settings.inverted      = _database.read(database::Config::Section::encoder_t::INVERT, index);
+    settings.mode          = static_cast<type_t>(_database.read(database::Config::Section::encoder_t::MODE, index));
+    settings.midiId1       = _database.read(database::Config::Section::encoder_t::MIDI_ID_1, index);
+    settings.midiId2       = _database.read(database::Config::Section::encoder_t::MIDI_ID_2, index);
+    settings.channel       = _database.read(database::Config::Section::encoder_t::CHANNEL, index);
+    settings.pulsesPerStep = _database.read(database::Config::Section::encoder_t::PULSES_PER_STEP, index);
+    settings.remoteSync    = _database.read(database::Config::Section::encoder_t::REMOTE_SYNC, index);
+    settings.lowerLimit    = _database.read(database::Config::Section::encoder_t::LOWER_LIMIT, index);
+    settings.upperLimit    = _database.read(database::Config::Section::encoder_t::UPPER_LIMIT, index);
+    settings.repeatedValue = _database.read(database::Config::Section::encoder_t::REPEATED_VALUE, index);
+
+    uint8_t acceleration = _database.read(database::Config::Section::encoder_t::ACCELERATION, index);
+
+    settings.acceleration = (acceleration < static_cast<uint8_t>(acceleration_t::AMOUNT)) ? acceleration : 0;
+}
+
+/// Reads settings of all encoders from the active preset into RAM.
+void Encoders::loadSettings()
+{
+    for (size_t i = 0; i < Collection::SIZE(); i++)
+    {
+        loadSettings(i);
+    }
+
+    _settingsPreset = _database.getPreset();
+}
+
+/// Reloads the cached settings if the active preset has changed since they were read.
+/// PRESET_CHANGED is sent with a delay and isn't sent at all during backup and restore,
+/// so the preset is checked before the cached settings are used.
+void Encoders::syncSettings()
+{
+    if (_database.getPreset() != _settingsPreset)
+    {
+        loadSettings();
+    }
+}
+
+/// Estimates the velocity of specified encoder from the time of current step and
+/// maps it through acceleration curve.
+/// param [in]: index       Index of the encoder which has moved.
+/// param [in]: sampleTime  Time at which the reading containing the step was taken.
+/// returns: Amount of steps by which the value should be changed.
+uint8_t Encoders::accelerate(size_t index, uint32_t sampleTime)
+{
+    const uint32_t INTERVAL = sampleTime - _lastStepTime[index];
+    _lastStepTime[index]    = sampleTime;
+
+    if (!_stepInterval[index] || (INTERVAL >= ENCODERS_SPEED_TIMEOUT))
+    {
+        // first step after the encoder has been stopped
+        _stepInterval[index] = ENCODERS_SPEED_TIMEOUT << STEP_INTERVAL_FRACTION_BITS;
+        return 1;
+    }
+
+    // readouts are timestamped individually so the interval doesn't depend on how often encoders are updated
+    _stepInterval[index] = ((static_cast<uint32_t>(_stepInterval[index]) * ((1 << STEP_INTERVAL_EMA_SHIFT) - 1)) +
+                            (INTERVAL << STEP_INTERVAL_FRACTION_BITS)) >>
+                           STEP_INTERVAL_EMA_SHIFT;
+
+    if (!_stepInterval[index])
+    {
+        _stepInterval[index] = 1;
+    }
+
+    const uint32_t VELOCITY = (1000UL << STEP_INTERVAL_FRACTION_BITS) / _stepInterval[index];
+    size_t         point    = VELOCITY / ACCELERATION_CURVE_VELOCITY_STEP;
+
+    if (point >= ACCELERATION_CURVE_SIZE)
+    {
+        point = ACCELERATION_CURVE_SIZE - 1;
+    }
+
+    return ACCELERATION_CURVE[_settings[index].acceleration][point];
 }
 
 void Encoders::setValue(size_t index, uint16_t value)
@@ -438,7 +523,7 @@ position_t Encoders::read(size_t index, uint8_t pairState)
 
     _encoderPulses[index] += ENCODER_LOOK_UP_TABLE[_encoderData[index] & 0x0F];
 
-    if (abs(_encoderPulses[index]) >= static_cast<int32_t>(_database.read(database::Config::Section::encoder_t::PULSES_PER_STEP, index)))
+    if (abs(_encoderPulses[index]) >= static_cast<int32_t>(_settings[index].pulsesPerStep))
     {
         retVal = (_encoderPulses[index] > 0) ? position_t::CCW : position_t::CW;
         // reset count
@@ -450,7 +535,7 @@ position_t Encoders::read(size_t index, uint8_t pairState)
 
 void Encoders::fillDescriptor(size_t index, position_t position, Descriptor& descriptor)
 {
-    descriptor.type = static_cast<type_t>(_database.read(database::Config::Section::encoder_t::MODE, index));
+    descriptor.type = _settings[index].mode;
 
     switch (descriptor.type)
     {
@@ -458,24 +543,24 @@ void Encoders::fillDescriptor(size_t index, position_t position, Descriptor& des
     {
         if (position == position_t::CCW)
         {
-            descriptor.event.index = _database.read(database::Config::Section::encoder_t::MIDI_ID_2, index);
+            descriptor.event.index = _settings[index].midiId2;
         }
         else
         {
-            descriptor.event.index = _database.read(database::Config::Section::encoder_t::MIDI_ID_1, index);
+            descriptor.event.index = _settings[index].midiId1;
         }
     }
     break;
 
     default:
     {
-        descriptor.event.index = _database.read(database::Config::Section::encoder_t::MIDI_ID_1, index);
+        descriptor.event.index = _settings[index].midiId1;
     }
     break;
     }
 
     descriptor.event.componentIndex = index;
-    descriptor.event.channel        = _database.read(database::Config::Section::encoder_t::CHANNEL, index);
+    descriptor.event.channel        = _settings[index].channel;
     descriptor.event.message        = INTERNAL_MSG_TO_MIDI_TYPE[static_cast<uint8_t>(descriptor.type)];
 }
 
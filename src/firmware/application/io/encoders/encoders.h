@@ -54,9 +54,44 @@ namespace io::encoders
         using ValueIncDecMIDI7Bit  = util::IncDec<uint8_t, 0, protocol::midi::MAX_VALUE_7BIT>;
         using ValueIncDecMIDI14Bit = util::IncDec<uint16_t, 0, protocol::midi::MAX_VALUE_14BIT>;
 
+        /// Encoder settings cached in RAM so that processing the readings requires no database reads.
+        /// Reloaded once the encoder is reset, once the active preset changes, after restore and after factory reset.
+        struct Settings
+        {
+            uint16_t midiId1;
+            uint16_t midiId2;
+            uint16_t lowerLimit;
+            uint16_t upperLimit;
+            uint16_t repeatedValue;
+            uint8_t  channel;
+            type_t   mode;
+            bool     enabled;
+            uint8_t  pulsesPerStep : 4;
+            uint8_t  acceleration : 2;
+            uint8_t  inverted : 1;
+            uint8_t  remoteSync : 1;
+        };
+
         /// Time threshold in milliseconds between two encoder steps used to detect fast movement.
         static constexpr uint32_t ENCODERS_SPEED_TIMEOUT = 140;
 
+        /// Step intervals are kept in fixed point with this many fractional bits.
+        static constexpr uint8_t STEP_INTERVAL_FRACTION_BITS = 4;
+
+        /// Step interval estimate is an exponential moving average: new interval is weighted
+        /// by 1 / 2^STEP_INTERVAL_EMA_SHIFT.
+        static constexpr uint8_t STEP_INTERVAL_EMA_SHIFT = 1;
+
+        /// Amount of points in acceleration curve and the velocity (steps per second) between two points.
+        static constexpr size_t   ACCELERATION_CURVE_SIZE          = 32;
+        static constexpr uint32_t ACCELERATION_CURVE_VELOCITY_STEP = 4;
+
+        /// Slowest velocity in steps per second at which the acceleration starts.
+        static constexpr uint32_t ACCELERATION_MIN_VELOCITY = 1000 / ENCODERS_SPEED_TIMEOUT;
+
+        /// Velocity in steps per second at which the maximum amount of steps is reached.
+        static constexpr uint32_t ACCELERATION_MAX_VELOCITY = (ACCELERATION_CURVE_SIZE - 1) * ACCELERATION_CURVE_VELOCITY_STEP;
+
         /// Lookup table used to convert encoder reading to pulses.
         static constexpr int8_t ENCODER_LOOK_UP_TABLE[16] = {
             0,     // 0000
@@ -77,18 +112,9 @@ namespace io::encoders
             0      // 1111
         };
 
-        /// Used to achieve linear encoder acceleration on fast movement.
-        /// Every time fast movement is detected, amount of steps is increased by this value.
+        /// Largest amount of steps by which the value is changed during acceleration.
         /// Used only in CC/Pitch bend/NRPN modes. In Pitch bend/NRPN modes, this value is multiplied
         /// by 4 due to a larger value range.
-        static constexpr uint8_t ENCODER_SPEED_CHANGE[static_cast<uint8_t>(acceleration_t::AMOUNT)] = {
-            0,    // acceleration disabled
-            1,
-            2,
-            3
-        };
-
-        /// Value by which value is increased during acceleration.
         static constexpr uint8_t ENCODER_ACC_STEP_INC[static_cast<uint8_t>(acceleration_t::AMOUNT)] = {
             0,    // acceleration disabled
             5,
@@ -132,6 +158,43 @@ namespace io::encoders
             protocol::midi::messageType_t::NOTE_ON,                 // TWO_NOTE_FIXED_VAL_BOTH_DIR
         };
 
+        using accelerationCurve_t = std::array<std::array<uint8_t, ACCELERATION_CURVE_SIZE>, static_cast<uint8_t>(acceleration_t::AMOUNT)>;
+
+        /// Amount of steps for each velocity point and acceleration setting, generated at compile time.
+        /// The curve is quadratic: slow movements stay precise, while the amount of steps
+        /// ramps up quickly towards ENCODER_ACC_STEP_INC as the encoder spins faster.
+        static constexpr accelerationCurve_t ACCELERATION_CURVE = []()
+        {
+            accelerationCurve_t curve = {};
+
+            constexpr uint32_t SPAN = ACCELERATION_MAX_VELOCITY - ACCELERATION_MIN_VELOCITY;
+
+            for (size_t acceleration = 0; acceleration < curve.size(); acceleration++)
+            {
+                const uint32_t MAX_STEPS = ENCODER_ACC_STEP_INC[acceleration] ? ENCODER_ACC_STEP_INC[acceleration] : 1;
+
+                for (size_t point = 0; point < ACCELERATION_CURVE_SIZE; point++)
+                {
+                    const uint32_t VELOCITY = point * ACCELERATION_CURVE_VELOCITY_STEP;
+                    uint32_t       speed    = 0;
+
+                    if (VELOCITY > ACCELERATION_MIN_VELOCITY)
+                    {
+                        speed = VELOCITY - ACCELERATION_MIN_VELOCITY;
+                    }
+
+                    if (speed > SPAN)
+                    {
+                        speed = SPAN;
+                    }
+
+                    curve[acceleration][point] = 1 + (((MAX_STEPS - 1) * speed * speed) + (SPAN * SPAN / 2)) / (SPAN * SPAN);
+                }
+            }
+
+            return curve;
+        }();
+
         Hwa&      _hwa;
         Filter&   _filter;
         Database& _database;
@@ -147,12 +210,29 @@ namespace io::encoders
         /// Array holding current speed (in steps) for all encoders.
         uint8_t _encoderSpeed[ARRAY_SIZE] = {};
 
+        /// Array holding the time of last step for all encoders.
+        uint32_t _lastStepTime[ARRAY_SIZE] = {};
+
+        /// Array holding estimated time between two steps (fixed point) for all encoders.
+        /// Zero if there's no estimate yet.
+        uint16_t _stepInterval[ARRAY_SIZE] = {};
+
+        /// Array holding cached settings for all encoders.
+        Settings _settings[ARRAY_SIZE] = {};
+
+        /// Preset from which the settings have been cached.
+        uint8_t _settingsPreset = 0;
+
         /// Array holding last two readings from encoder pins.
         uint8_t _encoderData[ARRAY_SIZE] = {};
 
         /// Array holding current amount of pulses for all encoders.
         int8_t _encoderPulses[ARRAY_SIZE] = {};
 
+        void                   loadSettings(size_t index);
+        void                   loadSettings();
+        void                   syncSettings();
+        uint8_t                accelerate(size_t index, uint32_t sampleTime);
         void                   fillDescriptor(size_t index, position_t position, Descriptor& descriptor);
         position_t             read(size_t index, uint8_t pairState);
         void                   processReading(size_t index, uint8_t pairValue, uint32_t sampleTime);
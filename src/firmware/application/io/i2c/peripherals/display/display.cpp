@@ -36,19 +36,32 @@ Display::Display(Hwa&      hwa,
     : _hwa(hwa)
     , _database(database)
 {
-    ConfigHandler.registerConfig(
-        sys::Config::block_t::I2C,
-        // read
-        [this](uint8_t section, size_t index, uint16_t& value)
-        {
-            return sysConfigGet(static_cast<sys::Config::Section::i2c_t>(section), index, value);
-        },
-
-        // write
-        [this](uint8_t section, size_t index, uint16_t value)
-        {
-            return sysConfigSet(static_cast<sys::Config::Section::i2c_t>(section), index, value);
-        });
+    MidiDispatcher.listen(messaging::eventType_t::SYSTEM,
+                          [this](const messaging::Event& event)
+                          {
+                              switch (event.systemMessage)
+                              {
+                              case messaging::systemMessage_t::CONFIG_TRANSACTION_START:
+                              {
+                                  _configTransaction = true;
+                                  _pendingInitAction = common::initAction_t::AS_IS;
+                              }
+                              break;
+
+                              case messaging::systemMessage_t::CONFIG_TRANSACTION_END:
+                              {
+                                  _configTransaction = false;
+                                  applyInitAction(_pendingInitAction);
+                                  _pendingInitAction = common::initAction_t::AS_IS;
+                              }
+                              break;
+
+                              default:
+                                  break;
+                              }
+                          });
+
+    ConfigHandler.registerConfig<&Display::sysConfigGet, &Display::sysConfigSet>(sys::Config::block_t::I2C, this);
 
     I2c::registerPeripheral(this);
 }
@@ -374,17 +387,30 @@ std::optional<uint8_t> Display::sysConfigSet(sys::Config::Section::i2c_t section
 
     if (result == sys::Config::Status::ACK)
     {
-        if (initAction == common::initAction_t::INIT)
+        if (!_configTransaction)
         {
-            init();
+            applyInitAction(initAction);
         }
-        else if (initAction == common::initAction_t::DE_INIT)
+        else if (initAction != common::initAction_t::AS_IS)
         {
-            deInit();
+            // reinit once on commit with the most recent request
+            _pendingInitAction = initAction;
         }
     }
 
     return result;
 }
 
+void Display::applyInitAction(common::initAction_t initAction)
+{
+    if (initAction == common::initAction_t::INIT)
+    {
+        init();
+    }
+    else if (initAction == common::initAction_t::DE_INIT)
+    {
+        deInit();
+    }
+}
+
 #endif
\ No newline at end of file
@@ -88,13 +88,30 @@ namespace io::i2c::display
 
             static constexpr uint16_t REFRESH_TIME = 30;
 
+            /// Raw MIDI event data stored by elements until the next display refresh.
+            struct MIDIValue
+            {
+                protocol::midi::messageType_t message = protocol::midi::messageType_t::INVALID;
+                uint8_t                       channel = 0;
+                uint16_t                      index   = 0;
+                uint16_t                      value   = 0;
+
+                void set(const messaging::Event& event)
+                {
+                    message = event.message;
+                    channel = event.channel;
+                    index   = event.index;
+                    value   = event.value;
+                }
+            };
+
             class MIDIUpdater
             {
                 public:
                 MIDIUpdater() = default;
 
                 void useAlternateNote(bool state);
-                void updateMIDIValue(DisplayTextControl& element, const messaging::Event& event);
+                bool formatMIDIValue(TextFormatter& formatter, const MIDIValue& value);
 
                 private:
                 bool _useAlternateNote = false;
@@ -110,10 +127,20 @@ namespace io::i2c::display
                                           {
                                               if (event.message != protocol::midi::messageType_t::SYS_EX)
                                               {
-                                                  setText("%s", Strings::MIDI_MESSAGE(event.message));
+                                                  _message = event.message;
+                                                  markPending();
                                               }
                                           });
                 }
+
+                private:
+                protocol::midi::messageType_t _message = protocol::midi::messageType_t::INVALID;
+
+                bool format(TextFormatter& formatter) override
+                {
+                    formatter.append(Strings::MIDI_MESSAGE(_message));
+                    return true;
+                }
             };
 
             class MessageValueIn : public DisplayElement<12, 1, 0, true>
@@ -127,13 +154,20 @@ namespace io::i2c::display
                                           {
                                               if (event.message != protocol::midi::messageType_t::SYS_EX)
                                               {
-                                                  _midiUpdater.updateMIDIValue(*this, event);
+                                                  _value.set(event);
+                                                  markPending();
                                               }
                                           });
                 }
 
                 private:
                 MIDIUpdater& _midiUpdater;
+                MIDIValue    _value;
+
+                bool format(TextFormatter& formatter) override
+                {
+                    return _midiUpdater.formatMIDIValue(formatter, _value);
+                }
             };
 
             class MessageTypeOut : public DisplayElement<12, 2, 1, true>
@@ -141,23 +175,24 @@ namespace io::i2c::display
                 public:
                 MessageTypeOut()
                 {
-                    MidiDispatcher.listen(messaging::eventType_t::ANALOG,
-                                          [this](const messaging::Event& event)
-                                          {
-                                              setText("%s", Strings::MIDI_MESSAGE(event.message));
-                                          });
+                    auto handler = [this](const messaging::Event& event)
+                    {
+                        _message = event.message;
+                        markPending();
+                    };
+
+                    MidiDispatcher.listen(messaging::eventType_t::ANALOG, handler);
+                    MidiDispatcher.listen(messaging::eventType_t::BUTTON, handler);
+                    MidiDispatcher.listen(messaging::eventType_t::ENCODER, handler);
+                }
 
-                    MidiDispatcher.listen(messaging::eventType_t::BUTTON,
-                                          [this](const messaging::Event& event)
-                                          {
-                                              setText("%s", Strings::MIDI_MESSAGE(event.message));
-                                          });
+                private:
+                protocol::midi::messageType_t _message = protocol::midi::messageType_t::INVALID;
 
-                    MidiDispatcher.listen(messaging::eventType_t::ENCODER,
-                                          [this](const messaging::Event& event)
-                                          {
-                                              setText("%s", Strings::MIDI_MESSAGE(event.message));
-                                          });
+                bool format(TextFormatter& formatter) override
+                {
+                    formatter.append(Strings::MIDI_MESSAGE(_message));
+                    return true;
                 }
             };
 
@@ -167,27 +202,25 @@ namespace io::i2c::display
                 MessageValueOut(MIDIUpdater& midiUpdater)
                     : _midiUpdater(midiUpdater)
                 {
-                    MidiDispatcher.listen(messaging::eventType_t::ANALOG,
-                                          [this](const messaging::Event& event)
-                                          {
-                                              _midiUpdater.updateMIDIValue(*this, event);
-                                          });
-
-                    MidiDispatcher.listen(messaging::eventType_t::BUTTON,
-                                          [this](const messaging::Event& event)
-                                          {
-                                              _midiUpdater.updateMIDIValue(*this, event);
-                                          });
-
-                    MidiDispatcher.listen(messaging::eventType_t::ENCODER,
-                                          [this](const messaging::Event& event)
-                                          {
-                                              _midiUpdater.updateMIDIValue(*this, event);
-                                          });
+                    auto handler = [this](const messaging::Event& event)
+                    {
+                        _value.set(event);
+                        markPending();
+                    };
+
+                    MidiDispatcher.listen(messaging::eventType_t::ANALOG, handler);
+                    MidiDispatcher.listen(messaging::eventType_t::BUTTON, handler);
+                    MidiDispatcher.listen(messaging::eventType_t::ENCODER, handler);
                 }
 
                 private:
                 MIDIUpdater& _midiUpdater;
+                MIDIValue    _value;
+
+                bool format(TextFormatter& formatter) override
+                {
+                    return _midiUpdater.formatMIDIValue(formatter, _value);
+                }
             };
 
             class Preset : public DisplayElement<3, 0, 13, false>
@@ -207,7 +240,17 @@ namespace io::i2c::display
 
                 void setPreset(uint8_t preset)
                 {
-                    setText("P%d", preset);
+                    _preset = preset;
+                    markPending();
+                }
+
+                private:
+                uint8_t _preset = 0;
+
+                bool format(TextFormatter& formatter) override
+                {
+                    formatter.append("P").append(static_cast<int32_t>(_preset));
+                    return true;
                 }
             };
 
@@ -216,7 +259,7 @@ namespace io::i2c::display
                 public:
                 InMessageIndicator()
                 {
-                    setText("%s", Strings::IN_EVENT_STRING);
+                    setText(Strings::IN_EVENT_STRING);
                 }
             };
 
@@ -225,7 +268,7 @@ namespace io::i2c::display
                 public:
                 OutMessageIndicator()
                 {
-                    setText("%s", Strings::OUT_EVENT_STRING);
+                    setText(Strings::OUT_EVENT_STRING);
                 }
             };
 
@@ -258,20 +301,23 @@ namespace io::i2c::display
 
         friend class Elements;
 
-        Hwa&                _hwa;
-        Database&           _database;
-        u8x8_t              _u8x8;
-        Elements            _elements                     = Elements(*this);
-        uint8_t             _u8x8Buffer[U8X8_BUFFER_SIZE] = {};
-        size_t              _u8x8Counter                  = 0;
-        displayResolution_t _resolution                   = displayResolution_t::AMOUNT;
-        bool                _initialized                  = false;
-        bool                _startupInfoShown             = false;
-        uint8_t             _selectedI2Caddress           = 0;
-        size_t              _rows                         = 0;
+        Hwa&                 _hwa;
+        Database&            _database;
+        u8x8_t               _u8x8;
+        Elements             _elements                     = Elements(*this);
+        uint8_t              _u8x8Buffer[U8X8_BUFFER_SIZE] = {};
+        size_t               _u8x8Counter                  = 0;
+        displayResolution_t  _resolution                   = displayResolution_t::AMOUNT;
+        bool                 _initialized                  = false;
+        bool                 _startupInfoShown             = false;
+        bool                 _configTransaction            = false;
+        common::initAction_t _pendingInitAction            = common::initAction_t::AS_IS;
+        uint8_t              _selectedI2Caddress           = 0;
+        size_t               _rows                         = 0;
 
         bool                   initU8X8(uint8_t i2cAddress, displayController_t controller, displayResolution_t resolution);
         bool                   deInit();
+        void                   applyInitAction(common::initAction_t initAction);
         void                   displayWelcomeMessage();
         uint8_t                getTextCenter(uint8_t textSize);
         std::optional<uint8_t> sysConfigGet(sys::Config::Section::i2c_t section, size_t index, uint16_t& value);
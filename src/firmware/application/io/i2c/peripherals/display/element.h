@@ -21,25 +21,78 @@ limitations under the License.
 #include "core/mcu.h"
 #include "core/util/util.h"
 
-#include <cstdio>
 #include <string.h>
 #include <inttypes.h>
-#include <stdarg.h>
 
 namespace io::i2c::display
 {
+    /// Minimal, non-variadic text builder used instead of printf-style formatting.
+    /// Output is silently truncated once the internal buffer is full.
+    class TextFormatter
+    {
+        public:
+        static constexpr uint8_t BUFFER_SIZE = 32;
+
+        TextFormatter() = default;
+
+        TextFormatter& append(const char* text)
+        {
+            while ((*text != '\0') && (_length < (BUFFER_SIZE - 1)))
+            {
+                _buffer[_length++] = *text++;
+            }
+
+            return *this;
+        }
+
+        TextFormatter& append(int32_t value)
+        {
+            char     digits[10] = {};
+            uint8_t  count      = 0;
+            uint32_t absolute   = value < 0 ? 0U - static_cast<uint32_t>(value) : static_cast<uint32_t>(value);
+
+            if (value < 0)
+            {
+                append("-");
+            }
+
+            do
+            {
+                digits[count++] = '0' + (absolute % 10);
+                absolute /= 10;
+            } while (absolute);
+
+            while (count && (_length < (BUFFER_SIZE - 1)))
+            {
+                _buffer[_length++] = digits[--count];
+            }
+
+            return *this;
+        }
+
+        const char* text() const
+        {
+            return _buffer;
+        }
+
+        private:
+        char    _buffer[BUFFER_SIZE] = {};
+        uint8_t _length              = 0;
+    };
+
     class DisplayTextControl
     {
         public:
-        virtual uint8_t     MAX_LENGTH()                   = 0;
-        virtual uint8_t     ROW()                          = 0;
-        virtual uint8_t     COLUMN()                       = 0;
-        virtual bool        USE_RETENTION()                = 0;
-        virtual const char* text()                         = 0;
-        virtual void        setText(const char* text, ...) = 0;
-        virtual uint32_t    change()                       = 0;
-        virtual void        clearChange()                  = 0;
-        virtual uint32_t    lastUpdateTime()               = 0;
+        virtual uint8_t     MAX_LENGTH()              = 0;
+        virtual uint8_t     ROW()                     = 0;
+        virtual uint8_t     COLUMN()                  = 0;
+        virtual bool        USE_RETENTION()           = 0;
+        virtual const char* text()                    = 0;
+        virtual void        setText(const char* text) = 0;
+        virtual void        formatPending()           = 0;
+        virtual uint32_t    change()                  = 0;
+        virtual void        clearChange()             = 0;
+        virtual uint32_t    lastUpdateTime()          = 0;
     };
 
     template<uint8_t maxLength, uint8_t row, uint8_t column, bool useRetention>
@@ -73,38 +126,51 @@ namespace io::i2c::display
             return _text;
         }
 
-        void setText(const char* text, ...) override
+        void setText(const char* text) override
         {
-            static constexpr uint8_t TEXT_BUFFER_SIZE = 32;
-            static_assert((maxLength + 1) <= TEXT_BUFFER_SIZE, "Provided element size too large");
-            static char tempBuff[TEXT_BUFFER_SIZE] = {};
+            static_assert((maxLength + 1) <= TextFormatter::BUFFER_SIZE, "Provided element size too large");
 
-            va_list args;
-            va_start(args, text);
-            int len = vsnprintf(tempBuff, sizeof(tempBuff), text, args);
-            va_end(args);
+            bool terminated = false;
 
-            if (len >= static_cast<int>(sizeof(tempBuff) - 1))
+            // pad with spaces up to the element length, truncate everything beyond it
+            for (size_t i = 0; i < maxLength; i++)
             {
-                // overflow
-                return;
-            }
+                if (!terminated && (text[i] == '\0'))
+                {
+                    terminated = true;
+                }
 
-            memset(&tempBuff[strlen(tempBuff)], ' ', sizeof(tempBuff) - len - 1);
-            tempBuff[sizeof(tempBuff) - 1] = '\0';
+                char newChar = terminated ? ' ' : text[i];
 
-            for (size_t i = 0; i < maxLength; i++)
-            {
-                if (tempBuff[i] != _text[i])
+                if (newChar != _text[i])
                 {
                     core::util::BIT_SET(_textChange, i);
+                    _text[i] = newChar;
                 }
             }
 
-            strncpy(_text, tempBuff, maxLength);
             _lastUpdateTime = core::mcu::timing::ms();
         }
 
+        /// Formats the latest stored value into element text.
+        /// Called only on display refresh so that incoming events only need to store raw values.
+        void formatPending() override
+        {
+            if (!_pending)
+            {
+                return;
+            }
+
+            _pending = false;
+
+            TextFormatter formatter;
+
+            if (format(formatter))
+            {
+                setText(formatter.text());
+            }
+        }
+
         uint32_t change() override
         {
             return _textChange;
@@ -120,9 +186,24 @@ namespace io::i2c::display
             return _lastUpdateTime;
         }
 
+        protected:
+        /// Marks the element for formatting on next display refresh.
+        void markPending()
+        {
+            _pending = true;
+        }
+
+        /// Builds element text from the stored value.
+        /// returns: True if the text should be updated, false otherwise.
+        virtual bool format(TextFormatter& formatter)
+        {
+            return false;
+        }
+
         private:
         char     _text[maxLength + 1] = {};
         uint32_t _textChange          = 0;
         uint32_t _lastUpdateTime      = 0;
+        bool     _pending             = false;
     };
 }    // namespace io::i2c::display
\ No newline at end of file
@@ -36,6 +36,9 @@ void Display::Elements::update()
     {
         auto element = _elements.at(i);
 
+        // only the latest stored value gets formatted, once per refresh
+        element->formatPending();
+
         if (_messageRetentionTime)
         {
             if (element->USE_RETENTION())
@@ -101,31 +104,32 @@ void Display::Elements::MIDIUpdater::useAlternateNote(bool state)
     _useAlternateNote = state;
 }
 
-void Display::Elements::MIDIUpdater::updateMIDIValue(DisplayTextControl& element, const messaging::Event& event)
+bool Display::Elements::MIDIUpdater::formatMIDIValue(TextFormatter& formatter, const MIDIValue& value)
 {
-    switch (event.message)
+    switch (value.message)
     {
     case midi::messageType_t::NOTE_OFF:
     case midi::messageType_t::NOTE_ON:
     {
+        formatter.append("CH").append(static_cast<int32_t>(value.channel)).append(" ");
+
         if (!_useAlternateNote)
         {
-            element.setText("CH%d %d v%d", event.channel, event.index, event.value);
+            formatter.append(static_cast<int32_t>(value.index));
         }
         else
         {
-            element.setText("CH%d %s%d v%d",
-                            event.channel,
-                            Strings::NOTE(midi::NOTE_TO_TONIC(event.index)),
-                            midi::NOTE_TO_OCTAVE(event.value),
-                            event.value);
+            formatter.append(Strings::NOTE(midi::NOTE_TO_TONIC(value.index)))
+                .append(static_cast<int32_t>(midi::NOTE_TO_OCTAVE(value.index)));
         }
+
+        formatter.append(" v").append(static_cast<int32_t>(value.value));
     }
     break;
 
     case midi::messageType_t::PROGRAM_CHANGE:
     {
-        element.setText("CH%d %d", event.channel, event.index);
+        formatter.append("CH").append(static_cast<int32_t>(value.channel)).append(" ").append(static_cast<int32_t>(value.index));
     }
     break;
 
@@ -134,7 +138,12 @@ void Display::Elements::MIDIUpdater::updateMIDIValue(DisplayTextControl& element
     case midi::messageType_t::NRPN_7BIT:
     case midi::messageType_t::NRPN_14BIT:
     {
-        element.setText("CH%d %d %d", event.channel, event.index, event.value);
+        formatter.append("CH")
+            .append(static_cast<int32_t>(value.channel))
+            .append(" ")
+            .append(static_cast<int32_t>(value.index))
+            .append(" ")
+            .append(static_cast<int32_t>(value.value));
     }
     break;
 
@@ -144,7 +153,7 @@ void Display::Elements::MIDIUpdater::updateMIDIValue(DisplayTextControl& element
     case midi::messageType_t::MMC_RECORD_STOP:
     case midi::messageType_t::MMC_PAUSE:
     {
-        element.setText("CH%d", event.index);
+        formatter.append("CH").append(static_cast<int32_t>(value.index));
     }
     break;
 
@@ -156,8 +165,10 @@ void Display::Elements::MIDIUpdater::updateMIDIValue(DisplayTextControl& element
     case midi::messageType_t::SYS_REAL_TIME_SYSTEM_RESET:
     case midi::messageType_t::SYS_EX:
     default:
-        break;
+        return false;
     }
+
+    return true;
 }
 
-#endif
\ No newline at end of file
+#endif
@@ -77,6 +77,10 @@ namespace io::leds
         MIDI_IN_CC_MULTI_VAL,
         LOCAL_CC_MULTI_VAL,
         STATIC,
+        MIDI_IN_NOTE_EFFECT,
+        LOCAL_NOTE_EFFECT,
+        MIDI_IN_CC_EFFECT,
+        LOCAL_CC_EFFECT,
         AMOUNT
     };
 
@@ -102,4 +106,23 @@ namespace io::leds
         B75,
         B100
     };
+
+    enum class effect_t : uint8_t
+    {
+        NONE,
+        FADE_IN,
+        FADE_OUT,
+        PULSE,
+        CHASE,
+        METER_DECAY,
+        AMOUNT
+    };
+
+    enum class effectSpeed_t : uint8_t
+    {
+        SLOW,
+        MEDIUM,
+        FAST,
+        AMOUNT
+    };
 }    // namespace io::leds
\ No newline at end of file
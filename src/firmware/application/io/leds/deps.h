@@ -33,6 +33,7 @@ namespace io::leds
         virtual ~Hwa() = default;
 
         virtual void   setState(size_t index, brightness_t brightness)             = 0;
+        virtual void   setDuty(size_t index, uint8_t duty)                         = 0;
         virtual size_t rgbFromOutput(size_t index)                                 = 0;
         virtual size_t rgbComponentFromRgb(size_t index, rgbComponent_t component) = 0;
     };
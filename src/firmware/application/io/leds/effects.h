@@ -0,0 +1,290 @@
+/*
+
+Copyright Igor Petrovic
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#pragma once
+
+#include "common.h"
+
+#include <inttypes.h>
+#include <stddef.h>
+#include <array>
+
+namespace io::leds
+{
+    /// Computes LED effects frame by frame.
+    /// Each LED with running effect is described with compact descriptor: effect type, last
+    /// written level and 16-bit phase advanced by fixed step on each frame. Everything is
+    /// calculated in fixed point. LEDs with running effect are kept in separate list so that
+    /// LEDs without effect aren't visited at all when computing the frame.
+    /// Levels are 8-bit duty cycles (0-255), written with board::io::digital_out::writeLedDuty.
+    /// Boards without binary code modulation round them to the nearest brightness level.
+    /// Effects need 10 bytes of RAM per LED (6-byte descriptor plus list and slot indexes),
+    /// for all Size LEDs regardless of how many of them run an effect. With Size set to 0,
+    /// no effect can be started.
+    template<size_t Size>
+    class Effects
+    {
+        public:
+        /// Time in milliseconds between two frames.
+        static constexpr uint32_t FRAME_TIME = 10;
+
+        /// Starts the effect on specified LED.
+        /// param [in]: startLevel  Level from which the meter decay starts. Ignored for other effects.
+        /// returns: Level which should be shown before the first frame.
+        uint8_t start(size_t index, effect_t effect, effectSpeed_t speed, uint8_t startLevel = 0xFF)
+        {
+            if ((index >= Size) || (effect == effect_t::NONE) || (effect >= effect_t::AMOUNT) || (speed >= effectSpeed_t::AMOUNT))
+            {
+                stop(index);
+                return 0;
+            }
+
+            auto& descriptor = _descriptor[index];
+
+            descriptor.effect = effect;
+
+            switch (effect)
+            {
+            case effect_t::METER_DECAY:
+            {
+                // phase holds the level itself here
+                descriptor.step  = METER_DECAY_SHIFT[static_cast<uint8_t>(speed)];
+                descriptor.phase = (static_cast<uint16_t>(startLevel) << 8) | startLevel;
+            }
+            break;
+
+            default:
+            {
+                descriptor.step  = PHASE_STEP[static_cast<uint8_t>(speed)];
+                descriptor.phase = 0;
+            }
+            break;
+            }
+
+            descriptor.output = level(index, descriptor);
+
+            if (_slot[index] == NO_SLOT)
+            {
+                _slot[index]          = _totalActive;
+                _active[_totalActive] = index;
+                _totalActive++;
+            }
+
+            return descriptor.output;
+        }
+
+        void stop(size_t index)
+        {
+            if ((index >= Size) || (_slot[index] == NO_SLOT))
+            {
+                return;
+            }
+
+            // move the last active LED to the freed slot
+            auto slot  = _slot[index];
+            auto moved = _active[--_totalActive];
+
+            _active[slot]             = moved;
+            _slot[moved]              = slot;
+            _slot[index]              = NO_SLOT;
+            _descriptor[index].effect = effect_t::NONE;
+        }
+
+        void clear()
+        {
+            while (_totalActive)
+            {
+                stop(_active[_totalActive - 1]);
+            }
+        }
+
+        bool running(size_t index) const
+        {
+            return (index < Size) && (_slot[index] != NO_SLOT);
+        }
+
+        size_t active() const
+        {
+            return _totalActive;
+        }
+
+        /// Computes the next frame for all LEDs with running effect.
+        /// Handler is called only for LEDs whose level has changed, and once the effect
+        /// is done: handler(index, level, done). Finished effects are already removed
+        /// once handler is called.
+        template<typename Handler>
+        void frame(Handler&& handler)
+        {
+            // iterate backwards so that removing finished effects doesn't skip any LED
+            for (size_t i = _totalActive; i-- > 0;)
+            {
+                const uint16_t INDEX      = _active[i];
+                auto&          descriptor = _descriptor[INDEX];
+                bool           done       = advance(descriptor);
+                auto           output     = level(INDEX, descriptor);
+
+                if (done)
+                {
+                    stop(INDEX);
+                }
+                else if (output == descriptor.output)
+                {
+                    continue;
+                }
+
+                descriptor.output = output;
+                handler(INDEX, output, done);
+            }
+        }
+
+        private:
+        struct Descriptor
+        {
+            effect_t effect = effect_t::NONE;
+            uint8_t  output = 0;
+            uint16_t step   = 0;
+            uint16_t phase  = 0;
+        };
+
+        static constexpr uint16_t NO_SLOT   = 0xFFFF;
+        static constexpr uint16_t PHASE_MAX = 0xFFFF;
+
+        /// Phase difference between two neighbouring LEDs running the chase effect.
+        /// With this value, 8 LEDs form a single chase cycle.
+        static constexpr uint16_t CHASE_PHASE_OFFSET = 0x2000;
+
+        /// Duration of fade or single pulse/chase cycle in milliseconds for all speeds.
+        static constexpr uint32_t CYCLE_TIME[static_cast<uint8_t>(effectSpeed_t::AMOUNT)] = {
+            2000,
+            1000,
+            500,
+        };
+
+        /// Phase increment per frame for all speeds.
+        static constexpr uint16_t PHASE_STEP[static_cast<uint8_t>(effectSpeed_t::AMOUNT)] = {
+            static_cast<uint16_t>(0x10000 * FRAME_TIME / CYCLE_TIME[0]),
+            static_cast<uint16_t>(0x10000 * FRAME_TIME / CYCLE_TIME[1]),
+            static_cast<uint16_t>(0x10000 * FRAME_TIME / CYCLE_TIME[2]),
+        };
+
+        /// Meter level is reduced by level >> shift on each frame.
+        static constexpr uint16_t METER_DECAY_SHIFT[static_cast<uint8_t>(effectSpeed_t::AMOUNT)] = {
+            6,
+            5,
+            4,
+        };
+
+        std::array<Descriptor, Size> _descriptor  = {};
+        std::array<uint16_t, Size>   _active      = {};
+        std::array<uint16_t, Size>   _slot        = emptySlots();
+        size_t                       _totalActive = 0;
+
+        static constexpr std::array<uint16_t, Size> emptySlots()
+        {
+            std::array<uint16_t, Size> slots = {};
+
+            for (auto& slot : slots)
+            {
+                slot = NO_SLOT;
+            }
+
+            return slots;
+        }
+
+        /// Advances the phase of the effect by one frame.
+        /// returns: True once the effect is done.
+        static bool advance(Descriptor& descriptor)
+        {
+            switch (descriptor.effect)
+            {
+            case effect_t::FADE_IN:
+            case effect_t::FADE_OUT:
+            {
+                if ((PHASE_MAX - descriptor.phase) <= descriptor.step)
+                {
+                    descriptor.phase = PHASE_MAX;
+                    return true;
+                }
+
+                descriptor.phase += descriptor.step;
+            }
+            break;
+
+            case effect_t::METER_DECAY:
+            {
+                // exponential decay, at least one level step per frame so that it always ends
+                uint16_t decrement = descriptor.phase >> descriptor.step;
+
+                if (decrement < 0x100)
+                {
+                    decrement = 0x100;
+                }
+
+                if (descriptor.phase <= decrement)
+                {
+                    descriptor.phase = 0;
+                    return true;
+                }
+
+                descriptor.phase -= decrement;
+            }
+            break;
+
+            default:
+            {
+                // periodic effects: phase simply wraps around
+                descriptor.phase += descriptor.step;
+            }
+            break;
+            }
+
+            return false;
+        }
+
+        /// Calculates current level (0-255) of the LED.
+        static uint8_t level(size_t index, const Descriptor& descriptor)
+        {
+            switch (descriptor.effect)
+            {
+            case effect_t::FADE_IN:
+            case effect_t::METER_DECAY:
+                return descriptor.phase >> 8;
+
+            case effect_t::FADE_OUT:
+                return 0xFF - (descriptor.phase >> 8);
+
+            case effect_t::PULSE:
+            {
+                // triangle wave
+                uint16_t phase = descriptor.phase;
+                return ((phase & 0x8000) ? static_cast<uint16_t>(~phase) : phase) >> 7;
+            }
+
+            case effect_t::CHASE:
+            {
+                // sawtooth with sharp leading edge: neighbouring LEDs are lit one after another
+                uint16_t phase = descriptor.phase - static_cast<uint16_t>(index * CHASE_PHASE_OFFSET);
+                return 0xFF - (phase >> 8);
+            }
+
+            default:
+                return 0;
+            }
+        }
+    };
+}    // namespace io::leds
@@ -33,6 +33,11 @@ namespace io::leds
             board::io::digital_out::writeLedState(index, static_cast<board::io::digital_out::ledBrightness_t>(brightness));
         }
 
+        void setDuty(size_t index, uint8_t duty) override
+        {
+            board::io::digital_out::writeLedDuty(index, duty);
+        }
+
         size_t rgbFromOutput(size_t index) override
         {
             return board::io::digital_out::rgbFromOutput(index);
@@ -31,6 +31,10 @@ namespace io::leds
         {
         }
 
+        void setDuty(size_t index, uint8_t duty) override
+        {
+        }
+
         size_t rgbFromOutput(size_t index) override
         {
             return 0;
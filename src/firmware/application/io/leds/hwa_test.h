@@ -30,6 +30,7 @@ namespace io::leds
         HwaTest() = default;
 
         MOCK_METHOD2(setState, void(size_t index, brightness_t brightness));
+        MOCK_METHOD2(setDuty, void(size_t index, uint8_t duty));
 
         size_t rgbComponentFromRgb(size_t index, rgbComponent_t component) override
         {
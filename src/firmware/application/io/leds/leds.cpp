@@ -21,6 +21,7 @@ limitations under the License.
 #include "leds.h"
 #include "application/messaging/messaging.h"
 #include "application/global/midi_program.h"
+#include "application/global/midi_clock.h"
 #include "application/util/conversion/conversion.h"
 #include "application/util/configurable/configurable.h"
 
@@ -59,12 +60,6 @@ Leds::Leds(Hwa&      hwa,
                               }
                               break;
 
-                              case midi::messageType_t::SYS_REAL_TIME_CLOCK:
-                              {
-                                  updateAll(true);
-                              }
-                              break;
-
                               case midi::messageType_t::SYS_REAL_TIME_START:
                               {
                                   resetBlinking();
@@ -132,39 +127,24 @@ Leds::Leds(Hwa&      hwa,
                               }
                           });
 
-    MidiDispatcher.listen(messaging::eventType_t::TOUCHSCREEN_SCREEN,
-                          [this](const messaging::Event& event)
-                          {
-                              refresh();
-                          });
-
     MidiDispatcher.listen(messaging::eventType_t::PROGRAM,
                           [this](const messaging::Event& event)
                           {
                               midiToState(event, messaging::eventType_t::PROGRAM);
                           });
 
-    ConfigHandler.registerConfig(
-        sys::Config::block_t::LEDS,
-        // read
-        [this](uint8_t section, size_t index, uint16_t& value)
-        {
-            return sysConfigGet(static_cast<sys::Config::Section::leds_t>(section), index, value);
-        },
-
-        // write
-        [this](uint8_t section, size_t index, uint16_t value)
-        {
-            return sysConfigSet(static_cast<sys::Config::Section::leds_t>(section), index, value);
-        });
+    ConfigHandler.registerConfig<&Leds::sysConfigGet, &Leds::sysConfigSet>(sys::Config::block_t::LEDS, this);
 }
 
 bool Leds::init()
 {
+    _startUpAnimationActive = false;
+
     setAllOff();
 
     if (_database.read(database::Config::Section::leds_t::GLOBAL, setting_t::USE_STARTUP_ANIMATION))
     {
+        // animation is only started here and continues in the background through updateAll
         startUpAnimation();
     }
 
@@ -182,11 +162,21 @@ void Leds::updateSingle(size_t index, bool forceRefresh)
 
 void Leds::updateAll(bool forceRefresh)
 {
+    if (updateStartUpAnimation())
+    {
+        return;
+    }
+
+    updateEffects();
+
     if (_blinkResetArrayPtr == nullptr)
     {
         return;
     }
 
+    uint8_t steps   = 1;
+    bool    refresh = false;
+
     switch (_ledBlinkType)
     {
     case blinkType_t::TIMER:
@@ -202,9 +192,26 @@ void Leds::updateAll(bool forceRefresh)
 
     case blinkType_t::MIDI_CLOCK:
     {
-        if (!forceRefresh)
+        // blinking follows the smoothed clock phase so that the jitter of incoming clock isn't visible
+        auto pulses = MidiClock.pulses(core::mcu::timing::ms());
+
+        if (pulses == _lastClockPulse)
         {
-            return;
+            if (!forceRefresh)
+            {
+                return;
+            }
+
+            // no new pulses: only apply current blink states, e.g. after blinking is reset on MIDI start
+            refresh = true;
+        }
+
+        steps           = pulses - _lastClockPulse;
+        _lastClockPulse = pulses;
+
+        if (steps > MAX_CLOCK_STEPS_PER_UPDATE)
+        {
+            steps = MAX_CLOCK_STEPS_PER_UPDATE;
         }
     }
     break;
@@ -216,14 +223,18 @@ void Leds::updateAll(bool forceRefresh)
     // change the blink state for specific blink rate
     for (size_t i = 0; i < TOTAL_BLINK_SPEEDS; i++)
     {
-        if (++_blinkCounter[i] < _blinkResetArrayPtr[i])
+        _blinkCounter[i] += steps;
+
+        if (_blinkCounter[i] >= _blinkResetArrayPtr[i])
+        {
+            _blinkState[i]   = !_blinkState[i];
+            _blinkCounter[i] = 0;
+        }
+        else if (!refresh)
         {
             continue;
         }
 
-        _blinkState[i]   = !_blinkState[i];
-        _blinkCounter[i] = 0;
-
         // assign changed state to all leds which have this speed
         for (size_t j = 0; j < Collection::SIZE(); j++)
         {
@@ -250,31 +261,77 @@ size_t Leds::maxComponentUpdateIndex()
 
 __attribute__((weak)) void Leds::startUpAnimation()
 {
-    // turn all leds on first
-    setAllOn();
+    // turn all leds on first: rgb leds in red only
+    for (size_t i = 0; i < Collection::SIZE(GROUP_DIGITAL_OUTPUTS); i++)
+    {
+        auto rgbIndex = _hwa.rgbFromOutput(i);
+        bool on       = true;
+
+        if (_database.read(database::Config::Section::leds_t::RGB_ENABLE, rgbIndex))
+        {
+            on = _hwa.rgbComponentFromRgb(rgbIndex, rgbComponent_t::R) == i;
+        }
 
-    core::mcu::timing::waitMs(1000);
+        _hwa.setState(i, on ? brightness_t::B100 : brightness_t::OFF);
+    }
 
-    for (size_t i = 0; i < Collection::SIZE(GROUP_DIGITAL_OUTPUTS); i++)
+    _startUpAnimationActive = true;
+    _startUpAnimationFrame  = 0;
+    _startUpAnimationTime   = core::mcu::timing::ms() + STARTUP_ANIMATION_HOLD_TIME;
+}
+
+/// Shows the next frame of startup animation once it's due.
+/// returns: True while the animation is running.
+bool Leds::updateStartUpAnimation()
+{
+    if (!_startUpAnimationActive)
     {
-        setState(i, brightness_t::OFF);
-        core::mcu::timing::waitMs(35);
+        return false;
     }
 
-    for (size_t i = 0; i < Collection::SIZE(GROUP_DIGITAL_OUTPUTS); i++)
+    if (static_cast<int32_t>(core::mcu::timing::ms() - _startUpAnimationTime) < 0)
     {
-        setState(Collection::SIZE(GROUP_DIGITAL_OUTPUTS) - 1 - i, brightness_t::B100);
-        core::mcu::timing::waitMs(35);
+        return true;
     }
 
-    for (size_t i = 0; i < Collection::SIZE(GROUP_DIGITAL_OUTPUTS); i++)
+    const size_t TOTAL_LEDS   = Collection::SIZE(GROUP_DIGITAL_OUTPUTS);
+    const size_t TOTAL_FRAMES = TOTAL_LEDS * STARTUP_ANIMATION_PASSES;
+
+    if (_startUpAnimationFrame < TOTAL_FRAMES)
+    {
+        auto pass  = _startUpAnimationFrame / TOTAL_LEDS;
+        auto index = _startUpAnimationFrame % TOTAL_LEDS;
+
+        switch (pass)
+        {
+        case 1:
+        {
+            _hwa.setState(TOTAL_LEDS - 1 - index, brightness_t::B100);
+        }
+        break;
+
+        default:
+        {
+            _hwa.setState(index, brightness_t::OFF);
+        }
+        break;
+        }
+
+        _startUpAnimationFrame++;
+        _startUpAnimationTime += STARTUP_ANIMATION_FRAME_TIME;
+
+        return true;
+    }
+
+    // done: show the states set in the meantime
+    _startUpAnimationActive = false;
+
+    for (size_t i = 0; i < TOTAL_LEDS; i++)
     {
-        setState(i, brightness_t::OFF);
-        core::mcu::timing::waitMs(35);
+        setState(i, bit(i, ledBit_t::STATE) ? _brightness[i] : brightness_t::OFF);
     }
 
-    // turn all off again
-    setAllOff();
+    return false;
 }
 
 color_t Leds::valueToColor(uint8_t value)
@@ -304,6 +361,38 @@ brightness_t Leds::valueToBrightness(uint8_t value)
     return static_cast<brightness_t>((value % 16 % TOTAL_BRIGHTNESS_VALUES) + 1);
 }
 
+effect_t Leds::valueToEffect(uint8_t value)
+{
+    value %= 16;
+
+    if (!value)
+    {
+        return effect_t::NONE;
+    }
+
+    // each effect is available in all speeds
+    return static_cast<effect_t>(((value - 1) / static_cast<uint8_t>(effectSpeed_t::AMOUNT)) + 1);
+}
+
+effectSpeed_t Leds::valueToEffectSpeed(uint8_t value)
+{
+    value %= 16;
+
+    if (!value)
+    {
+        return effectSpeed_t::SLOW;
+    }
+
+    return static_cast<effectSpeed_t>((value - 1) % static_cast<uint8_t>(effectSpeed_t::AMOUNT));
+}
+
+/// Level from which the meter decay starts.
+/// Upper 3 bits of the value, which also select the color, are scaled to the full range.
+uint8_t Leds::valueToEffectLevel(uint8_t value)
+{
+    return (value / 16) * 0xFF / 7;
+}
+
 void Leds::midiToState(const messaging::Event& event, messaging::eventType_t source)
 {
     const uint8_t GLOBAL_CHANNEL     = _database.read(database::Config::Section::global_t::MIDI_SETTINGS, midi::setting_t::GLOBAL_CHANNEL);
@@ -347,6 +436,7 @@ void Leds::midiToState(const messaging::Event& event, messaging::eventType_t sou
 
         bool setState     = false;
         bool setBlink     = false;
+        bool setEffect    = false;
         bool checkChannel = true;
 
         // determine whether led state or blink state should be changed
@@ -415,6 +505,26 @@ void Leds::midiToState(const messaging::Event& event, messaging::eventType_t sou
             }
             break;
 
+            case controlType_t::LOCAL_NOTE_EFFECT:
+            {
+                if (message == midi::messageType_t::NOTE_ON)
+                {
+                    setState  = true;
+                    setEffect = true;
+                }
+            }
+            break;
+
+            case controlType_t::LOCAL_CC_EFFECT:
+            {
+                if (message == midi::messageType_t::CONTROL_CHANGE)
+                {
+                    setState  = true;
+                    setEffect = true;
+                }
+            }
+            break;
+
             default:
                 break;
             }
@@ -470,6 +580,26 @@ void Leds::midiToState(const messaging::Event& event, messaging::eventType_t sou
             }
             break;
 
+            case controlType_t::MIDI_IN_NOTE_EFFECT:
+            {
+                if (message == midi::messageType_t::NOTE_ON)
+                {
+                    setState  = true;
+                    setEffect = true;
+                }
+            }
+            break;
+
+            case controlType_t::MIDI_IN_CC_EFFECT:
+            {
+                if (message == midi::messageType_t::CONTROL_CHANGE)
+                {
+                    setState  = true;
+                    setEffect = true;
+                }
+            }
+            break;
+
             default:
                 break;
             }
@@ -520,8 +650,14 @@ void Leds::midiToState(const messaging::Event& event, messaging::eventType_t sou
                     }
                     else
                     {
+                        // in effect modes, lower 4 bits of the value select the effect instead of the brightness
+                        if (setEffect)
+                        {
+                            color      = valueToColor(event.value);
+                            brightness = (color != color_t::OFF) ? brightness_t::B100 : brightness_t::OFF;
+                        }
                         // when note/cc are used to control both state and blinking ignore activation velocity
-                        if (setState && setBlink)
+                        else if (setState && setBlink)
                         {
                             color      = valueToColor(event.value);
                             brightness = valueToBrightness(event.value);
@@ -535,6 +671,11 @@ void Leds::midiToState(const messaging::Event& event, messaging::eventType_t sou
                     }
 
                     setColor(i, color, brightness);
+
+                    if (setEffect)
+                    {
+                        startEffect(i, valueToEffect(event.value), valueToEffectSpeed(event.value), valueToEffectLevel(event.value));
+                    }
                 }
                 else
                 {
@@ -601,6 +742,71 @@ void Leds::setBlinkSpeed(uint8_t index, blinkSpeed_t state, bool updateState)
     }
 }
 
+void Leds::startEffect(uint8_t index, effect_t effect, effectSpeed_t speed, uint8_t level)
+{
+    if ((effect == effect_t::NONE) || !EFFECTS_SIZE)
+    {
+        return;
+    }
+
+    uint8_t ledArray[3]   = {};
+    uint8_t leds          = 0;
+    uint8_t rgbFromOutput = _hwa.rgbFromOutput(index);
+
+    if (_database.read(database::Config::Section::leds_t::RGB_ENABLE, rgbFromOutput))
+    {
+        ledArray[0] = _hwa.rgbComponentFromRgb(rgbFromOutput, rgbComponent_t::R);
+        ledArray[1] = _hwa.rgbComponentFromRgb(rgbFromOutput, rgbComponent_t::G);
+        ledArray[2] = _hwa.rgbComponentFromRgb(rgbFromOutput, rgbComponent_t::B);
+
+        leds = 3;
+    }
+    else
+    {
+        ledArray[0] = index;
+
+        leds = 1;
+    }
+
+    for (int i = 0; i < leds; i++)
+    {
+        // effect runs only on the components which form the selected color
+        if (!bit(ledArray[i], ledBit_t::ACTIVE))
+        {
+            continue;
+        }
+
+        setDuty(ledArray[i], _effects.start(ledArray[i], effect, speed, level));
+    }
+}
+
+void Leds::updateEffects()
+{
+    if (!_effects.active())
+    {
+        return;
+    }
+
+    if ((core::mcu::timing::ms() - _lastEffectsUpdateTime) < Effects<EFFECTS_SIZE>::FRAME_TIME)
+    {
+        return;
+    }
+
+    _lastEffectsUpdateTime = core::mcu::timing::ms();
+
+    _effects.frame([this](size_t index, uint8_t duty, bool done)
+                   {
+                       if (done && !duty)
+                       {
+                           // fading out and meter decay end with LED turned off
+                           resetState(index);
+                           return;
+                       }
+
+                       setDuty(index, duty);
+                   });
+}
+
 void Leds::setAllOn()
 {
     // turn on all Leds
@@ -631,14 +837,6 @@ void Leds::setAllOff()
     }
 }
 
-void Leds::refresh()
-{
-    for (size_t i = 0; i < Collection::SIZE(); i++)
-    {
-        setState(i, _brightness[i]);
-    }
-}
-
 void Leds::setColor(uint8_t index, color_t color, brightness_t brightness)
 {
     uint8_t rgbFromOutput = _hwa.rgbFromOutput(index);
@@ -647,6 +845,9 @@ void Leds::setColor(uint8_t index, color_t color, brightness_t brightness)
     {
         if (state)
         {
+            // any running effect is replaced with the new state
+            _effects.stop(index);
+
             updateBit(index, ledBit_t::ACTIVE, true);
             updateBit(index, ledBit_t::STATE, true);
 
@@ -750,6 +951,8 @@ void Leds::resetBlinking()
         _blinkCounter[i] = 0;
         _blinkState[i]   = true;
     }
+
+    _lastClockPulse = 0;
 }
 
 void Leds::updateBit(uint8_t index, ledBit_t bit, bool state)
@@ -792,6 +995,7 @@ void Leds::resetState(uint8_t index)
 {
     _ledState[index]   = 0;
     _brightness[index] = brightness_t::OFF;
+    _effects.stop(index);
     setState(index, brightness_t::OFF);
 }
 
@@ -808,12 +1012,25 @@ void Leds::setState(size_t index, brightness_t brightness)
 
         MidiDispatcher.notify(messaging::eventType_t::TOUCHSCREEN_LED, event);
     }
-    else
+    else if (!_startUpAnimationActive)
     {
         _hwa.setState(index, brightness);
     }
 }
 
+void Leds::setDuty(size_t index, uint8_t duty)
+{
+    if (index >= Collection::SIZE(GROUP_DIGITAL_OUTPUTS))
+    {
+        // touchscreen supports brightness levels only: round to the nearest one (4 levels + off)
+        setState(index, static_cast<brightness_t>((duty * 4 + 127) / 255));
+    }
+    else if (!_startUpAnimationActive)
+    {
+        _hwa.setDuty(index, duty);
+    }
+}
+
 std::optional<uint8_t> Leds::sysConfigGet(sys::Config::Section::leds_t section, size_t index, uint16_t& value)
 {
     uint32_t readValue;
@@ -19,6 +19,7 @@ limitations under the License.
 #pragma once
 
 #include "deps.h"
+#include "effects.h"
 #include "application/database/database.h"
 #include "application/protocol/midi/midi.h"
 #include "application/io/common/common.h"
@@ -44,6 +45,15 @@ namespace io::leds
         blinkSpeed_t blinkSpeed(uint8_t index);
         void         setAllOff();
 
+        /// Time in milliseconds during which all LEDs are on at the beginning of startup animation.
+        static constexpr uint32_t STARTUP_ANIMATION_HOLD_TIME = 1000;
+
+        /// Time in milliseconds between two frames of startup animation.
+        static constexpr uint32_t STARTUP_ANIMATION_FRAME_TIME = 35;
+
+        /// Amount of passes over all LEDs in startup animation: turn off, turn on in reverse, turn off.
+        static constexpr size_t STARTUP_ANIMATION_PASSES = 3;
+
         private:
         enum class ledBit_t : uint8_t
         {
@@ -60,6 +70,9 @@ namespace io::leds
         static constexpr size_t  TOTAL_BRIGHTNESS_VALUES         = 4;
         static constexpr uint8_t LED_BLINK_TIMER_TYPE_CHECK_TIME = 50;
 
+        /// Maximum amount of MIDI clock pulses by which blinking is advanced in single update.
+        static constexpr uint8_t MAX_CLOCK_STEPS_PER_UPDATE = 12;
+
         /// Array holding MIDI clock pulses after which LED state is toggled for all possible blink rates.
         static constexpr uint8_t BLINK_RESET_MIDI_CLOCK[TOTAL_BLINK_SPEEDS] = {
             48,
@@ -88,6 +101,10 @@ namespace io::leds
             protocol::midi::messageType_t::CONTROL_CHANGE,    // MIDI_IN_CC_MULTI_VAL,
             protocol::midi::messageType_t::CONTROL_CHANGE,    // LOCAL_CC_MULTI_VAL,
             protocol::midi::messageType_t::INVALID,           // STATIC
+            protocol::midi::messageType_t::NOTE_ON,           // MIDI_IN_NOTE_EFFECT,
+            protocol::midi::messageType_t::NOTE_ON,           // LOCAL_NOTE_EFFECT,
+            protocol::midi::messageType_t::CONTROL_CHANGE,    // MIDI_IN_CC_EFFECT,
+            protocol::midi::messageType_t::CONTROL_CHANGE,    // LOCAL_CC_EFFECT,
         };
 
         Hwa&      _hwa;
@@ -117,9 +134,36 @@ namespace io::leds
         /// Holds last time in miliseconds when LED blinking has been updated.
         uint32_t _lastLEDblinkUpdateTime = 0;
 
+        /// Holds the amount of smoothed MIDI clock pulses at which LED blinking has been updated.
+        uint32_t _lastClockPulse = 0;
+
+#ifdef OPENDECK_USE_LED_EFFECTS
+        static constexpr size_t EFFECTS_SIZE = Collection::SIZE();
+#else
+        // effect control modes show static color only
+        static constexpr size_t EFFECTS_SIZE = 0;
+#endif
+
+        /// Effects running on LEDs.
+        /// Takes 10 bytes of RAM per LED, see Effects.
+        Effects<EFFECTS_SIZE> _effects;
+
+        /// Holds last time in milliseconds when LED effects have been updated.
+        uint32_t _lastEffectsUpdateTime = 0;
+
+        /// Set while startup animation is running.
+        /// Animation drives physical LEDs directly: LED states are still tracked in the meantime
+        /// and applied once the animation is done.
+        bool _startUpAnimationActive = false;
+
+        /// Next frame of startup animation to be shown.
+        size_t _startUpAnimationFrame = 0;
+
+        /// Time in milliseconds at which next frame of startup animation should be shown.
+        uint32_t _startUpAnimationTime = 0;
+
         void                   setAllOn();
         void                   setAllStaticOn();
-        void                   refresh();
         void                   setBlinkSpeed(uint8_t index, blinkSpeed_t state, bool updateState = true);
         void                   setBlinkType(blinkType_t blinkType);
         void                   resetBlinking();
@@ -129,10 +173,17 @@ namespace io::leds
         color_t                valueToColor(uint8_t value);
         blinkSpeed_t           valueToBlinkSpeed(uint8_t value);
         brightness_t           valueToBrightness(uint8_t value);
+        effect_t               valueToEffect(uint8_t value);
+        effectSpeed_t          valueToEffectSpeed(uint8_t value);
+        uint8_t                valueToEffectLevel(uint8_t value);
+        void                   startEffect(uint8_t index, effect_t effect, effectSpeed_t speed, uint8_t level);
+        void                   updateEffects();
         void                   startUpAnimation();
+        bool                   updateStartUpAnimation();
         bool                   isControlTypeMatched(protocol::midi::messageType_t midiMessage, controlType_t controlType);
         void                   midiToState(const messaging::Event& event, messaging::eventType_t source);
         void                   setState(size_t index, brightness_t brightness);
+        void                   setDuty(size_t index, uint8_t duty);
         std::optional<uint8_t> sysConfigGet(sys::Config::Section::leds_t section, size_t index, uint16_t& value);
         std::optional<uint8_t> sysConfigSet(sys::Config::Section::leds_t section, size_t index, uint16_t value);
     };
@@ -97,7 +97,8 @@ namespace io::touchscreen
         virtual bool      deInit()                               = 0;
         virtual bool      setScreen(size_t index)                = 0;
         virtual tsEvent_t update(Data& tsData)                   = 0;
-        virtual void      setIconState(Icon& icon, bool state)   = 0;
+        virtual bool      setIconState(Icon& icon, bool state)   = 0;
+        virtual void      flush()                                = 0;
         virtual bool      setBrightness(brightness_t brightness) = 0;
 
         protected:
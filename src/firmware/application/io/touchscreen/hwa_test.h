@@ -23,6 +23,8 @@ limitations under the License.
 
 #include "core/util/util.h"
 
+#include <vector>
+
 namespace io::touchscreen
 {
     class HwaTest : public Hwa
@@ -42,6 +44,7 @@ namespace io::touchscreen
 
         bool write(uint8_t value) override
         {
+            _writeBuffer.push_back(value);
             return true;
         }
 
@@ -54,5 +57,7 @@ namespace io::touchscreen
         {
             return false;
         }
+
+        std::vector<uint8_t> _writeBuffer = {};
     };
 }    // namespace io::touchscreen
@@ -24,8 +24,6 @@ limitations under the License.
 
 #include "core/mcu.h"
 
-#include <stdarg.h>
-#include <stdio.h>
 #include <string.h>
 
 using namespace io::touchscreen;
@@ -73,7 +71,7 @@ bool Nextion::setScreen(size_t index)
         return true;
     }
 
-    return writeCommand("page %u", index);
+    return writeCommand(COMMAND_PAGE, { static_cast<uint16_t>(index) });
 }
 
 tsEvent_t Nextion::update(Data& data)
@@ -118,44 +116,85 @@ tsEvent_t Nextion::update(Data& data)
     return retVal;
 }
 
-void Nextion::setIconState(Icon& icon, bool state)
+bool Nextion::setIconState(Icon& icon, bool state)
 {
     maybeFinishPostInit();
 
     if (_postInitPending)
     {
-        return;
+        // display isn't ready yet - let the caller retry later
+        return false;
     }
 
     // ignore width/height zero - set either intentionally to avoid display or incorrectly
     if (!icon.width)
     {
-        return;
+        return true;
     }
 
     if (!icon.height)
     {
-        return;
+        return true;
     }
 
-    writeCommand("picq %u,%u,%u,%u,%u", icon.xPos, icon.yPos, icon.width, icon.height, state ? icon.onScreen : icon.offScreen);
+    writeCommand(COMMAND_PICQ, { icon.xPos, icon.yPos, icon.width, icon.height, state ? icon.onScreen : icon.offScreen });
+
+    return true;
 }
 
-bool Nextion::writeCommand(const char* line, ...)
+void Nextion::flush()
 {
-    va_list args;
-    va_start(args, line);
-
-    int retVal = vsnprintf(_commandBuffer, Model::BUFFER_SIZE, line, args);
+    // commands are written immediately, nothing to do
+}
 
-    va_end(args);
+/// Builds command from template prefix followed by comma-separated numeric arguments
+/// and writes it to display in one go.
+/// param [in]: prefix  Command template.
+/// param [in]: args    Numeric arguments appended to the template.
+/// returns: True on success, false otherwise or if the command doesn't fit in the buffer.
+bool Nextion::writeCommand(const char* prefix, std::initializer_list<uint16_t> args)
+{
+    size_t length = strlen(prefix);
 
-    if (retVal < 0)
+    if (length > Model::BUFFER_SIZE)
     {
         return false;
     }
 
-    for (size_t i = 0; i < strlen(_commandBuffer); i++)
+    memcpy(_commandBuffer, prefix, length);
+
+    bool first = true;
+
+    for (auto arg : args)
+    {
+        char   digits[5] = {};
+        size_t count     = 0;
+
+        do
+        {
+            digits[count++] = '0' + (arg % 10);
+            arg /= 10;
+        } while (arg);
+
+        if ((length + (first ? 0 : 1) + count) > Model::BUFFER_SIZE)
+        {
+            return false;
+        }
+
+        if (!first)
+        {
+            _commandBuffer[length++] = ',';
+        }
+
+        first = false;
+
+        while (count)
+        {
+            _commandBuffer[length++] = digits[--count];
+        }
+    }
+
+    for (size_t i = 0; i < length; i++)
     {
         if (!_hwa.write(_commandBuffer[i]))
         {
@@ -190,7 +229,7 @@ bool Nextion::setBrightness(brightness_t brightness)
         return true;
     }
 
-    return writeCommand("dims=%d", BRIGHTNESS_MAPPING[static_cast<uint8_t>(brightness)]);
+    return writeCommand(COMMAND_DIMS, { BRIGHTNESS_MAPPING[static_cast<uint8_t>(brightness)] });
 }
 
 void Nextion::maybeFinishPostInit()
@@ -209,17 +248,17 @@ void Nextion::maybeFinishPostInit()
     _postInitPending = false;
 
     endCommand();
-    writeCommand("sendxy=1");
+    writeCommand(COMMAND_SENDXY);
 
     if (_pendingScreenValid)
     {
-        writeCommand("page %u", _pendingScreenIndex);
+        writeCommand(COMMAND_PAGE, { static_cast<uint16_t>(_pendingScreenIndex) });
         _pendingScreenValid = false;
     }
 
     if (_pendingBrightnessValid)
     {
-        writeCommand("dims=%d", BRIGHTNESS_MAPPING[static_cast<uint8_t>(_pendingBrightness)]);
+        writeCommand(COMMAND_DIMS, { BRIGHTNESS_MAPPING[static_cast<uint8_t>(_pendingBrightness)] });
         _pendingBrightnessValid = false;
     }
 }
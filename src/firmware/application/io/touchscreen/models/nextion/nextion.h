@@ -22,6 +22,8 @@ limitations under the License.
 
 #include "core/util/ring_buffer.h"
 
+#include <initializer_list>
+
 namespace io::touchscreen
 {
     class Nextion : public Model
@@ -33,7 +35,8 @@ namespace io::touchscreen
         bool      deInit() override;
         bool      setScreen(size_t index) override;
         tsEvent_t update(Data& data) override;
-        void      setIconState(Icon& icon, bool state) override;
+        bool      setIconState(Icon& icon, bool state) override;
+        void      flush() override;
         bool      setBrightness(brightness_t brightness) override;
 
         private:
@@ -57,6 +60,13 @@ namespace io::touchscreen
             },
         };
 
+        /// Command templates: each command consists of the template followed by
+        /// comma-separated numeric arguments.
+        static constexpr const char* COMMAND_PAGE   = "page ";
+        static constexpr const char* COMMAND_PICQ   = "picq ";
+        static constexpr const char* COMMAND_DIMS   = "dims=";
+        static constexpr const char* COMMAND_SENDXY = "sendxy=1";
+
         // there are 7 levels of brighness - scale them to available range (0-100)
         static constexpr uint8_t BRIGHTNESS_MAPPING[7] = {
             10,
@@ -81,7 +91,7 @@ namespace io::touchscreen
 
         void maybeFinishPostInit();
 
-        bool      writeCommand(const char* line, ...);
+        bool      writeCommand(const char* prefix, std::initializer_list<uint16_t> args = {});
         bool      endCommand();
         tsEvent_t response(Data& data);
     };
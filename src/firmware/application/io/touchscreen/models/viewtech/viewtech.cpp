@@ -56,6 +56,7 @@ bool Viewtech::deInit()
     _postInitReadyAtMs      = 0;
     _pendingScreenValid     = false;
     _pendingBrightnessValid = false;
+    _vpWritesCount          = 0;
     return _hwa.deInit();
 }
 
@@ -149,33 +150,82 @@ tsEvent_t Viewtech::update(Data& data)
     return event;
 }
 
-void Viewtech::setIconState(Icon& icon, bool state)
+bool Viewtech::setIconState(Icon& icon, bool state)
+{
+    // icon address - for viewtech displays, address is stored in xPos element
+    // inverted logic for setting state - 0 means on state, 1 is off
+    VpWrite write = {
+        .address = icon.xPos,
+        .value   = static_cast<uint16_t>(state ? 0x00 : 0x01),
+    };
+
+    // writes are queued and sent on flush so that contiguous addresses can be grouped in a single frame
+    for (size_t i = 0; i < _vpWritesCount; i++)
+    {
+        if (_vpWrites[i].address == write.address)
+        {
+            _vpWrites[i].value = write.value;
+            return true;
+        }
+    }
+
+    if (_vpWritesCount >= Collection::SIZE())
+    {
+        flush();
+
+        if (_vpWritesCount >= Collection::SIZE())
+        {
+            // queue can't be sent before the display is ready - reject the write
+            // so that the caller keeps it pending instead of losing it
+            return false;
+        }
+    }
+
+    _vpWrites[_vpWritesCount++] = write;
+
+    return true;
+}
+
+void Viewtech::flush()
 {
     maybeFinishPostInit();
 
-    if (_postInitPending)
+    if (_postInitPending || !_vpWritesCount)
     {
         return;
     }
 
-    // header
-    _hwa.write(0xA5);
-    _hwa.write(0x5A);
+    // sort by address so that contiguous registers end up next to each other
+    for (size_t i = 1; i < _vpWritesCount; i++)
+    {
+        auto   write = _vpWrites[i];
+        size_t j     = i;
 
-    // request size
-    _hwa.write(0x05);
+        while (j && (_vpWrites[j - 1].address > write.address))
+        {
+            _vpWrites[j] = _vpWrites[j - 1];
+            j--;
+        }
 
-    // write variable
-    _hwa.write(0x82);
+        _vpWrites[j] = write;
+    }
 
-    // icon address - for viewtech displays, address is stored in xPos element
-    _hwa.write(core::util::MSB_U16(icon.xPos));
-    _hwa.write(core::util::LSB_U16(icon.xPos));
+    size_t start = 0;
 
-    // value to set - 2 bytes are used, higher is always 0
-    // inverted logic for setting state - 0 means on state, 1 is off
-    _hwa.write(0x00);
-    _hwa.write(state ? 0x00 : 0x01);
+    for (size_t i = 1; i <= _vpWritesCount; i++)
+    {
+        bool split = (i == _vpWritesCount) ||
+                     (_vpWrites[i].address != (_vpWrites[i - 1].address + 1)) ||
+                     ((i - start) == MAX_FRAME_REGISTERS);
+
+        if (split)
+        {
+            sendVpFrame(&_vpWrites[start], i - start);
+            start = i;
+        }
+    }
+
+    _vpWritesCount = 0;
 }
 
 bool Viewtech::setBrightness(brightness_t brightness)
@@ -253,5 +303,30 @@ void Viewtech::sendBrightness(brightness_t brightness)
     _hwa.write(BRIGHTNESS_MAPPING[static_cast<uint8_t>(brightness)]);
 }
 
+/// Writes values to contiguous block of VP registers in a single frame.
+/// param [in]: writes  Pointer to first write, sorted by address.
+/// param [in]: count   Amount of contiguous registers to write.
+void Viewtech::sendVpFrame(const VpWrite* writes, size_t count)
+{
+    // header
+    _hwa.write(0xA5);
+    _hwa.write(0x5A);
+
+    // request size: command, two address bytes and two bytes per register
+    _hwa.write(3 + (count * 2));
+
+    // write variable
+    _hwa.write(0x82);
+
+    // start address
+    _hwa.write(core::util::MSB_U16(writes[0].address));
+    _hwa.write(core::util::LSB_U16(writes[0].address));
+
+    for (size_t i = 0; i < count; i++)
+    {
+        _hwa.write(core::util::MSB_U16(writes[i].value));
+        _hwa.write(core::util::LSB_U16(writes[i].value));
+    }
+}
 
 #endif
\ No newline at end of file
@@ -33,7 +33,8 @@ namespace io::touchscreen
         bool      deInit() override;
         bool      setScreen(size_t index) override;
         tsEvent_t update(Data& data) override;
-        void      setIconState(Icon& icon, bool state) override;
+        bool      setIconState(Icon& icon, bool state) override;
+        void      flush() override;
         bool      setBrightness(brightness_t brightness) override;
 
         private:
@@ -42,6 +43,19 @@ namespace io::touchscreen
             BUTTON_STATE_CHANGE = 0x05820002
         };
 
+        /// Single pending write to variable pointer (VP) register.
+        struct VpWrite
+        {
+            uint16_t address = 0;
+            uint16_t value   = 0;
+        };
+
+        /// Maximum amount of contiguous VP registers written in a single frame.
+        static constexpr size_t MAX_FRAME_REGISTERS = PROJECT_TARGET_TOUCHSCREEN_MAX_FRAME_REGISTERS;
+
+        // frame length is specified with single byte and includes command and address bytes
+        static_assert((MAX_FRAME_REGISTERS > 0) && ((3 + (MAX_FRAME_REGISTERS * 2)) <= 0xFF), "Invalid maximum amount of registers per frame");
+
         // there are 7 levels of brighness - scale them to available range (0-64)
         static constexpr uint8_t BRIGHTNESS_MAPPING[7] = {
             6,
@@ -61,8 +75,13 @@ namespace io::touchscreen
         bool     _pendingBrightnessValid = false;
         brightness_t _pendingBrightness  = static_cast<brightness_t>(0);
 
+        /// Pending VP register writes, sent on flush.
+        VpWrite _vpWrites[Collection::SIZE()] = {};
+        size_t  _vpWritesCount                = 0;
+
         void maybeFinishPostInit();
         void sendScreen(size_t index);
         void sendBrightness(brightness_t brightness);
+        void sendVpFrame(const VpWrite* writes, size_t count);
     };
 }    // namespace io::touchscreen
@@ -56,24 +56,27 @@ Touchscreen::Touchscreen(Hwa&      hwa,
                               }
                               break;
 
+                              case messaging::systemMessage_t::CONFIG_TRANSACTION_START:
+                              {
+                                  _configTransaction = true;
+                                  _pendingInitAction = common::initAction_t::AS_IS;
+                              }
+                              break;
+
+                              case messaging::systemMessage_t::CONFIG_TRANSACTION_END:
+                              {
+                                  _configTransaction = false;
+                                  applyInitAction(_pendingInitAction);
+                                  _pendingInitAction = common::initAction_t::AS_IS;
+                              }
+                              break;
+
                               default:
                                   break;
                               }
                           });
 
-    ConfigHandler.registerConfig(
-        sys::Config::block_t::TOUCHSCREEN,
-        // read
-        [this](uint8_t section, size_t index, uint16_t& value)
-        {
-            return sysConfigGet(static_cast<sys::Config::Section::touchscreen_t>(section), index, value);
-        },
-
-        // write
-        [this](uint8_t section, size_t index, uint16_t value)
-        {
-            return sysConfigSet(static_cast<sys::Config::Section::touchscreen_t>(section), index, value);
-        });
+    ConfigHandler.registerConfig<&Touchscreen::sysConfigGet, &Touchscreen::sysConfigSet>(sys::Config::block_t::TOUCHSCREEN, this);
 }
 
 Touchscreen::~Touchscreen()
@@ -173,6 +176,8 @@ void Touchscreen::updateAll(bool forceRefresh)
         return;
     }
 
+    flushIconStates();
+
     Data      data  = {};
     tsEvent_t event = ptr->update(data);
 
@@ -217,6 +222,7 @@ void Touchscreen::setScreen(size_t index)
 
     ptr->setScreen(index);
     _activeScreenID = index;
+    markScreenIcons(index);
     screenChangeHandler(index);
 }
 
@@ -227,23 +233,37 @@ size_t Touchscreen::activeScreen()
     return _activeScreenID;
 }
 
+/// Stores new icon state without sending it to display.
+/// Only the final state of each icon is sent once the touchscreen gets updated.
+/// param [in]: index  Index of icon.
+/// param [in]: state  New icon state.
 void Touchscreen::setIconState(size_t index, bool state)
 {
-    if (!isInitialized())
+    if (index >= Collection::SIZE())
     {
         return;
     }
 
-    if (index >= Collection::SIZE())
+    if (_iconState[index] == state)
     {
         return;
     }
 
+    _iconState[index]        = state;
+    _iconStatePending[index] = true;
+}
+
+/// Hands over the icon state to active touchscreen model.
+/// param [in]: index  Index of icon.
+/// param [in]: state  New icon state.
+/// returns: False if the model couldn't accept the state right now and it should be retried, true otherwise.
+bool Touchscreen::sendIconState(size_t index, bool state)
+{
     auto ptr = modelInstance(_activeModel);
 
     if (ptr == nullptr)
     {
-        return;
+        return true;
     }
 
     Icon icon      = {};
@@ -252,12 +272,12 @@ void Touchscreen::setIconState(size_t index, bool state)
 
     if (icon.onScreen == icon.offScreen)
     {
-        return;    // invalid screen indexes
+        return true;    // invalid screen indexes
     }
 
     if ((_activeScreenID != icon.onScreen) && (_activeScreenID != icon.offScreen))
     {
-        return;    // don't allow setting icon on wrong screen
+        return true;    // don't allow setting icon on wrong screen
     }
 
     icon.xPos   = _database.read(database::Config::Section::touchscreen_t::X_POS, index);
@@ -265,7 +285,43 @@ void Touchscreen::setIconState(size_t index, bool state)
     icon.width  = _database.read(database::Config::Section::touchscreen_t::WIDTH, index);
     icon.height = _database.read(database::Config::Section::touchscreen_t::HEIGHT, index);
 
-    ptr->setIconState(icon, state);
+    return ptr->setIconState(icon, state);
+}
+
+/// Sends all pending icon states to display.
+void Touchscreen::flushIconStates()
+{
+    for (size_t i = 0; i < Collection::SIZE(); i++)
+    {
+        if (!_iconStatePending[i])
+        {
+            continue;
+        }
+
+        // keep the state pending if the model rejected it
+        _iconStatePending[i] = !sendIconState(i, _iconState[i]);
+    }
+
+    auto ptr = modelInstance(_activeModel);
+
+    if (ptr != nullptr)
+    {
+        ptr->flush();
+    }
+}
+
+/// Marks all icons placed on specified screen for refresh.
+/// param [in]: screen  Index of screen.
+void Touchscreen::markScreenIcons(size_t screen)
+{
+    for (size_t i = 0; i < Collection::SIZE(); i++)
+    {
+        if ((_database.read(database::Config::Section::touchscreen_t::ON_SCREEN, i) == screen) ||
+            (_database.read(database::Config::Section::touchscreen_t::OFF_SCREEN, i) == screen))
+        {
+            _iconStatePending[i] = true;
+        }
+    }
 }
 
 void Touchscreen::processButton(const size_t buttonIndex, const bool state)
@@ -433,13 +489,14 @@ std::optional<uint8_t> Touchscreen::sysConfigSet(sys::Config::Section::touchscre
 
     if (result)
     {
-        if (initAction == common::initAction_t::INIT)
+        if (!_configTransaction)
         {
-            init();
+            applyInitAction(initAction);
         }
-        else if (initAction == common::initAction_t::DE_INIT)
+        else if (initAction != common::initAction_t::AS_IS)
         {
-            deInit();
+            // reinit once on commit with the most recent request
+            _pendingInitAction = initAction;
         }
 
         return sys::Config::Status::ACK;
@@ -448,4 +505,16 @@ std::optional<uint8_t> Touchscreen::sysConfigSet(sys::Config::Section::touchscre
     return sys::Config::Status::ERROR_WRITE;
 }
 
+void Touchscreen::applyInitAction(common::initAction_t initAction)
+{
+    if (initAction == common::initAction_t::INIT)
+    {
+        init();
+    }
+    else if (initAction == common::initAction_t::DE_INIT)
+    {
+        deInit();
+    }
+}
+
 #endif
\ No newline at end of file
@@ -44,17 +44,29 @@ namespace io::touchscreen
         private:
         Hwa&                                                            _hwa;
         Database&                                                       _database;
-        size_t                                                          _activeScreenID = 0;
-        bool                                                            _initialized    = false;
-        model_t                                                         _activeModel    = model_t::AMOUNT;
+        size_t                                                          _activeScreenID    = 0;
+        bool                                                            _initialized       = false;
+        bool                                                            _configTransaction = false;
+        common::initAction_t                                            _pendingInitAction = common::initAction_t::AS_IS;
+        model_t                                                         _activeModel       = model_t::AMOUNT;
         static std::array<Model*, static_cast<size_t>(model_t::AMOUNT)> _models;
 
+        /// Latest requested state for each icon.
+        bool _iconState[Collection::SIZE()] = {};
+
+        /// Icons whose state needs to be sent to display on next update.
+        bool _iconStatePending[Collection::SIZE()] = {};
+
         bool                   deInit();
+        void                   applyInitAction(common::initAction_t initAction);
         Model*                 modelInstance(model_t model);
         bool                   isInitialized() const;
         void                   setScreen(size_t index);
         size_t                 activeScreen();
         void                   setIconState(size_t index, bool state);
+        bool                   sendIconState(size_t index, bool state);
+        void                   flushIconStates();
+        void                   markScreenIcons(size_t screen);
         bool                   setBrightness(brightness_t brightness);
         void                   processButton(const size_t buttonIndex, const bool state);
         void                   buttonHandler(size_t index, bool state);
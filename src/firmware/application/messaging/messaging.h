@@ -42,7 +42,6 @@ namespace messaging
     enum class systemMessage_t : uint8_t
     {
         FORCE_IO_REFRESH,
-        SYS_EX_RESPONSE,
         MIDI_PROGRAM_OFFSET_CHANGE,
         PRESET_CHANGE_INC_REQ,
         PRESET_CHANGE_DEC_REQ,
@@ -54,20 +53,36 @@ namespace messaging
         FACTORY_RESET_START,
         FACTORY_RESET_END,
         MIDI_BPM_CHANGE,
+        CONFIG_TRANSACTION_START,
+        CONFIG_TRANSACTION_END,
+        TRAFFIC_ACTIVE,
+        TRAFFIC_IDLE,
     };
 
+    /// Event used for channel voice and system traffic between the components.
+    /// Passed by value into descriptors and listeners all over the IO modules, so it's kept small:
+    /// SysEx payload is delivered separately, see SysExView.
     struct Event
     {
-        size_t                   componentIndex = 0;
-        uint8_t                  channel        = 0;
+        uint16_t                 componentIndex = 0;
         uint16_t                 index          = 0;
         uint16_t                 value          = 0;
-        uint8_t*                 sysEx          = nullptr;
-        size_t                   sysExLength    = 0;
+        uint8_t                  channel        = 0;
         bool                     forcedRefresh  = false;
         lib::midi::messageType_t message        = lib::midi::messageType_t::INVALID;
         systemMessage_t          systemMessage  = systemMessage_t::FORCE_IO_REFRESH;
     };
+
+    static_assert(sizeof(Event) <= 12, "Event should stay compact");
+
+    /// Non-owning view of a complete SysEx message, including the start and end bytes.
+    /// Data is valid only while the listener is being called.
+    struct SysExView
+    {
+        uint8_t* data   = nullptr;
+        uint16_t length = 0;
+    };
 }    // namespace messaging
 
-#define MidiDispatcher util::Dispatcher<messaging::eventType_t, messaging::Event>::instance()
\ No newline at end of file
+#define MidiDispatcher  util::Dispatcher<messaging::eventType_t, messaging::Event>::instance()
+#define SysExDispatcher util::Dispatcher<messaging::eventType_t, messaging::SysExView>::instance()
\ No newline at end of file
@@ -24,6 +24,7 @@ limitations under the License.
 #include "application/util/logger/logger.h"
 #include "application/global/midi_program.h"
 #include "application/global/bpm.h"
+#include "application/global/midi_clock.h"
 
 #include "core/mcu.h"
 
@@ -72,25 +73,30 @@ Midi::Midi(HwaUsb&    hwaUSB,
                           {
                               switch (event.systemMessage)
                               {
-                              case messaging::systemMessage_t::SYS_EX_RESPONSE:
+                              case messaging::systemMessage_t::PRESET_CHANGED:
                               {
-                                  send(messaging::eventType_t::SYSTEM, event);
+                                  init();
                               }
                               break;
 
-                              case messaging::systemMessage_t::PRESET_CHANGED:
+                              case messaging::systemMessage_t::MIDI_BPM_CHANGE:
                               {
-                                  init();
+                                  updateClockOutput(true);
                               }
                               break;
 
-                              case messaging::systemMessage_t::MIDI_BPM_CHANGE:
+                              case messaging::systemMessage_t::CONFIG_TRANSACTION_START:
+                              {
+                                  _configTransaction = true;
+                                  _pendingInit       = {};
+                              }
+                              break;
+
+                              case messaging::systemMessage_t::CONFIG_TRANSACTION_END:
                               {
-                                  if (isSettingEnabled(setting_t::DIN_ENABLED) && isSettingEnabled(setting_t::SEND_MIDI_CLOCK_DIN) && _clockTimerAllocated)
-                                  {
-                                      core::mcu::timers::setPeriod(_clockTimerIndex, Bpm.bpmToUsec(Bpm.value()));
-                                      core::mcu::timers::start(_clockTimerIndex);
-                                  }
+                                  _configTransaction = false;
+                                  applyInit(_pendingInit);
+                                  _pendingInit = {};
                               }
                               break;
 
@@ -99,19 +105,21 @@ Midi::Midi(HwaUsb&    hwaUSB,
                               }
                           });
 
-    ConfigHandler.registerConfig(
-        sys::Config::block_t::GLOBAL,
-        // read
-        [this](uint8_t section, size_t index, uint16_t& value)
-        {
-            return sysConfigGet(static_cast<sys::Config::Section::global_t>(section), index, value);
-        },
-
-        // write
-        [this](uint8_t section, size_t index, uint16_t value)
-        {
-            return sysConfigSet(static_cast<sys::Config::Section::global_t>(section), index, value);
-        });
+    SysExDispatcher.listen(messaging::eventType_t::BUTTON,
+                           [this](const messaging::SysExView& sysEx)
+                           {
+                               sendSysEx(messaging::eventType_t::BUTTON, sysEx);
+                           });
+
+    SysExDispatcher.listen(messaging::eventType_t::SYSTEM,
+                           [this](const messaging::SysExView& sysEx)
+                           {
+                               sendSysEx(messaging::eventType_t::SYSTEM, sysEx);
+                           });
+
+    ConfigHandler.registerConfig<&Midi::sysConfigGet, &Midi::sysConfigSet>(sys::Config::block_t::GLOBAL,
+                                                                           this,
+                                                                           { sys::Config::Section::global_t::MIDI_SETTINGS });
 }
 
 bool Midi::init()
@@ -141,6 +149,11 @@ bool Midi::init()
 
 bool Midi::deInit()
 {
+    _queue.reset();
+    _realtimeQueue.reset();
+    _queued.fill(0);
+    _queuedRealtime.fill(0);
+
     if (!_serial.deInit())
     {
         return false;
@@ -193,7 +206,8 @@ bool Midi::setupSerial()
         {
             _clockTimerAllocated = true;
 
-            core::mcu::timers::setPeriod(_clockTimerIndex, Bpm.bpmToUsec(Bpm.value()));
+            _clockPeriodUs = Bpm.bpmToUsec(Bpm.value());
+            core::mcu::timers::setPeriod(_clockTimerIndex, _clockPeriodUs);
 
             if (isSettingEnabled(setting_t::SEND_MIDI_CLOCK_DIN))
             {
@@ -223,14 +237,9 @@ bool Midi::setupBle()
 
 bool Midi::setupThru()
 {
-    if (isSettingEnabled(setting_t::DIN_THRU_DIN))
-    {
-        _serial.registerThruInterface(_serial.transport());
-    }
-    else
-    {
-        _serial.unregisterThruInterface(_serial.transport());
-    }
+    // DIN to DIN, USB to USB and USB to DIN thru is handled on the transport level
+    // without going through the parser: see RawThru
+    setupRawThru();
 
     if (isSettingEnabled(setting_t::DIN_THRU_USB))
     {
@@ -250,24 +259,6 @@ bool Midi::setupThru()
         _serial.unregisterThruInterface(_ble.transport());
     }
 
-    if (isSettingEnabled(setting_t::USB_THRU_DIN))
-    {
-        _usb.registerThruInterface(_serial.transport());
-    }
-    else
-    {
-        _usb.unregisterThruInterface(_serial.transport());
-    }
-
-    if (isSettingEnabled(setting_t::USB_THRU_USB))
-    {
-        _usb.registerThruInterface(_usb.transport());
-    }
-    else
-    {
-        _usb.unregisterThruInterface(_usb.transport());
-    }
-
     if (isSettingEnabled(setting_t::USB_THRU_BLE))
     {
         _usb.registerThruInterface(_ble.transport());
@@ -307,7 +298,53 @@ bool Midi::setupThru()
     return true;
 }
 
+void Midi::setupRawThru()
+{
+    const bool DIN_ENABLED = isSettingEnabled(setting_t::DIN_ENABLED);
+
+    _rawThru.setRoute(RawThru::route_t::DIN_TO_DIN, DIN_ENABLED && isSettingEnabled(setting_t::DIN_THRU_DIN));
+    _rawThru.setRoute(RawThru::route_t::USB_TO_DIN, DIN_ENABLED && isSettingEnabled(setting_t::USB_THRU_DIN));
+    _rawThru.setRoute(RawThru::route_t::USB_TO_USB, isSettingEnabled(setting_t::USB_THRU_USB));
+}
+
 void Midi::read()
+{
+    fillQueues();
+
+    QueuedMessage message;
+
+    // realtime messages are time-critical and cheap to process: always handle all of them first
+    while (dequeue(true, message))
+    {
+        process(message);
+    }
+
+    // the rest is processed with both message and time budget so that the large
+    // incoming dumps don't stall the input scanning
+    auto start = core::mcu::timing::ms();
+
+    for (size_t i = 0; i < MAX_MESSAGES_PER_READ; i++)
+    {
+        if (!dequeue(false, message))
+        {
+            break;
+        }
+
+        process(message);
+
+        if ((core::mcu::timing::ms() - start) >= MAX_READ_TIME_MS)
+        {
+            break;
+        }
+    }
+}
+
+bool Midi::pending()
+{
+    return _queue.size() || _realtimeQueue.size();
+}
+
+void Midi::fillQueues()
 {
     for (size_t i = 0; i < _midiInterface.size(); i++)
     {
@@ -318,48 +355,191 @@ void Midi::read()
             continue;
         }
 
-        while (interfaceInstance->read())
+        // Message type is known only once it's read so make sure there is space in both queues.
+        // Each interface is limited to its own share of the queues so that the flooded one
+        // leaves space for the rest.
+        while ((_queued[i] < MAX_QUEUED_MESSAGES_PER_INTERFACE) && (_queuedRealtime[i] < MAX_QUEUED_REALTIME_MESSAGES_PER_INTERFACE))
         {
+            if (!interfaceInstance->read())
+            {
+                break;
+            }
+
             LOG_INF("Received MIDI message on interface index %d", static_cast<int>(i));
 
-            messaging::Event event = {};
-            event.componentIndex   = 0;
-            event.channel          = interfaceInstance->channel();
-            event.index            = interfaceInstance->data1();
-            event.value            = interfaceInstance->data2();
-            event.message          = interfaceInstance->type();
+            QueuedMessage message = {};
+            message.interface     = i;
+            message.type          = interfaceInstance->type();
+            message.channel       = interfaceInstance->channel();
+            message.data1         = interfaceInstance->data1();
+            message.data2         = interfaceInstance->data2();
 
-            switch (event.message)
-            {
-            case messageType_t::SYS_EX:
+            if (message.type == messageType_t::SYS_EX)
             {
-                // process sysex messages only from usb interface
+                // SysEx data is held in the interface buffer which is overwritten on the next read:
+                // process it right away and move on to the next interface.
+                // Messages read before it are processed first so that the order is kept.
+                processQueued();
+
                 if (i == INTERFACE_USB)
                 {
-                    event.sysEx       = interfaceInstance->sysExArray();
-                    event.sysExLength = interfaceInstance->length();
+                    process(message, interfaceInstance->sysExArray(), interfaceInstance->length());
+                }
+                else
+                {
+                    process(message);
                 }
+
+                break;
             }
-            break;
 
-            case messageType_t::PROGRAM_CHANGE:
+            if (isRealtime(message.type))
             {
-                MidiProgram.setProgram(event.channel, event.index);
+                _realtimeQueue.insert(message);
+                _queuedRealtime[i]++;
             }
-            break;
-
-            case messageType_t::NOTE_OFF:
+            else
             {
-                event.value = 0;
+                _queue.insert(message);
+                _queued[i]++;
             }
-            break;
+        }
+    }
+}
 
-            default:
-                break;
-            }
+bool Midi::dequeue(bool realtime, QueuedMessage& message)
+{
+    if (realtime)
+    {
+        if (!_realtimeQueue.remove(message))
+        {
+            return false;
+        }
 
-            MidiDispatcher.notify(messaging::eventType_t::MIDI_IN, event);
+        _queuedRealtime[message.interface]--;
+    }
+    else
+    {
+        if (!_queue.remove(message))
+        {
+            return false;
         }
+
+        _queued[message.interface]--;
+    }
+
+    return true;
+}
+
+void Midi::processQueued()
+{
+    QueuedMessage message;
+
+    while (dequeue(true, message))
+    {
+        process(message);
+    }
+
+    while (dequeue(false, message))
+    {
+        process(message);
+    }
+}
+
+void Midi::process(const QueuedMessage& message, uint8_t* sysEx, size_t sysExLength)
+{
+    if (message.type == messageType_t::SYS_EX)
+    {
+        messaging::SysExView view = {};
+        view.data                 = sysEx;
+        view.length               = sysExLength;
+
+        SysExDispatcher.notify(messaging::eventType_t::MIDI_IN, view);
+        return;
+    }
+
+    messaging::Event event = {};
+    event.componentIndex   = 0;
+    event.channel          = message.channel;
+    event.index            = message.data1;
+    event.value            = message.data2;
+    event.message          = message.type;
+
+    switch (event.message)
+    {
+    case messageType_t::PROGRAM_CHANGE:
+    {
+        MidiProgram.setProgram(event.channel, event.index);
+    }
+    break;
+
+    case messageType_t::NOTE_OFF:
+    {
+        event.value = 0;
+    }
+    break;
+
+    case messageType_t::SYS_REAL_TIME_CLOCK:
+    {
+        MidiClock.pulse(core::mcu::timing::ms());
+
+        if (MidiClock.locked())
+        {
+            Bpm.follow(MidiClock.bpmX10());
+            updateClockOutput(false);
+        }
+    }
+    break;
+
+    case messageType_t::SYS_REAL_TIME_START:
+    {
+        MidiClock.start();
+    }
+    break;
+
+    default:
+        break;
+    }
+
+    MidiDispatcher.notify(messaging::eventType_t::MIDI_IN, event);
+}
+
+void Midi::updateClockOutput(bool force)
+{
+    // timer is started and stopped along with DIN clock output: only its period is updated here
+    if (!_clockTimerAllocated)
+    {
+        return;
+    }
+
+    // follow the smoothed incoming clock once it's tracked, otherwise use internally set tempo
+    uint32_t period     = MidiClock.locked() ? MidiClock.periodUs() : Bpm.bpmToUsec(Bpm.value());
+    uint32_t difference = period > _clockPeriodUs ? period - _clockPeriodUs : _clockPeriodUs - period;
+
+    // ignore period changes smaller than ~0.4% to avoid constant timer updates
+    if (!force && (difference < (period >> 8)))
+    {
+        return;
+    }
+
+    _clockPeriodUs = period;
+    core::mcu::timers::setPeriod(_clockTimerIndex, period);
+}
+
+bool Midi::isRealtime(messageType_t type)
+{
+    switch (type)
+    {
+    case messageType_t::SYS_REAL_TIME_CLOCK:
+    case messageType_t::SYS_REAL_TIME_START:
+    case messageType_t::SYS_REAL_TIME_CONTINUE:
+    case messageType_t::SYS_REAL_TIME_STOP:
+    case messageType_t::SYS_REAL_TIME_ACTIVE_SENSING:
+    case messageType_t::SYS_REAL_TIME_SYSTEM_RESET:
+        return true;
+
+    default:
+        return false;
     }
 }
 
@@ -632,24 +812,30 @@ void Midi::send(messaging::eventType_t source, const messaging::Event& event)
         }
         break;
 
-        case messageType_t::SYS_EX:
-        {
-            if (source == messaging::eventType_t::SYSTEM)
-            {
-                if (i != INTERFACE_USB)
-                {
-                    // send internal sysex messages on USB interface only
-                    break;
-                }
-            }
+        default:
+            break;
+        }
+    }
+}
+
+void Midi::sendSysEx(messaging::eventType_t source, const messaging::SysExView& sysEx)
+{
+    for (size_t i = 0; i < _midiInterface.size(); i++)
+    {
+        auto interfaceInstance = _midiInterface[i];
 
-            interfaceInstance->sendSysEx(event.sysExLength, event.sysEx, true);
+        if (!interfaceInstance->initialized())
+        {
+            continue;
         }
-        break;
 
-        default:
-            break;
+        if ((source == messaging::eventType_t::SYSTEM) && (i != INTERFACE_USB))
+        {
+            // send internal sysex messages on USB interface only
+            continue;
         }
+
+        interfaceInstance->sendSysEx(sysEx.length, sysEx.data, true);
     }
 }
 
@@ -888,15 +1074,6 @@ std::optional<uint8_t> Midi::sysConfigSet(sys::Config::Section::global_t section
     {
         if (_hwaSerial.supported())
         {
-            if (value)
-            {
-                _serial.registerThruInterface(_serial.transport());
-            }
-            else
-            {
-                _serial.unregisterThruInterface(_serial.transport());
-            }
-
             result           = sys::Config::Status::ACK;
             checkDINLoopback = true;
         }
@@ -971,15 +1148,6 @@ std::optional<uint8_t> Midi::sysConfigSet(sys::Config::Section::global_t section
     {
         if (_hwaSerial.supported())
         {
-            if (value)
-            {
-                _usb.registerThruInterface(_serial.transport());
-            }
-            else
-            {
-                _usb.unregisterThruInterface(_serial.transport());
-            }
-
             result = sys::Config::Status::ACK;
         }
         else
@@ -991,15 +1159,6 @@ std::optional<uint8_t> Midi::sysConfigSet(sys::Config::Section::global_t section
 
     case setting_t::USB_THRU_USB:
     {
-        if (value)
-        {
-            _usb.registerThruInterface(_usb.transport());
-        }
-        else
-        {
-            _usb.unregisterThruInterface(_usb.transport());
-        }
-
         result = sys::Config::Status::ACK;
     }
     break;
@@ -1146,55 +1305,94 @@ std::optional<uint8_t> Midi::sysConfigSet(sys::Config::Section::global_t section
                      ? sys::Config::Status::ACK
                      : sys::Config::Status::ERROR_WRITE;
 
-        switch (dinMIDIinitAction)
-        {
-        case io::common::initAction_t::INIT:
-        {
-            _serial.init();
+        // raw thru routes are derived from the stored settings
+        setupRawThru();
+    }
+    else
+    {
+        // interfaces are reinitialized only once the new value is stored
+        dinMIDIinitAction = io::common::initAction_t::AS_IS;
+        bleMIDIinitAction = io::common::initAction_t::AS_IS;
+    }
 
-            if (isSettingEnabled(setting_t::SEND_MIDI_CLOCK_DIN) && _clockTimerAllocated)
-            {
-                core::mcu::timers::start(_clockTimerIndex);
-            }
-        }
-        break;
+    PendingInit pendingInit      = {};
+    pendingInit.din              = dinMIDIinitAction;
+    pendingInit.ble              = bleMIDIinitAction;
+    pendingInit.checkDinLoopback = (result == sys::Config::Status::ACK) && checkDINLoopback;
 
-        case io::common::initAction_t::DE_INIT:
+    if (_configTransaction)
+    {
+        // the last requested action wins: it reflects the most recently stored value
+        if (pendingInit.din != io::common::initAction_t::AS_IS)
         {
-            if (isSettingEnabled(setting_t::SEND_MIDI_CLOCK_DIN) && _clockTimerAllocated)
-            {
-                core::mcu::timers::stop(_clockTimerIndex);
-            }
-
-            _serial.deInit();
+            _pendingInit.din = pendingInit.din;
         }
-        break;
 
-        default:
-            break;
+        if (pendingInit.ble != io::common::initAction_t::AS_IS)
+        {
+            _pendingInit.ble = pendingInit.ble;
         }
 
-        switch (bleMIDIinitAction)
-        {
-        case io::common::initAction_t::INIT:
+        _pendingInit.checkDinLoopback |= pendingInit.checkDinLoopback;
+    }
+    else
+    {
+        applyInit(pendingInit);
+    }
+
+    return result;
+}
+
+void Midi::applyInit(const PendingInit& pendingInit)
+{
+    switch (pendingInit.din)
+    {
+    case io::common::initAction_t::INIT:
+    {
+        _serial.init();
+
+        if (isSettingEnabled(setting_t::SEND_MIDI_CLOCK_DIN) && _clockTimerAllocated)
         {
-            _ble.init();
+            core::mcu::timers::start(_clockTimerIndex);
         }
-        break;
+    }
+    break;
 
-        case io::common::initAction_t::DE_INIT:
+    case io::common::initAction_t::DE_INIT:
+    {
+        if (isSettingEnabled(setting_t::SEND_MIDI_CLOCK_DIN) && _clockTimerAllocated)
         {
-            _ble.deInit();
+            core::mcu::timers::stop(_clockTimerIndex);
         }
+
+        _serial.deInit();
+    }
+    break;
+
+    default:
         break;
+    }
 
-        default:
-            break;
-        }
+    switch (pendingInit.ble)
+    {
+    case io::common::initAction_t::INIT:
+    {
+        _ble.init();
+    }
+    break;
+
+    case io::common::initAction_t::DE_INIT:
+    {
+        _ble.deInit();
+    }
+    break;
+
+    default:
+        break;
     }
 
     // no need to check this if init/deinit has been already called for DIN
-    if (result && checkDINLoopback && dinMIDIinitAction == io::common::initAction_t::AS_IS)
+    if (pendingInit.checkDinLoopback && (pendingInit.din == io::common::initAction_t::AS_IS))
     {
         // Special consideration for DIN MIDI:
         // To make DIN to DIN thruing as fast as possible,
@@ -1207,6 +1405,4 @@ std::optional<uint8_t> Midi::sysConfigSet(sys::Config::Section::global_t section
         // HWA interface.
         _hwaSerial.setLoopback(isDinLoopbackRequired());
     }
-
-    return result;
 }
\ No newline at end of file
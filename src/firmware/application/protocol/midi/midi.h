@@ -19,6 +19,7 @@ limitations under the License.
 #pragma once
 
 #include "deps.h"
+#include "thru.h"
 #include "application/io/common/common.h"
 #include "application/protocol/base.h"
 #include "application/database/database.h"
@@ -30,6 +31,8 @@ limitations under the License.
 #include "lib/midi/transport/serial/serial.h"
 #include "lib/midi/transport/ble/ble.h"
 
+#include "core/util/ring_buffer.h"
+
 #include <optional>
 
 namespace protocol::midi
@@ -46,7 +49,9 @@ namespace protocol::midi
         bool deInit() override;
         void read() override;
 
-        private:
+        /// Returns true if there are received messages which haven't been processed yet.
+        bool pending();
+
         enum interface_t
         {
             INTERFACE_USB,
@@ -55,26 +60,86 @@ namespace protocol::midi
             INTERFACE_AMOUNT
         };
 
+        /// Amount of received messages which can be read ahead from the interfaces.
+        /// Interfaces aren't read once the queue is full - the rest of the data stays in their buffers.
+        static constexpr size_t MAX_QUEUED_MESSAGES = 16;
+
+        /// Amount of realtime messages (clock, start, stop...) which can be read ahead.
+        /// These are always processed before any other queued message.
+        static constexpr size_t MAX_QUEUED_REALTIME_MESSAGES = 8;
+
+        /// Amount of queued messages which single interface can hold at once.
+        /// Queues are split between the interfaces so that flooded interface can't starve the others.
+        /// Ring buffer holds one entry less than its size.
+        static constexpr size_t MAX_QUEUED_MESSAGES_PER_INTERFACE          = (MAX_QUEUED_MESSAGES - 1) / INTERFACE_AMOUNT;
+        static constexpr size_t MAX_QUEUED_REALTIME_MESSAGES_PER_INTERFACE = (MAX_QUEUED_REALTIME_MESSAGES - 1) / INTERFACE_AMOUNT;
+
+        /// Maximum amount of queued (non-realtime) messages processed in single read() call.
+        /// Exception is received SysEx message: all the messages queued before it are processed first.
+        static constexpr size_t MAX_MESSAGES_PER_READ = 8;
+
+        /// Maximum time in milliseconds spent processing queued messages in single read() call.
+        /// At least one message is always processed.
+        static constexpr uint32_t MAX_READ_TIME_MS = 1;
+
+        private:
+        /// Single received message waiting to be processed.
+        struct QueuedMessage
+        {
+            uint8_t       interface = 0;
+            messageType_t type      = messageType_t::INVALID;
+            uint8_t       channel   = 0;
+            uint16_t      data1     = 0;
+            uint16_t      data2     = 0;
+        };
+
+        /// Interface reinitialization requested by configuration changes.
+        /// Within configuration transaction these are merged and applied once on commit.
+        struct PendingInit
+        {
+            io::common::initAction_t din              = io::common::initAction_t::AS_IS;
+            io::common::initAction_t ble              = io::common::initAction_t::AS_IS;
+            bool                     checkDinLoopback = false;
+        };
+
         HwaUsb&                                        _hwaUsb;
         HwaSerial&                                     _hwaSerial;
         HwaBle&                                        _hwaBle;
-        lib::midi::usb::Usb                            _usb    = lib::midi::usb::Usb(_hwaUsb);
-        lib::midi::serial::Serial                      _serial = lib::midi::serial::Serial(_hwaSerial);
-        lib::midi::ble::Ble                            _ble    = lib::midi::ble::Ble(_hwaBle);
+        RawThru                                        _rawThru = RawThru(_hwaUsb, _hwaSerial);
+        lib::midi::usb::Usb                            _usb     = lib::midi::usb::Usb(_rawThru.usb());
+        lib::midi::serial::Serial                      _serial  = lib::midi::serial::Serial(_rawThru.serial());
+        lib::midi::ble::Ble                            _ble     = lib::midi::ble::Ble(_hwaBle);
         Database&                                      _database;
         std::array<lib::midi::Base*, INTERFACE_AMOUNT> _midiInterface;
         bool                                           _clockTimerAllocated = false;
         size_t                                         _clockTimerIndex     = 0;
+        uint32_t                                       _clockPeriodUs       = 0;
+        bool                                           _configTransaction   = false;
+        PendingInit                                    _pendingInit         = {};
+
+        core::util::RingBuffer<QueuedMessage, MAX_QUEUED_MESSAGES>          _queue;
+        core::util::RingBuffer<QueuedMessage, MAX_QUEUED_REALTIME_MESSAGES> _realtimeQueue;
+        std::array<uint8_t, INTERFACE_AMOUNT>                               _queued         = {};
+        std::array<uint8_t, INTERFACE_AMOUNT>                               _queuedRealtime = {};
 
+        void                   fillQueues();
+        bool                   dequeue(bool realtime, QueuedMessage& message);
+        void                   processQueued();
+        void                   process(const QueuedMessage& message, uint8_t* sysEx = nullptr, size_t sysExLength = 0);
+        bool                   isRealtime(messageType_t type);
+        void                   updateClockOutput(bool force);
         bool                   isSettingEnabled(setting_t feature);
         bool                   isDinLoopbackRequired();
         std::optional<uint8_t> sysConfigGet(sys::Config::Section::global_t section, size_t index, uint16_t& value);
         std::optional<uint8_t> sysConfigSet(sys::Config::Section::global_t section, size_t index, uint16_t value);
         void                   send(messaging::eventType_t source, const messaging::Event& event);
+        void                   sendSysEx(messaging::eventType_t source, const messaging::SysExView& sysEx);
         void                   setNoteOffMode(noteOffType_t type);
         bool                   setupUsb();
         bool                   setupSerial();
         bool                   setupBle();
         bool                   setupThru();
+        void                   setupRawThru();
+        void                   applyInit(const PendingInit& pendingInit);
     };
 }    // namespace protocol::midi
\ No newline at end of file
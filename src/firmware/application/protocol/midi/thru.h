@@ -0,0 +1,549 @@
+/*
+
+Copyright Igor Petrovic
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#pragma once
+
+#include "deps.h"
+
+#include <array>
+
+namespace protocol::midi
+{
+    /// Transport-level thru fast path.
+    /// Sits between MIDI transports and their hardware interfaces: every received USB packet
+    /// or serial byte is copied to enabled outputs straight from the receive side, before being
+    /// handed over to the parser. This avoids parsing and re-serializing the thru data for routes
+    /// which share compatible framing.
+    /// USB packets always carry complete messages (or complete SysEx chunks) and are copied as is.
+    /// Serial output is shared between the application and the thru data arriving one byte at a time,
+    /// so all serial output is framed first: see SerialTap.
+    class RawThru
+    {
+        public:
+        enum class route_t : uint8_t
+        {
+            DIN_TO_DIN,
+            USB_TO_USB,
+            USB_TO_DIN,
+            AMOUNT
+        };
+
+        /// Amount of serial bytes which can be held back while the serial output is busy with SysEx message.
+        static constexpr size_t SERIAL_HOLD_BUFFER_SIZE = 64;
+
+        RawThru(HwaUsb& hwaUsb, HwaSerial& hwaSerial)
+            : _usbTap(*this, hwaUsb)
+            , _serialTap(*this, hwaSerial)
+        {}
+
+        void setRoute(route_t route, bool state)
+        {
+            _routes[static_cast<uint8_t>(route)] = state;
+
+            if (state)
+            {
+                return;
+            }
+
+            switch (route)
+            {
+            case route_t::DIN_TO_DIN:
+            {
+                _serialTap.reset(source_t::DIN);
+            }
+            break;
+
+            case route_t::USB_TO_DIN:
+            {
+                _serialTap.reset(source_t::USB);
+            }
+            break;
+
+            default:
+                break;
+            }
+        }
+
+        bool route(route_t route)
+        {
+            return _routes[static_cast<uint8_t>(route)];
+        }
+
+        /// Returns hardware interface to be used by the USB MIDI transport.
+        lib::midi::usb::Hwa& usb()
+        {
+            return _usbTap;
+        }
+
+        /// Returns hardware interface to be used by the serial MIDI transport.
+        lib::midi::serial::Hwa& serial()
+        {
+            return _serialTap;
+        }
+
+        /// Returns the amount of MIDI bytes carried in USB packet based on its code index number.
+        static size_t usbPacketSize(const UsbPacket& packet)
+        {
+            static constexpr uint8_t CIN_SIZE[16] = {
+                0,    // misc, reserved
+                0,    // cable events, reserved
+                2,    // two-byte system common
+                3,    // three-byte system common
+                3,    // sysex start or continue
+                1,    // single-byte system common or sysex end
+                2,    // sysex end with two bytes
+                3,    // sysex end with three bytes
+                3,    // note off
+                3,    // note on
+                3,    // poly aftertouch
+                3,    // control change
+                2,    // program change
+                2,    // channel aftertouch
+                3,    // pitch bend
+                1,    // single byte
+            };
+
+            return CIN_SIZE[packet.data[USB_EVENT] & 0x0F];
+        }
+
+        private:
+        /// Sources of the serial output data.
+        enum class source_t : uint8_t
+        {
+            APP,
+            DIN,
+            USB,
+            AMOUNT,
+            NONE = AMOUNT,
+        };
+
+        /// Splits MIDI byte stream into complete messages.
+        /// Running status is expanded: message() always starts with the status byte.
+        class Framer
+        {
+            public:
+            enum class result_t : uint8_t
+            {
+                INCOMPLETE,    ///< Nothing to send yet, or a stray byte which doesn't belong to any message.
+                MESSAGE,       ///< Message is complete, see message() and size().
+                REALTIME,      ///< Single-byte realtime message which can be sent in between bytes of any other message.
+                SYSEX,         ///< Byte is part of SysEx message, including the start and end bytes.
+            };
+
+            result_t feed(uint8_t data)
+            {
+                if (data >= 0xF8)
+                {
+                    return result_t::REALTIME;
+                }
+
+                if (data < 0x80)
+                {
+                    if (_sysEx)
+                    {
+                        return result_t::SYSEX;
+                    }
+
+                    if (_size == _expected)
+                    {
+                        if (!_runningStatus)
+                        {
+                            return result_t::INCOMPLETE;
+                        }
+
+                        _message[0]     = _runningStatus;
+                        _size           = 1;
+                        _expected       = length(_runningStatus);
+                        _explicitStatus = false;
+                    }
+
+                    _message[_size++] = data;
+                    return _size == _expected ? result_t::MESSAGE : result_t::INCOMPLETE;
+                }
+
+                // any status byte ends SysEx message
+                const bool SYS_EX_END = _sysEx;
+
+                _sysEx    = false;
+                _size     = 0;
+                _expected = 0;
+
+                if (data == 0xF7)
+                {
+                    return SYS_EX_END ? result_t::SYSEX : result_t::INCOMPLETE;
+                }
+
+                // system common messages cancel the running status
+                _runningStatus = data < 0xF0 ? data : 0;
+
+                if (data == 0xF0)
+                {
+                    _sysEx = true;
+                    return result_t::SYSEX;
+                }
+
+                _message[0]     = data;
+                _size           = 1;
+                _expected       = length(data);
+                _explicitStatus = true;
+
+                return _size == _expected ? result_t::MESSAGE : result_t::INCOMPLETE;
+            }
+
+            const uint8_t* message() const
+            {
+                return _message;
+            }
+
+            size_t size() const
+            {
+                return _size;
+            }
+
+            /// returns: False if the status byte of the last message was left out by the source.
+            bool explicitStatus() const
+            {
+                return _explicitStatus;
+            }
+
+            bool sysEx() const
+            {
+                return _sysEx;
+            }
+
+            private:
+            uint8_t _message[3]     = {};
+            uint8_t _size           = 0;
+            uint8_t _expected       = 0;
+            uint8_t _runningStatus  = 0;
+            bool    _sysEx          = false;
+            bool    _explicitStatus = true;
+
+            static uint8_t length(uint8_t status)
+            {
+                switch (status & 0xF0)
+                {
+                case 0xC0:
+                case 0xD0:
+                    return 2;
+
+                case 0xF0:
+                {
+                    switch (status)
+                    {
+                    case 0xF1:
+                    case 0xF3:
+                        return 2;
+
+                    case 0xF2:
+                        return 3;
+
+                    default:
+                        return 1;
+                    }
+                }
+
+                default:
+                    return 3;
+                }
+            }
+        };
+
+        class UsbTap : public lib::midi::usb::Hwa
+        {
+            public:
+            UsbTap(RawThru& thru, HwaUsb& hwa)
+                : _thru(thru)
+                , _hwa(hwa)
+            {}
+
+            bool init() override
+            {
+                return _hwa.init();
+            }
+
+            bool deInit() override
+            {
+                return _hwa.deInit();
+            }
+
+            bool read(UsbPacket& packet) override
+            {
+                if (!_hwa.read(packet))
+                {
+                    return false;
+                }
+
+                if (_thru.route(route_t::USB_TO_USB))
+                {
+                    // packet is written as received: cable number and code index number are kept
+                    UsbPacket out = packet;
+                    _hwa.write(out);
+                }
+
+                if (_thru.route(route_t::USB_TO_DIN))
+                {
+                    auto size = usbPacketSize(packet);
+
+                    for (size_t i = 0; i < size; i++)
+                    {
+                        _thru._serialTap.forward(source_t::USB, packet.data[USB_DATA1 + i]);
+                    }
+                }
+
+                return true;
+            }
+
+            bool write(UsbPacket& packet) override
+            {
+                return _hwa.write(packet);
+            }
+
+            private:
+            RawThru& _thru;
+            HwaUsb&  _hwa;
+        };
+
+        /// Serial output shared by the application (serial MIDI transport), DIN to DIN and USB to DIN thru.
+        /// Bytes from each source are written out only once they form a complete message, so that messages
+        /// from different sources never end up interleaved. Status byte left out by the source (running status)
+        /// is written anyway if the last status byte on the output came from another message.
+        /// SysEx is written as it arrives: output is owned by the source which has sent SysEx start until the
+        /// message ends, and complete messages from other sources are held back until then. SysEx from other
+        /// thru source is dropped in the meantime. If the application data doesn't fit in the hold buffer,
+        /// thru SysEx is cut short with SysEx end byte and the rest of it is dropped.
+        class SerialTap : public lib::midi::serial::Hwa
+        {
+            public:
+            SerialTap(RawThru& thru, HwaSerial& hwa)
+                : _thru(thru)
+                , _hwa(hwa)
+            {}
+
+            bool init() override
+            {
+                return _hwa.init();
+            }
+
+            bool deInit() override
+            {
+                return _hwa.deInit();
+            }
+
+            bool read(SerialPacket& packet) override
+            {
+                if (!_hwa.read(packet))
+                {
+                    return false;
+                }
+
+                if (_thru.route(route_t::DIN_TO_DIN))
+                {
+                    forward(source_t::DIN, packet.data);
+                }
+
+                return true;
+            }
+
+            bool write(SerialPacket& packet) override
+            {
+                return forward(source_t::APP, packet.data);
+            }
+
+            bool forward(source_t source, uint8_t data)
+            {
+                auto& framer = _framer[static_cast<uint8_t>(source)];
+                auto  result = framer.feed(data);
+
+                if (result == Framer::result_t::REALTIME)
+                {
+                    return write(data);
+                }
+
+                bool ok = true;
+
+                if (result == Framer::result_t::SYSEX)
+                {
+                    ok = sysEx(source, data);
+                }
+
+                if ((_owner == source) && !framer.sysEx())
+                {
+                    release();
+                }
+
+                if (result == Framer::result_t::MESSAGE)
+                {
+                    ok = message(source, framer);
+                }
+
+                return ok;
+            }
+
+            /// Drops partially received data from given thru source.
+            void reset(source_t source)
+            {
+                if (_owner == source)
+                {
+                    abort();
+                }
+
+                _framer[static_cast<uint8_t>(source)] = {};
+            }
+
+            private:
+            RawThru&                                                   _thru;
+            HwaSerial&                                                 _hwa;
+            std::array<Framer, static_cast<uint8_t>(source_t::AMOUNT)> _framer   = {};
+            std::array<uint8_t, SERIAL_HOLD_BUFFER_SIZE>               _held     = {};
+            size_t                                                     _heldSize = 0;
+
+            /// Source of the SysEx message currently being written out.
+            source_t _owner = source_t::NONE;
+
+            /// Status byte of the last message written out, zero if running status isn't in effect.
+            uint8_t _status = 0;
+
+            bool write(uint8_t data)
+            {
+                if ((data >= 0x80) && (data < 0xF8))
+                {
+                    _status = data < 0xF0 ? data : 0;
+                }
+
+                SerialPacket packet = {};
+                packet.data         = data;
+                return _hwa.write(packet);
+            }
+
+            bool sysEx(source_t source, uint8_t data)
+            {
+                if (_owner == source)
+                {
+                    return write(data);
+                }
+
+                if (_owner == source_t::NONE)
+                {
+                    // remaining part of the SysEx message which has been cut short
+                    if (data != 0xF0)
+                    {
+                        return false;
+                    }
+
+                    _owner = source;
+                    return write(data);
+                }
+
+                if (source != source_t::APP)
+                {
+                    return false;
+                }
+
+                return hold(&data, 1);
+            }
+
+            bool message(source_t source, const Framer& framer)
+            {
+                auto data = framer.message();
+                auto size = framer.size();
+
+                if ((_owner != source_t::NONE) && (_owner != source))
+                {
+                    if ((source != source_t::APP) && ((_heldSize + size) > _held.size()))
+                    {
+                        return false;
+                    }
+
+                    // output state is unknown once the held data is written: always include the status
+                    return hold(data, size);
+                }
+
+                if (!framer.explicitStatus() && (_status == data[0]))
+                {
+                    data++;
+                    size--;
+                }
+
+                for (size_t i = 0; i < size; i++)
+                {
+                    if (!write(data[i]))
+                    {
+                        return false;
+                    }
+                }
+
+                return true;
+            }
+
+            /// Holds application data or complete message from thru source until the output is released.
+            /// Application data is never dropped: if it doesn't fit, SysEx written out is cut short instead.
+            bool hold(const uint8_t* data, size_t size)
+            {
+                if ((_heldSize + size) > _held.size())
+                {
+                    abort();
+
+                    bool ok = true;
+
+                    for (size_t i = 0; i < size; i++)
+                    {
+                        ok &= write(data[i]);
+                    }
+
+                    return ok;
+                }
+
+                for (size_t i = 0; i < size; i++)
+                {
+                    _held[_heldSize++] = data[i];
+                }
+
+                return true;
+            }
+
+            void release()
+            {
+                _owner = source_t::NONE;
+
+                for (size_t i = 0; i < _heldSize; i++)
+                {
+                    write(_held[i]);
+                }
+
+                _heldSize = 0;
+
+                // held application data might end with partial SysEx message: rest of it follows directly
+                if (_framer[static_cast<uint8_t>(source_t::APP)].sysEx())
+                {
+                    _owner = source_t::APP;
+                }
+            }
+
+            void abort()
+            {
+                write(0xF7);
+                release();
+            }
+        };
+
+        UsbTap                                                   _usbTap;
+        SerialTap                                                _serialTap;
+        std::array<bool, static_cast<uint8_t>(route_t::AMOUNT)> _routes = {};
+    };
+}    // namespace protocol::midi
@@ -36,6 +36,22 @@ namespace sys
     // MIDI software no time to react.
     constexpr inline uint32_t USB_CHANGE_FORCED_REFRESH_DELAY = 1000;
 
+    // Time in milliseconds without any MIDI traffic (incoming or generated by components) after
+    // which the device is considered idle. While there is traffic, database writes are kept in
+    // NVM cache so that potentially long flash operations (emulated EEPROM page transfer) don't
+    // stall the performance. Cached writes are stored to flash once idle.
+    constexpr inline uint32_t TRAFFIC_IDLE_DELAY = 2000;
+
+    // Maximum time in milliseconds for which writes are deferred during continuous traffic.
+    // Once exceeded, idle state is forced so that the cached writes get stored.
+    constexpr inline uint32_t MAX_TRAFFIC_DEFERRAL = 30000;
+
+    // Time in milliseconds without any SysEx configuration message after which an open configuration
+    // transaction is committed on its own. Values set within the transaction are acknowledged
+    // one by one, so they are kept: this only ensures that the storage cache is flushed and the
+    // components are reinitialized once the host which started the transaction goes away.
+    constexpr inline uint32_t CONFIG_TRANSACTION_TIMEOUT = 5000;
+
     // Maximum amount of component indexes which will be checked per single run() call. All indexes aren't
     // processed in order to reduce the amount of time spent in a single run() call.
     constexpr inline size_t MAX_UPDATES_PER_RUN = 16;
@@ -117,6 +117,8 @@ namespace sys
                 CHANNEL,
                 LOWER_OFFSET,
                 UPPER_OFFSET,
+                AFTERTOUCH_RATE,
+                AFTERTOUCH_SLEW,
                 AMOUNT
             };
 
@@ -34,6 +34,11 @@ constexpr inline uint8_t SYSEX_CR_BOOTLOADER_SUPPORT            = 0x51;
 constexpr inline uint8_t SYSEX_CR_FULL_BACKUP                   = 0x1B;
 constexpr inline uint8_t SYSEX_CR_RESTORE_START                 = 0x1C;
 constexpr inline uint8_t SYSEX_CR_RESTORE_END                   = 0x1D;
+constexpr inline uint8_t SYSEX_CR_CONFIG_TRANSACTION_BEGIN      = 0x1E;
+constexpr inline uint8_t SYSEX_CR_CONFIG_TRANSACTION_COMMIT     = 0x1F;
+constexpr inline uint8_t SYSEX_CR_MIDI_CLOCK_STATS              = 0x4B;
+constexpr inline uint8_t SYSEX_CR_READ_LOG                      = 0x4C;
+constexpr inline uint8_t SYSEX_CR_PROFILER_STATS                = 0x4E;
 
 /// Custom ID used when sending info about components to host
 constexpr inline uint8_t SYSEX_CM_COMPONENT_ID = 0x49;
\ No newline at end of file
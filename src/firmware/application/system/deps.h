@@ -42,6 +42,7 @@ namespace sys
         virtual void update()                                                                      = 0;
         virtual void reboot(fw_selector::fwType_t type)                                            = 0;
         virtual void registerOnUSBconnectionHandler(usbConnectionHandler_t&& usbConnectionHandler) = 0;
+        virtual size_t readLog(uint8_t* buffer, size_t maxSize)                                    = 0;
     };
 
     class Components
@@ -22,6 +22,10 @@ limitations under the License.
 #include "application/messaging/messaging.h"
 #include "board/board.h"
 
+#ifdef OPENDECK_USE_DEFERRED_LOGGER
+#include "board/deferred_logger.h"
+#endif
+
 #include "core/mcu.h"
 
 namespace sys
@@ -58,6 +62,11 @@ namespace sys
         bool init() override
         {
             board::init();
+
+#if defined(OPENDECK_USE_DEFERRED_LOGGER) && defined(PROJECT_TARGET_UART_CHANNEL_LOGGER)
+            board::uart::init(PROJECT_TARGET_UART_CHANNEL_LOGGER, LOGGER_UART_BAUDRATE);
+#endif
+
             return true;
         }
 
@@ -86,6 +95,17 @@ namespace sys
                 lastConnectionState = newState;
                 lastCheckTime       = core::mcu::timing::ms();
             }
+
+#if defined(OPENDECK_USE_DEFERRED_LOGGER) && defined(PROJECT_TARGET_UART_CHANNEL_LOGGER)
+            // drain only small chunk per call so that logging never delays the main loop
+            uint8_t logChunk[LOGGER_UART_CHUNK_SIZE];
+            auto    size = board::logger::read(logChunk, sizeof(logChunk));
+
+            if (size)
+            {
+                board::uart::write(PROJECT_TARGET_UART_CHANNEL_LOGGER, logChunk, size);
+            }
+#endif
         }
 
         void reboot(fw_selector::fwType_t type) override
@@ -101,8 +121,19 @@ namespace sys
             _usbConnectionHandler = std::move(usbConnectionHandler);
         }
 
+        size_t readLog(uint8_t* buffer, size_t maxSize) override
+        {
+#ifdef OPENDECK_USE_DEFERRED_LOGGER
+            return board::logger::read(buffer, maxSize);
+#else
+            return 0;
+#endif
+        }
+
         private:
-        static constexpr uint32_t USB_CONN_CHECK_TIME   = 2000;
-        usbConnectionHandler_t    _usbConnectionHandler = nullptr;
+        static constexpr uint32_t USB_CONN_CHECK_TIME    = 2000;
+        static constexpr uint32_t LOGGER_UART_BAUDRATE   = 115200;
+        static constexpr size_t   LOGGER_UART_CHUNK_SIZE = 8;
+        usbConnectionHandler_t    _usbConnectionHandler  = nullptr;
     };
 }    // namespace sys
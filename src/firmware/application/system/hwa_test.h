@@ -43,5 +43,10 @@ namespace sys
         void registerOnUSBconnectionHandler(sys::usbConnectionHandler_t&& usbConnectionHandler) override
         {
         }
+
+        size_t readLog(uint8_t* buffer, size_t maxSize) override
+        {
+            return 0;
+        }
     };
 }    // namespace sys
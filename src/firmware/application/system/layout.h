@@ -359,6 +359,20 @@ namespace sys
                 0,
                 100,
             },
+
+            // fsr aftertouch rate section
+            {
+                io::analog::Collection::SIZE(),
+                0,
+                io::analog::MAX_AFTERTOUCH_RATE,
+            },
+
+            // fsr aftertouch slew section
+            {
+                io::analog::Collection::SIZE(),
+                0,
+                io::analog::MAX_AFTERTOUCH_SLEW,
+            },
         };
 
         std::vector<lib::sysexconf::Section> _ledSections = {
@@ -590,6 +604,35 @@ namespace sys
                 .requestId     = SYSEX_CR_RESTORE_END,
                 .connOpenCheck = true,
             },
+
+            {
+                .requestId     = SYSEX_CR_CONFIG_TRANSACTION_BEGIN,
+                .connOpenCheck = true,
+            },
+
+            {
+                .requestId     = SYSEX_CR_CONFIG_TRANSACTION_COMMIT,
+                .connOpenCheck = true,
+            },
+
+            {
+                .requestId     = SYSEX_CR_MIDI_CLOCK_STATS,
+                .connOpenCheck = true,
+            },
+
+#ifdef OPENDECK_USE_PROFILER
+            {
+                .requestId     = SYSEX_CR_PROFILER_STATS,
+                .connOpenCheck = true,
+            },
+#endif
+
+#ifdef OPENDECK_USE_DEFERRED_LOGGER
+            {
+                .requestId     = SYSEX_CR_READ_LOG,
+                .connOpenCheck = true,
+            },
+#endif
         };
 
         public:
@@ -0,0 +1,171 @@
+/*
+
+Copyright Igor Petrovic
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#pragma once
+
+#include "application/io/base.h"
+
+#include <inttypes.h>
+#include <stddef.h>
+
+#ifdef OPENDECK_USE_PROFILER
+#include "board/board.h"
+#include "core/mcu.h"
+#endif
+
+namespace sys
+{
+    /// Sections of the main loop which are measured separately.
+    /// First entries match io::ioComponent_t so that IO components can be used directly as sections.
+    enum class profilerSection_t : uint8_t
+    {
+        BUTTONS,
+        ENCODERS,
+        ANALOG,
+        LEDS,
+        I2C,
+        TOUCHSCREEN,
+        HWA,
+        PROTOCOLS,
+        SCHEDULER,
+        LOOP,
+        AMOUNT
+    };
+
+    static_assert(static_cast<size_t>(profilerSection_t::HWA) == static_cast<size_t>(io::ioComponent_t::AMOUNT),
+                  "IO component sections must match io::ioComponent_t");
+
+#ifdef OPENDECK_USE_PROFILER
+    /// Accumulates min/avg/max execution time of each main loop section
+    /// and counts loop iterations which took longer than OVERRUN_THRESHOLD_US.
+    class Profiler
+    {
+        public:
+        struct Stats
+        {
+            uint32_t min   = UINT32_MAX;
+            uint32_t max   = 0;
+            uint64_t total = 0;
+            uint32_t count = 0;
+        };
+
+        static constexpr uint32_t OVERRUN_THRESHOLD_US = 1000;
+
+        Profiler() = default;
+
+        void init()
+        {
+            board::profiler::init();
+
+            // calibrate the counter against ms timer so that results can be reported in time units
+            uint32_t ms = core::mcu::timing::ms();
+
+            while (core::mcu::timing::ms() == ms)
+            {
+                ;
+            }
+
+            ms          = core::mcu::timing::ms();
+            auto cycles = board::profiler::cycles();
+
+            while (core::mcu::timing::ms() == ms)
+            {
+                ;
+            }
+
+            _cyclesPerMs = board::profiler::elapsed(cycles);
+            reset();
+        }
+
+        uint32_t start()
+        {
+            return board::profiler::cycles();
+        }
+
+        void stop(profilerSection_t section, uint32_t start)
+        {
+            auto  cycles = board::profiler::elapsed(start);
+            auto& stats  = _stats[static_cast<size_t>(section)];
+
+            if (cycles < stats.min)
+            {
+                stats.min = cycles;
+            }
+
+            if (cycles > stats.max)
+            {
+                stats.max = cycles;
+            }
+
+            stats.total += cycles;
+            stats.count++;
+
+            if ((section == profilerSection_t::LOOP) && (toUs(cycles) > OVERRUN_THRESHOLD_US))
+            {
+                _overruns++;
+            }
+        }
+
+        void reset()
+        {
+            for (auto& stats : _stats)
+            {
+                stats = {};
+            }
+
+            _overruns = 0;
+        }
+
+        const Stats& stats(profilerSection_t section) const
+        {
+            return _stats[static_cast<size_t>(section)];
+        }
+
+        uint32_t overruns() const
+        {
+            return _overruns;
+        }
+
+        uint32_t toUs(uint64_t cycles) const
+        {
+            return _cyclesPerMs ? static_cast<uint32_t>((cycles * 1000) / _cyclesPerMs) : 0;
+        }
+
+        private:
+        Stats    _stats[static_cast<size_t>(profilerSection_t::AMOUNT)] = {};
+        uint32_t _overruns                                              = 0;
+        uint32_t _cyclesPerMs                                           = 0;
+    };
+#else
+    /// Empty profiler: all calls compile out when profiling is disabled.
+    class Profiler
+    {
+        public:
+        void init()
+        {}
+
+        uint32_t start()
+        {
+            return 0;
+        }
+
+        void stop(profilerSection_t section, uint32_t start)
+        {}
+    };
+#endif
+}    // namespace sys
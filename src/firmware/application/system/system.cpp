@@ -21,6 +21,7 @@ limitations under the License.
 #include "application/util/configurable/configurable.h"
 #include "application/util/conversion/conversion.h"
 #include "application/global/midi_program.h"
+#include "application/global/midi_clock.h"
 #include "bootloader/fw_selector/fw_selector.h"
 
 #ifdef PROJECT_TARGET_SAX_REGISTER_CHROMATIC
@@ -49,23 +50,30 @@ System::System(Hwa&        hwa,
                           {
                               switch (event.message)
                               {
-                              case midi::messageType_t::PROGRAM_CHANGE:
+                              case midi::messageType_t::SYS_REAL_TIME_CLOCK:
+                              case midi::messageType_t::SYS_REAL_TIME_START:
+                              case midi::messageType_t::SYS_REAL_TIME_CONTINUE:
+                              case midi::messageType_t::SYS_REAL_TIME_STOP:
+                              case midi::messageType_t::SYS_REAL_TIME_ACTIVE_SENSING:
+                              case midi::messageType_t::SYS_REAL_TIME_SYSTEM_RESET:
+                                  // sent continuously even when nothing is being played
+                                  break;
+
+                              default:
                               {
-                                  if (_components.database().read(database::Config::Section::system_t::SYSTEM_SETTINGS,
-                                                                  Config::systemSetting_t::ENABLE_PRESET_CHANGE_WITH_PROGRAM_CHANGE_IN))
-                                  {
-                                      _components.database().setPreset(event.index);
-                                  }
+                                  trafficDetected();
                               }
                               break;
+                              }
 
-                              case midi::messageType_t::SYS_EX:
+                              switch (event.message)
                               {
-                                  _sysExConf.handleMessage(event.sysEx, event.sysExLength);
-
-                                  if (_backupRestoreState == backupRestoreState_t::BACKUP)
+                              case midi::messageType_t::PROGRAM_CHANGE:
+                              {
+                                  if (_components.database().read(database::Config::Section::system_t::SYSTEM_SETTINGS,
+                                                                  Config::systemSetting_t::ENABLE_PRESET_CHANGE_WITH_PROGRAM_CHANGE_IN))
                                   {
-                                      backup();
+                                      _components.database().setPreset(event.index);
                                   }
                               }
                               break;
@@ -75,6 +83,37 @@ System::System(Hwa&        hwa,
                               }
                           });
 
+    auto trafficHandler = [this](const messaging::Event&)
+    {
+        trafficDetected();
+    };
+
+    MidiDispatcher.listen(messaging::eventType_t::BUTTON, trafficHandler);
+    MidiDispatcher.listen(messaging::eventType_t::ANALOG, trafficHandler);
+    MidiDispatcher.listen(messaging::eventType_t::ENCODER, trafficHandler);
+
+    SysExDispatcher.listen(messaging::eventType_t::MIDI_IN,
+                           [this](const messaging::SysExView& sysEx)
+                           {
+                               _sysExConf.handleMessage(sysEx.data, sysEx.length);
+
+                               if (_backupRestoreState == backupRestoreState_t::BACKUP)
+                               {
+                                   backup();
+                               }
+
+                               if (_configTransaction)
+                               {
+                                   // host is still configuring: push the timeout back
+                                   _scheduler.registerTask({ SCHEDULED_TASK_CONFIG_TRANSACTION,
+                                                             CONFIG_TRANSACTION_TIMEOUT,
+                                                             [this]()
+                                                             {
+                                                                 endConfigTransaction();
+                                                             } });
+                               }
+                           });
+
     MidiDispatcher.listen(messaging::eventType_t::SYSTEM,
                           [this](const messaging::Event& event)
                           {
@@ -103,19 +142,15 @@ System::System(Hwa&        hwa,
                               }
                           });
 
-    ConfigHandler.registerConfig(
-        sys::Config::block_t::GLOBAL,
-        // read
-        [this](uint8_t section, size_t index, uint16_t& value)
-        {
-            return sysConfigGet(static_cast<sys::Config::Section::global_t>(section), index, value);
-        },
-
-        // write
-        [this](uint8_t section, size_t index, uint16_t value)
-        {
-            return sysConfigSet(static_cast<sys::Config::Section::global_t>(section), index, value);
-        });
+    ConfigHandler.registerConfig<&System::sysConfigGet, &System::sysConfigSet>(sys::Config::block_t::GLOBAL,
+                                                                               this,
+                                                                               {
+                                                                                   sys::Config::Section::global_t::SYSTEM_SETTINGS,
+                                                                                   sys::Config::Section::global_t::SAX_FINGERING_MASK_LO14,
+                                                                                   sys::Config::Section::global_t::SAX_FINGERING_MASK_HI10_ENABLE,
+                                                                                   sys::Config::Section::global_t::SAX_FINGERING_NOTE,
+                                                                                   sys::Config::Section::global_t::SAX_FINGERING_CAPTURE,
+                                                                               });
 }
 
 bool System::init()
@@ -144,6 +179,9 @@ bool System::init()
 
     _hwa.registerOnUSBconnectionHandler([this]()
                                         {
+                                            // host which has started the transaction is gone
+                                            endConfigTransaction();
+
                                             _scheduler.registerTask({ SCHEDULED_TASK_FORCED_REFRESH,
                                                                       USB_CHANGE_FORCED_REFRESH_DELAY,
                                                                       [this]()
@@ -157,6 +195,8 @@ bool System::init()
         return false;
     }
 
+    _profiler.init();
+
     if (!_components.database().init(_databaseHandlers))
     {
         return false;
@@ -207,10 +247,25 @@ bool System::init()
 // done to reduce the amount of spent time inside checkComponents.
 ioComponent_t System::run()
 {
+    auto loopStart = _profiler.start();
+    auto start     = loopStart;
+
     _hwa.update();
+    _profiler.stop(profilerSection_t::HWA, start);
+
     auto retVal = checkComponents();
+
+    start = _profiler.start();
     checkProtocols();
+    _profiler.stop(profilerSection_t::PROTOCOLS, start);
+
+    start = _profiler.start();
     _scheduler.update();
+    _profiler.stop(profilerSection_t::SCHEDULER, start);
+
+    _components.database().updateStorage();
+
+    _profiler.stop(profilerSection_t::LOOP, loopStart);
 
     return retVal;
 }
@@ -359,6 +414,8 @@ ioComponent_t System::checkComponents()
 
     if (component != nullptr)
     {
+        auto start = _profiler.start();
+
         for (size_t i = 0; i < loopIterations; i++)
         {
             component->updateSingle(_componentUpdateIndex[static_cast<size_t>(_componentIndex)]);
@@ -368,6 +425,8 @@ ioComponent_t System::checkComponents()
                 _componentUpdateIndex[static_cast<size_t>(_componentIndex)] = 0;
             }
         }
+
+        _profiler.stop(static_cast<profilerSection_t>(_componentIndex), start);
     }
 
     // return the last processed io component
@@ -408,19 +467,116 @@ void System::forceComponentRefresh()
     MidiDispatcher.notify(messaging::eventType_t::SYSTEM, event);
 }
 
-void System::SysExDataHandler::sendResponse(uint8_t* array, uint16_t size)
+void System::trafficDetected()
 {
+    auto now = core::mcu::timing::ms();
+
+    // idle timeout needs to be pushed back only once per millisecond
+    if (_trafficActive && (now == _lastTrafficTime))
+    {
+        return;
+    }
+
+    if (_trafficActive && ((now - _trafficStartTime) >= MAX_TRAFFIC_DEFERRAL))
+    {
+        // continuous traffic: don't keep the deferred writes in RAM only for too long
+        trafficIdle();
+    }
+
+    if (!_trafficActive)
+    {
+        _trafficActive    = true;
+        _trafficStartTime = now;
+
+        messaging::Event event = {};
+        event.systemMessage    = messaging::systemMessage_t::TRAFFIC_ACTIVE;
+
+        MidiDispatcher.notify(messaging::eventType_t::SYSTEM, event);
+    }
+
+    _lastTrafficTime = now;
+
+    _scheduler.registerTask({ SCHEDULED_TASK_TRAFFIC_IDLE,
+                              TRAFFIC_IDLE_DELAY,
+                              [this]()
+                              {
+                                  trafficIdle();
+                              } });
+}
+
+void System::trafficIdle()
+{
+    if (!_trafficActive)
+    {
+        return;
+    }
+
+    _trafficActive = false;
+
     messaging::Event event = {};
-    event.systemMessage    = messaging::systemMessage_t::SYS_EX_RESPONSE;
-    event.message          = midi::messageType_t::SYS_EX;
-    event.sysEx            = array;
-    event.sysExLength      = size;
+    event.systemMessage    = messaging::systemMessage_t::TRAFFIC_IDLE;
 
     MidiDispatcher.notify(messaging::eventType_t::SYSTEM, event);
 }
 
+void System::startConfigTransaction()
+{
+    // begin within already open transaction only extends it
+    if (_configTransaction)
+    {
+        return;
+    }
+
+    // values set from now on are validated and stored as usual, but components
+    // defer their reinitialization and the storage defers flash writes until commit
+    _configTransaction = true;
+
+    messaging::Event event = {};
+    event.systemMessage    = messaging::systemMessage_t::CONFIG_TRANSACTION_START;
+
+    MidiDispatcher.notify(messaging::eventType_t::SYSTEM, event);
+}
+
+/// Commits open configuration transaction.
+/// Called on commit request, but also once the transaction times out or USB is reconnected
+/// so that the storage never stays in cache-only mode.
+void System::endConfigTransaction()
+{
+    // commit without begin has nothing to apply
+    if (!_configTransaction)
+    {
+        return;
+    }
+
+    _configTransaction = false;
+
+    messaging::Event event = {};
+    event.systemMessage    = messaging::systemMessage_t::CONFIG_TRANSACTION_END;
+
+    MidiDispatcher.notify(messaging::eventType_t::SYSTEM, event);
+}
+
+void System::SysExDataHandler::sendResponse(uint8_t* array, uint16_t size)
+{
+    messaging::SysExView sysEx = {};
+    sysEx.data                 = array;
+    sysEx.length               = size;
+
+    SysExDispatcher.notify(messaging::eventType_t::SYSTEM, sysEx);
+}
+
+/// Clamps the value so that it can be sent as a single 14-bit SysEx value.
+uint16_t System::reportedValue(uint32_t value)
+{
+    return static_cast<uint16_t>(value > MAX_REPORTED_VALUE ? MAX_REPORTED_VALUE : value);
+}
+
 uint8_t System::SysExDataHandler::customRequest(uint16_t request, CustomResponse& customResponse)
 {
+    // configuration requests are acknowledged to the host
+    // so the changes need to be stored right away, not deferred
+    _system.trafficIdle();
+
     uint8_t result = sys::Config::Status::ACK;
 
     auto appendSW = [&customResponse]()
@@ -550,6 +706,69 @@ uint8_t System::SysExDataHandler::customRequest(uint16_t request, CustomResponse
     }
     break;
 
+    case SYSEX_CR_CONFIG_TRANSACTION_BEGIN:
+    {
+        _system.startConfigTransaction();
+    }
+    break;
+
+    case SYSEX_CR_CONFIG_TRANSACTION_COMMIT:
+    {
+        _system.endConfigTransaction();
+    }
+    break;
+
+    case SYSEX_CR_MIDI_CLOCK_STATS:
+    {
+        // lock state, tempo (x10) and average/max jitter of incoming clock in microseconds
+        // stats are reset after each read so that every request covers period since the last one
+        const auto& stats = MidiClock.stats();
+
+        customResponse.append(MidiClock.locked());
+        customResponse.append(reportedValue(MidiClock.bpmX10()));
+        customResponse.append(reportedValue(stats.averageJitterUs));
+        customResponse.append(reportedValue(stats.maxJitterUs));
+        customResponse.append(reportedValue(stats.pulses));
+
+        MidiClock.resetStats();
+    }
+    break;
+
+#ifdef OPENDECK_USE_PROFILER
+    case SYSEX_CR_PROFILER_STATS:
+    {
+        // min, avg and max time in microseconds for each section followed by the amount of loop overruns
+        // stats are reset after each read so that every request covers period since the last one
+        for (size_t i = 0; i < static_cast<size_t>(profilerSection_t::AMOUNT); i++)
+        {
+            const auto& stats = _system._profiler.stats(static_cast<profilerSection_t>(i));
+
+            customResponse.append(reportedValue(stats.count ? _system._profiler.toUs(stats.min) : 0));
+            customResponse.append(reportedValue(stats.count ? _system._profiler.toUs(stats.total / stats.count) : 0));
+            customResponse.append(reportedValue(_system._profiler.toUs(stats.max)));
+        }
+
+        customResponse.append(reportedValue(_system._profiler.overruns()));
+        _system._profiler.reset();
+    }
+    break;
+#endif
+
+#ifdef OPENDECK_USE_DEFERRED_LOGGER
+    case SYSEX_CR_READ_LOG:
+    {
+        // empty response indicates that there is nothing left to read
+        uint8_t data[LOG_READ_CHUNK_SIZE];
+        auto    size = _system._hwa.readLog(data, sizeof(data));
+
+        for (size_t i = 0; i < size; i++)
+        {
+            customResponse.append(data[i]);
+        }
+    }
+    break;
+#endif
+
     default:
     {
         result = sys::Config::Status::ERROR_NOT_SUPPORTED;
@@ -565,6 +784,8 @@ uint8_t System::SysExDataHandler::get(uint8_t   block,
                                       uint16_t  index,
                                       uint16_t& value)
 {
+    _system.trafficIdle();
+
     return ConfigHandler.get(static_cast<sys::Config::block_t>(block), section, index, value);
 }
 
@@ -573,6 +794,8 @@ uint8_t System::SysExDataHandler::set(uint8_t  block,
                                       uint16_t index,
                                       uint16_t value)
 {
+    _system.trafficIdle();
+
     return ConfigHandler.set(static_cast<sys::Config::block_t>(block), section, index, value);
 }
 
@@ -21,6 +21,7 @@ limitations under the License.
 #include "deps.h"
 #include "config.h"
 #include "layout.h"
+#include "profiler.h"
 #include "application/util/cinfo/cinfo.h"
 #include "application/util/scheduler/scheduler.h"
 
@@ -42,6 +43,8 @@ namespace sys
         {
             SCHEDULED_TASK_PRESET,
             SCHEDULED_TASK_FORCED_REFRESH,
+            SCHEDULED_TASK_TRAFFIC_IDLE,
+            SCHEDULED_TASK_CONFIG_TRANSACTION,
         };
 
         enum class backupRestoreState_t : uint8_t
@@ -89,6 +92,12 @@ namespace sys
             Config::SYSEX_MANUFACTURER_ID_2
         };
 
+        /// Maximum amount of deferred log bytes returned in single SysEx response.
+        static constexpr size_t LOG_READ_CHUNK_SIZE = 16;
+
+        /// Largest value which can be sent as a single 14-bit SysEx value.
+        static constexpr uint32_t MAX_REPORTED_VALUE = 0x3FFF;
+
         Hwa&                      _hwa;
         Components&               _components;
         DatabaseHandlers          _databaseHandlers;
@@ -97,7 +106,12 @@ namespace sys
         util::Scheduler           _scheduler;
         util::ComponentInfo       _cInfo;
         Layout                    _layout;
+        Profiler                  _profiler;
         backupRestoreState_t      _backupRestoreState                                                    = backupRestoreState_t::NONE;
+        bool                      _configTransaction                                                     = false;
+        bool                      _trafficActive                                                         = false;
+        uint32_t                  _lastTrafficTime                                                       = 0;
+        uint32_t                  _trafficStartTime                                                      = 0;
         io::ioComponent_t         _componentIndex                                                        = io::ioComponent_t::AMOUNT;
         size_t                    _componentUpdateIndex[static_cast<uint8_t>(io::ioComponent_t::AMOUNT)] = {};
 
@@ -105,6 +119,11 @@ namespace sys
         void                   checkProtocols();
         void                   backup();
         void                   forceComponentRefresh();
+        void                   trafficDetected();
+        void                   trafficIdle();
+        void                   startConfigTransaction();
+        void                   endConfigTransaction();
+        static uint16_t        reportedValue(uint32_t value);
         std::optional<uint8_t> sysConfigGet(sys::Config::Section::global_t section, size_t index, uint16_t& value);
         std::optional<uint8_t> sysConfigSet(sys::Config::Section::global_t section, size_t index, uint16_t value);
     };
@@ -20,26 +20,84 @@ limitations under the License.
 
 using namespace util;
 
-void Configurable::registerConfig(sys::Config::block_t block, getHandler_t&& getHandler, setHandler_t&& setHandler)
+static_assert(static_cast<size_t>(sys::Config::Section::global_t::AMOUNT) <= Configurable::MAX_SECTIONS);
+static_assert(static_cast<size_t>(sys::Config::Section::button_t::AMOUNT) <= Configurable::MAX_SECTIONS);
+static_assert(static_cast<size_t>(sys::Config::Section::encoder_t::AMOUNT) <= Configurable::MAX_SECTIONS);
+static_assert(static_cast<size_t>(sys::Config::Section::analog_t::AMOUNT) <= Configurable::MAX_SECTIONS);
+static_assert(static_cast<size_t>(sys::Config::Section::leds_t::AMOUNT) <= Configurable::MAX_SECTIONS);
+static_assert(static_cast<size_t>(sys::Config::Section::i2c_t::AMOUNT) <= Configurable::MAX_SECTIONS);
+static_assert(static_cast<size_t>(sys::Config::Section::touchscreen_t::AMOUNT) <= Configurable::MAX_SECTIONS);
+
+bool Configurable::bind(sys::Config::block_t block, void* instance, getHandler_t get, setHandler_t set, const uint8_t* sections, size_t size)
 {
-    _getters.push_back({ block, std::move(getHandler) });
-    _setters.push_back({ block, std::move(setHandler) });
+    if ((_totalHandlers >= MAX_HANDLERS) || (block >= sys::Config::block_t::AMOUNT))
+    {
+        return false;
+    }
+
+    auto  handlerIndex = static_cast<uint8_t>(_totalHandlers);
+    auto& blockRoutes  = _routes[static_cast<size_t>(block)];
+    bool  bound        = false;
+
+    _handlers[handlerIndex] = { instance, get, set };
+
+    // no section list means that the handler covers the entire block
+    for (size_t i = 0; i < (sections == nullptr ? MAX_SECTIONS : size); i++)
+    {
+        auto section = sections == nullptr ? i : sections[i];
+
+        if (section >= MAX_SECTIONS)
+        {
+            continue;
+        }
+
+        for (auto& handler : blockRoutes[section])
+        {
+            if (handler == NO_HANDLER)
+            {
+                handler = handlerIndex;
+                bound   = true;
+                break;
+            }
+        }
+    }
+
+    if (bound)
+    {
+        _totalHandlers++;
+    }
+
+    return bound;
+}
+
+const Configurable::route_t* Configurable::route(sys::Config::block_t block, uint8_t section)
+{
+    if ((block >= sys::Config::block_t::AMOUNT) || (section >= MAX_SECTIONS))
+    {
+        return nullptr;
+    }
+
+    return &_routes[static_cast<size_t>(block)][section];
 }
 
 uint8_t Configurable::get(sys::Config::block_t block, uint8_t section, size_t index, uint16_t& value)
 {
-    for (size_t i = 0; i < _getters.size(); i++)
+    auto handlers = route(block, section);
+
+    if (handlers != nullptr)
     {
-        if (_getters.at(i).handler != nullptr)
+        for (auto handler : *handlers)
         {
-            if (_getters.at(i).block == block)
+            if (handler == NO_HANDLER)
             {
-                auto result = _getters.at(i).handler(section, index, value);
+                break;
+            }
+
+            auto result = _handlers[handler].get(_handlers[handler].instance, section, index, value);
 
-                if (result != std::nullopt)
-                {
-                    return *result;
-                }
+            if (result != std::nullopt)
+            {
+                return *result;
             }
         }
     }
@@ -49,18 +107,22 @@ uint8_t Configurable::get(sys::Config::block_t block, uint8_t section, size_t in
 
 uint8_t Configurable::set(sys::Config::block_t block, uint8_t section, size_t index, uint16_t value)
 {
-    for (size_t i = 0; i < _setters.size(); i++)
+    auto handlers = route(block, section);
+
+    if (handlers != nullptr)
     {
-        if (_setters.at(i).handler != nullptr)
+        for (auto handler : *handlers)
         {
-            if (_setters.at(i).block == block)
+            if (handler == NO_HANDLER)
             {
-                auto result = _setters.at(i).handler(section, index, value);
+                break;
+            }
+
+            auto result = _handlers[handler].set(_handlers[handler].instance, section, index, value);
 
-                if (result != std::nullopt)
-                {
-                    return *result;
-                }
+            if (result != std::nullopt)
+            {
+                return *result;
             }
         }
     }
@@ -70,6 +132,7 @@ uint8_t Configurable::set(sys::Config::block_t block, uint8_t section, size_t in
 
 void Configurable::clear()
 {
-    _getters.clear();
-    _setters.clear();
-}
\ No newline at end of file
+    _handlers      = {};
+    _totalHandlers = 0;
+    _routes        = emptyRoutes();
+}
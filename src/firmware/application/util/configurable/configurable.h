@@ -20,16 +20,30 @@ limitations under the License.
 
 #include "application/system/config.h"
 
-#include <functional>
+#include <array>
+#include <initializer_list>
 #include <optional>
 
 namespace util
 {
+    /// Routes configuration requests to the component handling given block and section.
+    /// Handlers are plain member functions bound at registration: each (block, section) pair
+    /// is resolved with a single table lookup, without scanning or calling unrelated handlers.
     class Configurable
     {
         public:
-        using getHandler_t = std::function<std::optional<uint8_t>(uint8_t section, size_t index, uint16_t& value)>;
-        using setHandler_t = std::function<std::optional<uint8_t>(uint8_t section, size_t index, uint16_t value)>;
+        using getHandler_t = std::optional<uint8_t> (*)(void* instance, uint8_t section, size_t index, uint16_t& value);
+        using setHandler_t = std::optional<uint8_t> (*)(void* instance, uint8_t section, size_t index, uint16_t value);
+
+        /// Maximum amount of sections in any configuration block.
+        static constexpr size_t MAX_SECTIONS = 16;
+
+        /// Maximum amount of handlers which can share single section.
+        /// Handlers sharing the section are called in registration order until one returns a value.
+        static constexpr size_t MAX_HANDLERS_PER_SECTION = 2;
+
+        /// Maximum amount of registered handler pairs.
+        static constexpr size_t MAX_HANDLERS = 16;
 
         static Configurable& instance()
         {
@@ -37,7 +51,32 @@ namespace util
             return instance;
         }
 
-        void    registerConfig(sys::Config::block_t block, getHandler_t&& getHandler, setHandler_t&& setHandler);
+        /// Registers configuration handlers for all sections in the block.
+        /// Usage: ConfigHandler.registerConfig<&Class::sysConfigGet, &Class::sysConfigSet>(block, this);
+        template<auto Get, auto Set, typename T>
+        bool registerConfig(sys::Config::block_t block, T* instance)
+        {
+            return bind(block, instance, &getTrampoline<Get>, &setTrampoline<Set>, nullptr, 0);
+        }
+
+        /// Registers configuration handlers for the listed sections in the block only.
+        template<auto Get, auto Set, typename T, typename Section>
+        bool registerConfig(sys::Config::block_t block, T* instance, std::initializer_list<Section> sections)
+        {
+            uint8_t list[MAX_SECTIONS] = {};
+            size_t  size               = 0;
+
+            for (auto section : sections)
+            {
+                if (size < MAX_SECTIONS)
+                {
+                    list[size++] = static_cast<uint8_t>(section);
+                }
+            }
+
+            return bind(block, instance, &getTrampoline<Get>, &setTrampoline<Set>, list, size);
+        }
+
         uint8_t get(sys::Config::block_t block, uint8_t section, size_t index, uint16_t& value);
         uint8_t set(sys::Config::block_t block, uint8_t section, size_t index, uint16_t value);
         void    clear();
@@ -45,21 +84,68 @@ namespace util
         private:
         Configurable() = default;
 
-        struct GetHandlerInternal
+        static constexpr uint8_t NO_HANDLER = 0xFF;
+
+        template<typename>
+        struct HandlerTraits;
+
+        template<typename T, typename Section, typename Value>
+        struct HandlerTraits<std::optional<uint8_t> (T::*)(Section, size_t, Value)>
         {
-            sys::Config::block_t block   = sys::Config::block_t::GLOBAL;
-            getHandler_t         handler = nullptr;
+            using instance_t = T;
+            using section_t  = Section;
         };
 
-        struct SetHandlerInternal
+        struct Handler
         {
-            sys::Config::block_t block   = sys::Config::block_t::GLOBAL;
-            setHandler_t         handler = nullptr;
+            void*        instance = nullptr;
+            getHandler_t get      = nullptr;
+            setHandler_t set      = nullptr;
         };
 
-        std::vector<GetHandlerInternal> _getters = {};
-        std::vector<SetHandlerInternal> _setters = {};
+        /// Indexes of the handlers registered for single section.
+        using route_t  = std::array<uint8_t, MAX_HANDLERS_PER_SECTION>;
+        using routes_t = std::array<std::array<route_t, MAX_SECTIONS>, static_cast<size_t>(sys::Config::block_t::AMOUNT)>;
+
+        std::array<Handler, MAX_HANDLERS> _handlers      = {};
+        size_t                            _totalHandlers = 0;
+        routes_t                          _routes        = emptyRoutes();
+
+        template<auto Get>
+        static std::optional<uint8_t> getTrampoline(void* instance, uint8_t section, size_t index, uint16_t& value)
+        {
+            using traits_t = HandlerTraits<decltype(Get)>;
+            return (static_cast<typename traits_t::instance_t*>(instance)->*Get)(static_cast<typename traits_t::section_t>(section), index, value);
+        }
+
+        template<auto Set>
+        static std::optional<uint8_t> setTrampoline(void* instance, uint8_t section, size_t index, uint16_t value)
+        {
+            using traits_t = HandlerTraits<decltype(Set)>;
+            return (static_cast<typename traits_t::instance_t*>(instance)->*Set)(static_cast<typename traits_t::section_t>(section), index, value);
+        }
+
+        static constexpr routes_t emptyRoutes()
+        {
+            routes_t table = {};
+
+            for (auto& block : table)
+            {
+                for (auto& route : block)
+                {
+                    for (auto& handler : route)
+                    {
+                        handler = NO_HANDLER;
+                    }
+                }
+            }
+
+            return table;
+        }
+
+        bool           bind(sys::Config::block_t block, void* instance, getHandler_t get, setHandler_t set, const uint8_t* sections, size_t size);
+        const route_t* route(sys::Config::block_t block, uint8_t section);
     };
 }    // namespace util
 
-#define ConfigHandler util::Configurable::instance()
\ No newline at end of file
+#define ConfigHandler util::Configurable::instance()
@@ -128,6 +128,8 @@ namespace util
             database::Config::Section::analog_t::CHANNEL,
             database::Config::Section::analog_t::LOWER_OFFSET,
             database::Config::Section::analog_t::UPPER_OFFSET,
+            database::Config::Section::analog_t::AFTERTOUCH_RATE,
+            database::Config::Section::analog_t::AFTERTOUCH_SLEW,
         };
 
         static constexpr database::Config::Section::leds_t SYS_EX2_DB_LEDS[static_cast<uint8_t>(sys::Config::Section::leds_t::AMOUNT)] = {
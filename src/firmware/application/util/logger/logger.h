@@ -20,7 +20,15 @@ limitations under the License.
 
 #include "core/util/logger.h"
 
-#ifdef OPENDECK_USE_LOGGER
+#if defined(OPENDECK_USE_DEFERRED_LOGGER) && defined(OPENDECK_FW_APP)
+
+#include "board/deferred_logger.h"
+
+#define LOG_INF(format, ...) DEFERRED_LOG(board::logger::source_t::APPLICATION, board::logger::level_t::INFO, format, ##__VA_ARGS__)
+#define LOG_WRN(format, ...) DEFERRED_LOG(board::logger::source_t::APPLICATION, board::logger::level_t::WARNING, format, ##__VA_ARGS__)
+#define LOG_ERR(format, ...) DEFERRED_LOG(board::logger::source_t::APPLICATION, board::logger::level_t::ERROR, format, ##__VA_ARGS__)
+
+#elif defined(OPENDECK_USE_LOGGER)
 #ifdef OPENDECK_FW_APP
 constexpr inline size_t APP_LOGGER_SIZE = 128;
 CORE_LOGGER_DECLARE(APP_LOGGER, APP_LOGGER_SIZE);
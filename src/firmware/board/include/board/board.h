@@ -361,6 +361,15 @@ namespace board
             /// param [in]: component   A or B encoder component (enumerated type, see encoderComponent_t).
             /// returns: Calculated index of A or B signal of encoder.
             size_t encoderComponentFromEncoder(size_t index, encoderComponent_t component);
+
+            /// Retrieves the time between closing of the first and the second contact of dual-contact key.
+            /// Both contacts of the key are read via the inputs which form A and B component of the encoder.
+            /// Interval is reported only via the first contact so that it's retrieved once per strike:
+            /// for the index of the second contact this always returns false.
+            /// param [in]:  index     Digital input index of the first contact of the key.
+            /// param [out]: interval  Time in microseconds between closing of the two contacts.
+            /// returns: True if the new interval has been captured since the last call.
+            bool contactInterval(size_t index, uint32_t& interval);
         }    // namespace digital_in
 
         namespace digital_out
@@ -386,6 +395,13 @@ namespace board
             /// param [in]: brightnessLevel See ledBrightness_t enum.
             void writeLedState(size_t index, ledBrightness_t ledBrightness);
 
+            /// Used to set LED duty cycle with 8-bit resolution.
+            /// Duty is gamma corrected on targets with binary code modulation (leds.external.bcmBits).
+            /// Elsewhere it's rounded to the nearest ledBrightness_t level.
+            /// param [in]: index   LED for which to change state.
+            /// param [in]: duty    Duty cycle, 0-255.
+            void writeLedDuty(size_t index, uint8_t duty);
+
             /// Calculates RGB LED index based on provided single-color LED index.
             /// param [in]: index   Index of single-color LED.
             /// returns: Calculated index of RGB LED.
@@ -405,6 +421,13 @@ namespace board
             /// param [in,out]:         Reference to variable in which new ADC reading is stored.
             /// returns: True if there is a new reading for specified analog index.
             bool value(size_t index, uint16_t& value);
+
+            /// Enables or disables scanning of specified analog index.
+            /// Disabled inputs are skipped by the ADC scan so that the enabled ones are sampled more often.
+            /// Change is applied once the current scan pass is completed.
+            /// param [in]: index   Analog index which should be enabled or disabled.
+            /// param [in]: state   New enable state.
+            void setEnabled(size_t index, bool state);
         }    // namespace analog
 
         namespace indicators
@@ -490,6 +513,13 @@ namespace board
         /// Used to write the contents of cache memory to flash.
         /// Should be used only if write was called with cacheOnly argument set to true.
         void writeCacheToFlash();
+
+        /// Performs single bounded step of background maintenance, such as moving
+        /// live values to another emulated EEPROM page, if supported by target.
+        /// Should be called from main loop.
+        /// param [in]: eraseAllowed    If set to false, steps which erase flash are postponed
+        ///                             since they stall the CPU the longest.
+        void update(bool eraseAllowed);
     }    // namespace nvm
 
     namespace ble
@@ -538,4 +568,20 @@ namespace board
         uint8_t readFlash(uint32_t address);
 #endif
     }    // namespace bootloader
+
+#ifdef OPENDECK_USE_PROFILER
+    namespace profiler
+    {
+        /// Starts free-running cycle counter used for profiling.
+        void init();
+
+        /// Returns current value of the cycle counter.
+        uint32_t cycles();
+
+        /// Returns amount of CPU cycles elapsed since specified counter value.
+        /// Accounts for counter wrap and resolution on architectures with narrow counters.
+        /// param [in]: start   Counter value returned by cycles().
+        uint32_t elapsed(uint32_t start);
+    }    // namespace profiler
+#endif
 }    // namespace board
\ No newline at end of file
@@ -0,0 +1,183 @@
+/*
+
+Copyright Igor Petrovic
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#pragma once
+
+#include <inttypes.h>
+#include <stddef.h>
+#include <type_traits>
+
+/// Deferred binary logger.
+/// Instead of formatting the message at the call site, only the format ID (hash of the
+/// format string) and raw arguments are stored into a ring buffer.
+/// Buffer is drained with low priority and decoded back to text on host (see src/tools/logdecode).
+namespace board::logger
+{
+    enum class source_t : uint8_t
+    {
+        BOARD,
+        APPLICATION,
+    };
+
+    enum class level_t : uint8_t
+    {
+        INFO,
+        WARNING,
+        ERROR,
+    };
+
+    enum class argType_t : uint8_t
+    {
+        INTEGER,
+        STRING,
+    };
+
+    /// Record layout:
+    /// [RECORD_SYNC][payload size][source << 4 | level][format ID, 4 bytes, LSB first][arguments]
+    /// Integer arguments are stored as type byte followed by 4 bytes (LSB first).
+    /// String arguments are stored as type byte followed by length byte and characters.
+    constexpr inline uint8_t RECORD_SYNC           = 0xA5;
+    constexpr inline size_t  RECORD_HEADER_SIZE    = 7;
+    constexpr inline size_t  MAX_RECORD_SIZE       = 64;
+    constexpr inline size_t  MAX_STRING_ARG_LENGTH = 16;
+
+    /// Calculates FNV-1a hash of the provided format string.
+    /// Used both in firmware and in host decoder so the two must stay in sync.
+    constexpr uint32_t formatId(const char* format)
+    {
+        uint32_t hash = 2166136261UL;
+
+        while (*format != '\0')
+        {
+            hash ^= static_cast<uint8_t>(*format++);
+            hash *= 16777619UL;
+        }
+
+        return hash;
+    }
+
+    /// Copies single record into the deferred log buffer.
+    /// Must be called from a single (main loop) context only.
+    /// param [in]: record  Pointer to record data.
+    /// param [in]: size    Size of the record.
+    /// returns: True if the record has been stored, false if the buffer is full and record was dropped.
+    bool write(const uint8_t* record, size_t size);
+
+    /// Reads pending bytes from the deferred log buffer.
+    /// Data is returned as continuous byte stream - records can be split between reads.
+    /// param [in]: buffer  Pointer to array in which read data will be stored.
+    /// param [in]: maxSize Maximum amount of bytes which can be stored in provided buffer.
+    /// returns: Amount of bytes stored in provided buffer.
+    size_t read(uint8_t* buffer, size_t maxSize);
+
+    /// Returns total amount of records dropped due to full buffer.
+    uint32_t dropped();
+
+    class Record
+    {
+        public:
+        Record(source_t source, level_t level, uint32_t id)
+        {
+            _data[0] = RECORD_SYNC;
+            _data[2] = (static_cast<uint8_t>(source) << 4) | static_cast<uint8_t>(level);
+            _data[3] = id & 0xFF;
+            _data[4] = (id >> 8) & 0xFF;
+            _data[5] = (id >> 16) & 0xFF;
+            _data[6] = (id >> 24) & 0xFF;
+        }
+
+        template<typename T>
+        void append(T value)
+        {
+            if constexpr (std::is_convertible_v<T, const char*>)
+            {
+                appendString(value);
+            }
+            else if constexpr (std::is_enum_v<T>)
+            {
+                appendInteger(static_cast<uint32_t>(static_cast<std::underlying_type_t<T>>(value)));
+            }
+            else
+            {
+                static_assert(std::is_integral_v<T>, "Unsupported deferred log argument");
+                appendInteger(static_cast<uint32_t>(value));
+            }
+        }
+
+        const uint8_t* data()
+        {
+            _data[1] = _size - 2;
+            return _data;
+        }
+
+        size_t size() const
+        {
+            return _size;
+        }
+
+        private:
+        uint8_t _data[MAX_RECORD_SIZE] = {};
+        size_t  _size                  = RECORD_HEADER_SIZE;
+
+        void appendInteger(uint32_t value)
+        {
+            if ((_size + 5) > MAX_RECORD_SIZE)
+            {
+                return;
+            }
+
+            _data[_size++] = static_cast<uint8_t>(argType_t::INTEGER);
+            _data[_size++] = value & 0xFF;
+            _data[_size++] = (value >> 8) & 0xFF;
+            _data[_size++] = (value >> 16) & 0xFF;
+            _data[_size++] = (value >> 24) & 0xFF;
+        }
+
+        void appendString(const char* value)
+        {
+            if ((_size + 2) > MAX_RECORD_SIZE)
+            {
+                return;
+            }
+
+            _data[_size++] = static_cast<uint8_t>(argType_t::STRING);
+
+            size_t lengthIndex = _size++;
+            size_t length      = 0;
+
+            while ((value != nullptr) && (value[length] != '\0') && (length < MAX_STRING_ARG_LENGTH) && (_size < MAX_RECORD_SIZE))
+            {
+                _data[_size++] = value[length++];
+            }
+
+            _data[lengthIndex] = length;
+        }
+    };
+
+    template<typename... Args>
+    inline void log(source_t source, level_t level, uint32_t id, Args... args)
+    {
+        Record record(source, level, id);
+        (record.append(args), ...);
+        write(record.data(), record.size());
+    }
+}    // namespace board::logger
+
+/// Format ID is forced to be calculated at compile time so that the format string never ends up in flash.
+#define DEFERRED_LOG(source, level, format, ...) \
+    board::logger::log(source, level, std::integral_constant<uint32_t, board::logger::formatId(format)>::value, ##__VA_ARGS__)
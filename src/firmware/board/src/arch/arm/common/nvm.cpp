@@ -16,9 +16,13 @@ limitations under the License.
 
 */
 
+#ifndef OPENDECK_USE_NVM_INCREMENTAL_TRANSFER
+
 #include "board/board.h"
 #include "internal.h"
 
+#include "common/nvm/emueeprom.h"
+
 #include "core/mcu.h"
 #include "lib/emueeprom/emueeprom.h"
 
@@ -99,84 +103,49 @@ namespace
     } hwaEmuEeprom;
 
     lib::emueeprom::EmuEEPROM emuEeprom(hwaEmuEeprom, true);
+
+#ifdef OPENDECK_USE_NVM_INDEX
+    // each record in emulated EEPROM page is 32-bit (16-bit address and 16-bit value)
+    // so this covers all the addresses which can be stored
+    constexpr size_t INDEX_SIZE = EMU_EEPROM_PAGE_SIZE / sizeof(uint32_t);
+#else
+    constexpr size_t INDEX_SIZE = 0;
+#endif
+
+    board::detail::nvm::EmuEeprom<INDEX_SIZE> storage(emuEeprom);
 }    // namespace
 
 namespace board::nvm
 {
     bool init()
     {
-        return emuEeprom.init();
+        return storage.init();
     }
 
     uint32_t size()
     {
-        return emuEeprom.maxAddress();
+        return storage.size();
     }
 
     bool read(uint32_t address, uint32_t& value, parameterType_t type)
     {
-        uint16_t tempData;
-
-        switch (type)
-        {
-        case parameterType_t::BYTE:
-        case parameterType_t::WORD:
-        {
-            auto readStatus = emuEeprom.read(address, tempData);
-            value           = tempData;
-
-            if (readStatus == lib::emueeprom::readStatus_t::OK)
-            {
-                value = tempData;
-            }
-            else if (readStatus == lib::emueeprom::readStatus_t::NO_VAR)
-            {
-                // variable with this address doesn't exist yet - set value to 0
-                value = 0;
-            }
-        }
-        break;
-
-        default:
-            return false;
-        }
-
-        return true;
+        return storage.read(address, value, type);
     }
 
     bool write(uint32_t address, uint32_t value, parameterType_t type, bool cacheOnly)
     {
-        uint16_t tempData;
-
-        switch (type)
-        {
-        case parameterType_t::BYTE:
-        case parameterType_t::WORD:
-        {
-            tempData = value;
-
-            if (emuEeprom.write(address, tempData, cacheOnly) != lib::emueeprom::writeStatus_t::OK)
-            {
-                return false;
-            }
-        }
-
-        break;
-
-        default:
-            return false;
-        }
-
-        return true;
+        return storage.write(address, value, type, cacheOnly);
     }
 
     bool clear(uint32_t start, uint32_t end)
     {
-        return emuEeprom.format();
+        return storage.clear();
     }
 
     void writeCacheToFlash()
     {
-        emuEeprom.writeCacheToFlash();
+        storage.writeCacheToFlash();
     }
-}    // namespace board::nvm
\ No newline at end of file
+}    // namespace board::nvm
+
+#endif
\ No newline at end of file
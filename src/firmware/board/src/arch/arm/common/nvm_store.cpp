@@ -0,0 +1,166 @@
+/*
+
+Copyright Igor Petrovic
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#ifdef OPENDECK_USE_NVM_INCREMENTAL_TRANSFER
+
+#include "board/board.h"
+#include "internal.h"
+#include "common/nvm/store.h"
+
+#include "core/mcu.h"
+
+#ifdef OPENDECK_USE_NVM_INDEX
+#include "common/nvm/index.h"
+#endif
+
+namespace
+{
+    constexpr size_t SECTORS = PROJECT_MCU_FLASH_PAGE_EEPROM_2 - PROJECT_MCU_FLASH_PAGE_EEPROM_1;
+
+    class HwaStore : public board::detail::nvm::StoreHwa
+    {
+        public:
+        HwaStore() = default;
+
+        bool eraseSector(size_t page, size_t sector) override
+        {
+            return core::mcu::flash::erasePage(FIRST_FLASH_PAGE(page) + sector);
+        }
+
+        bool write32(size_t page, uint32_t offset, uint32_t data) override
+        {
+            return core::mcu::flash::write32(core::mcu::flash::pageAddress(FIRST_FLASH_PAGE(page)) + offset, data);
+        }
+
+        bool read32(size_t page, uint32_t offset, uint32_t& data) override
+        {
+            return core::mcu::flash::read32(core::mcu::flash::pageAddress(FIRST_FLASH_PAGE(page)) + offset, data);
+        }
+
+        private:
+        static constexpr size_t FIRST_FLASH_PAGE(size_t page)
+        {
+            return page ? PROJECT_MCU_FLASH_PAGE_EEPROM_2 : PROJECT_MCU_FLASH_PAGE_EEPROM_1;
+        }
+    } hwaStore;
+
+    board::detail::nvm::Store<EMU_EEPROM_PAGE_SIZE, SECTORS> store(hwaStore);
+
+#ifdef OPENDECK_USE_NVM_INDEX
+    board::detail::nvm::Index<decltype(store)::SIZE> index;
+#endif
+}    // namespace
+
+namespace board::nvm
+{
+    bool init()
+    {
+#ifdef OPENDECK_USE_NVM_INDEX
+        index.clear();
+#endif
+
+        return store.init();
+    }
+
+    uint32_t size()
+    {
+        return decltype(store)::SIZE;
+    }
+
+    bool read(uint32_t address, uint32_t& value, parameterType_t type)
+    {
+        uint16_t tempData = 0;
+
+        switch (type)
+        {
+        case parameterType_t::BYTE:
+        case parameterType_t::WORD:
+        {
+#ifdef OPENDECK_USE_NVM_INDEX
+            if (index.get(address, tempData))
+            {
+                value = tempData;
+                break;
+            }
+#endif
+
+            // variable with this address doesn't exist yet - set value to 0
+            value = store.read(address, tempData) ? tempData : 0;
+
+#ifdef OPENDECK_USE_NVM_INDEX
+            index.set(address, value);
+#endif
+        }
+        break;
+
+        default:
+            return false;
+        }
+
+        return true;
+    }
+
+    bool write(uint32_t address, uint32_t value, parameterType_t type, bool cacheOnly)
+    {
+        // There's no write cache: writes are cheap since the transfer is done in steps from update().
+        switch (type)
+        {
+        case parameterType_t::BYTE:
+        case parameterType_t::WORD:
+        {
+            if (!store.write(address, value))
+            {
+#ifdef OPENDECK_USE_NVM_INDEX
+                index.invalidate(address);
+#endif
+                return false;
+            }
+
+#ifdef OPENDECK_USE_NVM_INDEX
+            index.set(address, value);
+#endif
+        }
+        break;
+
+        default:
+            return false;
+        }
+
+        return true;
+    }
+
+    bool clear(uint32_t start, uint32_t end)
+    {
+#ifdef OPENDECK_USE_NVM_INDEX
+        index.clear();
+#endif
+
+        return store.format();
+    }
+
+    void writeCacheToFlash()
+    {
+    }
+
+    void update(bool eraseAllowed)
+    {
+        store.update(eraseAllowed);
+    }
+}    // namespace board::nvm
+
+#endif
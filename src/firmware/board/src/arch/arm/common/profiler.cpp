@@ -0,0 +1,66 @@
+/*
+
+Copyright Igor Petrovic
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#ifdef OPENDECK_USE_PROFILER
+#ifdef OPENDECK_FW_APP
+
+#include "board/board.h"
+
+#include <inttypes.h>
+
+#if !defined(__ARM_ARCH_7M__) && !defined(__ARM_ARCH_7EM__) && !defined(__ARM_ARCH_8M_MAIN__)
+#error "Profiler requires DWT cycle counter which isn't available on this core"
+#endif
+
+namespace
+{
+    // registers are accessed directly so that profiling doesn't depend on vendor headers
+    constexpr uint32_t DEMCR_ADDRESS      = 0xE000EDFC;
+    constexpr uint32_t DWT_CTRL_ADDRESS   = 0xE0001000;
+    constexpr uint32_t DWT_CYCCNT_ADDRESS = 0xE0001004;
+    constexpr uint32_t DEMCR_TRCENA       = 1UL << 24;
+    constexpr uint32_t DWT_CTRL_CYCCNTENA = 1UL << 0;
+
+    inline volatile uint32_t& reg(uint32_t address)
+    {
+        return *reinterpret_cast<volatile uint32_t*>(address);
+    }
+}    // namespace
+
+namespace board::profiler
+{
+    void init()
+    {
+        reg(DEMCR_ADDRESS) |= DEMCR_TRCENA;
+        reg(DWT_CYCCNT_ADDRESS) = 0;
+        reg(DWT_CTRL_ADDRESS) |= DWT_CTRL_CYCCNTENA;
+    }
+
+    uint32_t cycles()
+    {
+        return reg(DWT_CYCCNT_ADDRESS);
+    }
+
+    uint32_t elapsed(uint32_t start)
+    {
+        return reg(DWT_CYCCNT_ADDRESS) - start;
+    }
+}    // namespace board::profiler
+
+#endif
+#endif
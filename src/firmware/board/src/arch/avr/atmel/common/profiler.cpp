@@ -0,0 +1,56 @@
+/*
+
+Copyright Igor Petrovic
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#ifdef OPENDECK_USE_PROFILER
+#ifdef OPENDECK_FW_APP
+
+#include "board/board.h"
+
+#include <avr/io.h>
+
+// Timer1 is reserved for profiling when profiler is enabled.
+// It runs freely with prescaler of 8 which gives 16-bit window of 524288 CPU cycles
+// (32ms at 16MHz) - long enough for any single main loop section.
+
+namespace
+{
+    constexpr uint32_t PRESCALER = 8;
+}
+
+namespace board::profiler
+{
+    void init()
+    {
+        TCCR1A = 0;
+        TCCR1B = (1 << CS11);
+        TCNT1  = 0;
+    }
+
+    uint32_t cycles()
+    {
+        return TCNT1;
+    }
+
+    uint32_t elapsed(uint32_t start)
+    {
+        return static_cast<uint32_t>(static_cast<uint16_t>(TCNT1 - static_cast<uint16_t>(start))) * PRESCALER;
+    }
+}    // namespace board::profiler
+
+#endif
+#endif
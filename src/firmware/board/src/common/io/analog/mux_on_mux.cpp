@@ -21,6 +21,7 @@ limitations under the License.
 
 #include "board/board.h"
 #include "internal.h"
+#include "scan_list.h"
 #include <target.h>
 
 #include "core/util/util.h"
@@ -33,13 +34,14 @@ static_assert(PROJECT_MCU_ADC_SAMPLES > 0, "At least 1 ADC sample required");
 
 namespace
 {
-    constexpr size_t  ANALOG_IN_BUFFER_SIZE = PROJECT_TARGET_MAX_NR_OF_ANALOG_INPUTS;
-    uint8_t           analogIndex;
-    volatile uint16_t analogBuffer[ANALOG_IN_BUFFER_SIZE];
-    uint8_t           activeMux;
-    uint8_t           activeMuxInput;
-    volatile uint16_t sample;
-    volatile uint8_t  sampleCounter;
+    constexpr size_t                ANALOG_IN_BUFFER_SIZE = PROJECT_TARGET_MAX_NR_OF_ANALOG_INPUTS;
+    ScanList<ANALOG_IN_BUFFER_SIZE> scanList;
+    uint8_t                         activeChannel;
+    volatile uint16_t               analogBuffer[ANALOG_IN_BUFFER_SIZE];
+    uint8_t                         activeMux;
+    uint8_t                         activeMuxInput;
+    volatile uint16_t               sample;
+    volatile uint8_t                sampleCounter;
 
     /// Configures one of 16 inputs/outputs on 4067 multiplexer.
     inline void setMuxInput()
@@ -61,6 +63,23 @@ namespace
         CORE_MCU_IO_SET_STATE(PIN_PORT_MUX_CTRL_S3, PIN_INDEX_MUX_CTRL_S3, core::util::BIT_READ(activeMux, 3));
 #endif
     }
+
+    /// Switches multiplexer and its input to the specified channel.
+    inline void selectChannel(uint8_t channel)
+    {
+        uint8_t mux = channel / PROJECT_TARGET_NR_OF_MUX_INPUTS;
+
+        activeChannel  = channel;
+        activeMuxInput = channel % PROJECT_TARGET_NR_OF_MUX_INPUTS;
+
+        if (mux != activeMux)
+        {
+            activeMux = mux;
+            setMux();
+        }
+
+        setMuxInput();
+    }
 }    // namespace
 
 namespace board::detail::io::analog
@@ -134,6 +153,7 @@ namespace board::detail::io::analog
         }
 
         core::mcu::adc::setActivePin(map::ADC_PIN(0));
+        selectChannel(scanList.next());
         core::mcu::adc::enableIt(board::detail::io::analog::ISR_PRIORITY);
         core::mcu::adc::startItConversion();
     }
@@ -150,33 +170,21 @@ namespace board::detail::io::analog
 
             if (++sampleCounter == (PROJECT_MCU_ADC_SAMPLES + 1))
             {
-                sample /= PROJECT_MCU_ADC_SAMPLES;
-                analogBuffer[analogIndex] = sample;
-                analogBuffer[analogIndex] |= ADC_NEW_READING_FLAG;
+                // round instead of truncating so that the average isn't biased towards lower values
+                sample = (sample + (PROJECT_MCU_ADC_SAMPLES / 2)) / PROJECT_MCU_ADC_SAMPLES;
+                scanList.reading(activeChannel, analogBuffer[activeChannel] & ~ADC_NEW_READING_FLAG, sample);
+                analogBuffer[activeChannel] = sample;
+                analogBuffer[activeChannel] |= ADC_NEW_READING_FLAG;
                 sample        = 0;
                 sampleCounter = 0;
-                analogIndex++;
-                activeMuxInput++;
 
-                bool switchMux = (activeMuxInput == PROJECT_TARGET_NR_OF_MUX_INPUTS);
+                uint8_t channel = scanList.next();
 
-                if (switchMux)
+                // same channel is returned when it's the only enabled one
+                if (channel != activeChannel)
                 {
-                    activeMuxInput = 0;
-                    activeMux++;
-
-                    if (activeMux == PROJECT_TARGET_NR_OF_MUX)
-                    {
-                        activeMux   = 0;
-                        analogIndex = 0;
-                    }
-
-                    // switch to next mux once all mux inputs are read
-                    setMux();
+                    selectChannel(channel);
                 }
-
-                // always switch to next read pin
-                setMuxInput();
             }
         }
 
@@ -21,6 +21,7 @@ limitations under the License.
 
 #include "board/board.h"
 #include "internal.h"
+#include "scan_list.h"
 #include <target.h>
 
 #include "core/util/util.h"
@@ -33,11 +34,12 @@ static_assert(PROJECT_MCU_ADC_SAMPLES > 0, "At least 1 ADC sample required");
 
 namespace
 {
-    constexpr size_t  ANALOG_IN_BUFFER_SIZE = PROJECT_TARGET_MAX_NR_OF_ANALOG_INPUTS;
-    uint8_t           analogIndex;
-    volatile uint16_t analogBuffer[ANALOG_IN_BUFFER_SIZE];
-    volatile uint16_t sample;
-    volatile uint8_t  sampleCounter;
+    constexpr size_t                ANALOG_IN_BUFFER_SIZE = PROJECT_TARGET_MAX_NR_OF_ANALOG_INPUTS;
+    ScanList<ANALOG_IN_BUFFER_SIZE> scanList;
+    uint8_t                         activeChannel;
+    volatile uint16_t               analogBuffer[ANALOG_IN_BUFFER_SIZE];
+    volatile uint16_t               sample;
+    volatile uint8_t                sampleCounter;
 }    // namespace
 
 namespace board::detail::io::analog
@@ -69,7 +71,8 @@ namespace board::detail::io::analog
             core::mcu::adc::read(map::ADC_PIN(0));
         }
 
-        core::mcu::adc::setActivePin(map::ADC_PIN(0));
+        activeChannel = scanList.next();
+        core::mcu::adc::setActivePin(map::ADC_PIN(activeChannel));
         core::mcu::adc::enableIt(board::detail::io::analog::ISR_PRIORITY);
         core::mcu::adc::startItConversion();
     }
@@ -86,20 +89,22 @@ namespace board::detail::io::analog
 
             if (++sampleCounter == (PROJECT_MCU_ADC_SAMPLES + 1))
             {
-                sample /= PROJECT_MCU_ADC_SAMPLES;
-                analogBuffer[analogIndex] = sample;
-                analogBuffer[analogIndex] |= ADC_NEW_READING_FLAG;
+                // round instead of truncating so that the average isn't biased towards lower values
+                sample = (sample + (PROJECT_MCU_ADC_SAMPLES / 2)) / PROJECT_MCU_ADC_SAMPLES;
+                scanList.reading(activeChannel, analogBuffer[activeChannel] & ~ADC_NEW_READING_FLAG, sample);
+                analogBuffer[activeChannel] = sample;
+                analogBuffer[activeChannel] |= ADC_NEW_READING_FLAG;
                 sample        = 0;
                 sampleCounter = 0;
-                analogIndex++;
 
-                if (analogIndex == PROJECT_TARGET_MAX_NR_OF_ANALOG_INPUTS)
+                uint8_t channel = scanList.next();
+
+                // same channel is returned when it's the only enabled one
+                if (channel != activeChannel)
                 {
-                    analogIndex = 0;
+                    activeChannel = channel;
+                    core::mcu::adc::setActivePin(map::ADC_PIN(activeChannel));
                 }
-
-                // always switch to next read pin
-                core::mcu::adc::setActivePin(map::ADC_PIN(analogIndex));
             }
         }
 
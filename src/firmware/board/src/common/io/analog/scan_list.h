@@ -0,0 +1,199 @@
+/*
+
+Copyright Igor Petrovic
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#pragma once
+
+#include "board/board.h"
+#include "internal.h"
+
+#include <inttypes.h>
+#include <stddef.h>
+
+namespace board::detail::io::analog
+{
+    /// List of enabled analog channels scanned by the ADC ISR.
+    /// Enable state is changed from main context, while the list itself is rebuilt by the ISR
+    /// once the current pass is completed so that the scan order is never changed mid-pass.
+    /// With PROJECT_TARGET_ADC_ACTIVITY_SCAN, every other conversion is spent on channels which
+    /// have recently moved, so that moving inputs are sampled more often without any extra ADC load.
+    template<size_t Size>
+    class ScanList
+    {
+        public:
+        static_assert(Size <= 0xFF, "Channel index must fit into single byte");
+
+        /// Sets the enable state of the specified channel.
+        /// Change is applied once the ISR completes the current pass.
+        void setEnabled(size_t channel, bool state)
+        {
+            if (channel >= Size)
+            {
+                return;
+            }
+
+            CORE_MCU_ATOMIC_SECTION
+            {
+                if (state)
+                {
+                    _disabled[channel / 8] &= ~(1 << (channel % 8));
+                }
+                else
+                {
+                    _disabled[channel / 8] |= (1 << (channel % 8));
+                }
+
+                _dirty = true;
+            }
+        }
+
+        /// Returns the channel which should be scanned next.
+        /// Must be called from ISR only.
+        uint8_t next()
+        {
+#ifdef PROJECT_TARGET_ADC_ACTIVITY_SCAN
+            _serveActive = !_serveActive;
+
+            if (_serveActive && _activeCount)
+            {
+                if (_activeCursor >= _activeCount)
+                {
+                    _activeCursor = 0;
+                }
+
+                return _active[_activeCursor++];
+            }
+#endif
+
+            if (_position >= _size)
+            {
+                _position = 0;
+
+                if (_dirty)
+                {
+                    rebuild();
+                }
+            }
+
+            // nothing enabled: keep converting first channel, readings are ignored by application
+            if (!_size)
+            {
+                return 0;
+            }
+
+            return _list[_position++];
+        }
+
+        /// Tracks activity of the channel based on difference between previous and new reading.
+        /// Must be called from ISR only.
+        void reading(uint8_t channel, uint16_t previous, uint16_t value)
+        {
+#ifdef PROJECT_TARGET_ADC_ACTIVITY_SCAN
+            uint16_t difference = value > previous ? value - previous : previous - value;
+
+            if (difference >= ACTIVITY_THRESHOLD)
+            {
+                if (!_activity[channel])
+                {
+                    if (_activeCount == MAX_ACTIVE_CHANNELS)
+                    {
+                        return;
+                    }
+
+                    _active[_activeCount++] = channel;
+                }
+
+                _activity[channel] = ACTIVITY_HOLD_READINGS;
+            }
+            else if (_activity[channel])
+            {
+                if (!--_activity[channel])
+                {
+                    removeActive(channel);
+                }
+            }
+#else
+            static_cast<void>(channel);
+            static_cast<void>(previous);
+            static_cast<void>(value);
+#endif
+        }
+
+        private:
+#ifdef PROJECT_TARGET_ADC_ACTIVITY_SCAN
+        /// Maximum amount of channels which are scanned with priority at the same time.
+        static constexpr uint8_t MAX_ACTIVE_CHANNELS = 8;
+
+        /// Minimum difference between two readings after which the channel is considered moving (single 7-bit step).
+        static constexpr uint16_t ACTIVITY_THRESHOLD = (CORE_MCU_ADC_MAX_VALUE + 1) / 128;
+
+        /// Amount of readings without movement after which the channel is returned to regular scanning.
+        static constexpr uint8_t ACTIVITY_HOLD_READINGS = 255;
+
+        uint8_t _active[MAX_ACTIVE_CHANNELS] = {};
+        uint8_t _activeCount                 = 0;
+        uint8_t _activeCursor                = 0;
+        uint8_t _activity[Size]              = {};
+        bool    _serveActive                 = false;
+
+        void removeActive(uint8_t channel)
+        {
+            for (uint8_t i = 0; i < _activeCount; i++)
+            {
+                if (_active[i] == channel)
+                {
+                    _active[i] = _active[--_activeCount];
+                    break;
+                }
+            }
+
+            _activity[channel] = 0;
+        }
+#endif
+
+        volatile uint8_t _disabled[(Size / 8) + 1] = {};
+        volatile bool    _dirty                    = true;
+        uint8_t          _list[Size]               = {};
+        size_t           _size                     = 0;
+        size_t           _position                 = 0;
+
+        bool enabled(size_t channel)
+        {
+            return !(_disabled[channel / 8] & (1 << (channel % 8)));
+        }
+
+        void rebuild()
+        {
+            _dirty = false;
+            _size  = 0;
+
+            for (size_t channel = 0; channel < Size; channel++)
+            {
+                if (enabled(channel))
+                {
+                    _list[_size++] = channel;
+                }
+#ifdef PROJECT_TARGET_ADC_ACTIVITY_SCAN
+                else if (_activity[channel])
+                {
+                    removeActive(channel);
+                }
+#endif
+            }
+        }
+    };
+}    // namespace board::detail::io::analog
@@ -0,0 +1,242 @@
+/*
+
+Copyright Igor Petrovic
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#pragma once
+
+#include <inttypes.h>
+#include <stddef.h>
+#include <type_traits>
+
+namespace board::detail::io::digital_in
+{
+    /// Captures the time between closing of two contacts of dual-contact keys in button matrix.
+    /// Contacts of a single key are placed in the same column: first contact in even row and
+    /// second contact in the next (odd) row, same as A and B components of encoders. Timing starts
+    /// once the first contact closes and the interval is captured once the second one closes.
+    /// Key can be struck again without releasing it completely, once the second contact has stayed
+    /// open for at least RELEASE_HOLD_TIME. Shorter openings of the second contact are treated as
+    /// bouncing, as are openings of the first contact shorter than DEBOUNCE_TIME: neither of them
+    /// restarts the timing. Captured interval is kept until it's retrieved, even if the key is
+    /// released in the meantime.
+    template<size_t Columns, size_t Rows>
+    class ContactTiming
+    {
+        public:
+        using rowMask_t = std::conditional_t<(Rows <= 8), uint8_t, std::conditional_t<(Rows <= 16), uint16_t, uint32_t>>;
+
+        static_assert(Rows <= 32, "Unsupported amount of matrix rows");
+
+        /// Time in microseconds for which the opened first contact is considered to be bouncing.
+        static constexpr uint32_t DEBOUNCE_TIME = 1000;
+
+        /// Time in microseconds for which the second contact needs to stay open before the key can be struck again.
+        static constexpr uint32_t RELEASE_HOLD_TIME = 2000;
+
+        /// Processes single scan of the column.
+        /// param [in]: column  Scanned column.
+        /// param [in]: rows    Mask of rows which are active (closed) in this column.
+        /// param [in]: time    Time of the scan in microseconds.
+        void scan(size_t column, rowMask_t rows, uint32_t time)
+        {
+            rowMask_t changed = rows ^ _last[column];
+
+            if (!changed)
+            {
+                return;
+            }
+
+            _last[column] = rows;
+
+            for (size_t pair = 0; pair < PAIRS; pair++)
+            {
+                if (!((changed >> (pair * 2)) & 0x03))
+                {
+                    continue;
+                }
+
+                bool first  = (rows >> (pair * 2)) & 0x01;
+                bool second = (rows >> (pair * 2 + 1)) & 0x01;
+
+                update(_keys[pair][column], first, second, time);
+            }
+        }
+
+        /// Retrieves the captured interval of the key.
+        /// Interval belongs to the key as a whole, so it's reported only via the row of the
+        /// first contact: this way it's retrieved once even if both contacts are polled.
+        /// Must not be interrupted by scan().
+        /// param [in]:  row       Row of the first contact of the key.
+        /// param [in]:  column    Column of the key.
+        /// param [out]: interval  Time in microseconds between closing of the two contacts.
+        /// returns: True if the new interval has been captured since the last call.
+        bool interval(size_t row, size_t column, uint32_t& interval)
+        {
+            if ((row % 2) || ((row / 2) >= PAIRS))
+            {
+                return false;
+            }
+
+            auto& key = _keys[row / 2][column];
+
+            if (!(key.state & PENDING))
+            {
+                return false;
+            }
+
+            key.state &= ~PENDING;
+            interval = key.interval;
+
+            return true;
+        }
+
+        private:
+        enum state_t : uint8_t
+        {
+            OPEN,             ///< Both contacts are open.
+            FIRST,            ///< First contact is closed, key is moving towards the second one.
+            FIRST_OPENED,     ///< First contact has opened, possibly only bouncing.
+            CLOSED,           ///< Both contacts have been closed.
+            SECOND_OPENED,    ///< Second contact has opened, possibly only bouncing.
+            STATE_MASK = 0x07,
+            PENDING    = 0x80,    ///< Captured interval hasn't been retrieved yet.
+        };
+
+        struct Key
+        {
+            uint32_t start    = 0;    ///< Time from which the strike is timed.
+            uint32_t opened   = 0;    ///< Time at which the contact has opened in *_OPENED states.
+            uint32_t interval = 0;    ///< Last captured interval.
+            uint8_t  state    = OPEN;
+        };
+
+        static constexpr size_t PAIRS = Rows / 2;
+
+        rowMask_t _last[Columns]       = {};
+        Key       _keys[PAIRS][Columns] = {};
+
+        static void update(Key& key, bool first, bool second, uint32_t time)
+        {
+            uint8_t pending = key.state & PENDING;
+
+            switch (key.state & STATE_MASK)
+            {
+            case OPEN:
+            {
+                if (!first)
+                {
+                    break;
+                }
+
+                key.start = time;
+                closeFirst(key, second, time, pending);
+            }
+            break;
+
+            case FIRST:
+            {
+                if (!first)
+                {
+                    key.opened = time;
+                    key.state  = FIRST_OPENED | pending;
+                }
+                else if (second)
+                {
+                    capture(key, time);
+                }
+            }
+            break;
+
+            case FIRST_OPENED:
+            {
+                if (!first)
+                {
+                    break;
+                }
+
+                if ((time - key.opened) >= DEBOUNCE_TIME)
+                {
+                    // it wasn't bouncing: key has been released and this is a new strike
+                    key.start = time;
+                }
+
+                closeFirst(key, second, time, pending);
+            }
+            break;
+
+            case CLOSED:
+            {
+                if (!first)
+                {
+                    key.state = OPEN | pending;
+                }
+                else if (!second)
+                {
+                    key.opened = time;
+                    key.state  = SECOND_OPENED | pending;
+                }
+            }
+            break;
+
+            case SECOND_OPENED:
+            {
+                if (!first)
+                {
+                    key.state = OPEN | pending;
+                }
+                else if (second)
+                {
+                    if ((time - key.opened) < RELEASE_HOLD_TIME)
+                    {
+                        // bouncing: key hasn't been struck again
+                        key.state = CLOSED | pending;
+                    }
+                    else
+                    {
+                        // partially released and struck again: timed from the opening of the second contact
+                        key.start = key.opened;
+                        capture(key, time);
+                    }
+                }
+            }
+            break;
+
+            default:
+                break;
+            }
+        }
+
+        static void closeFirst(Key& key, bool second, uint32_t time, uint8_t pending)
+        {
+            if (second)
+            {
+                // both contacts closed within the same scan
+                capture(key, time);
+            }
+            else
+            {
+                key.state = FIRST | pending;
+            }
+        }
+
+        static void capture(Key& key, uint32_t time)
+        {
+            key.interval = time - key.start;
+            key.state    = CLOSED | PENDING;
+        }
+    };
+}    // namespace board::detail::io::digital_in
@@ -0,0 +1,143 @@
+/*
+
+Copyright Igor Petrovic
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#pragma once
+
+#include "board/board.h"
+
+#include <inttypes.h>
+#include <stddef.h>
+#include <string.h>
+#include <type_traits>
+
+namespace board::detail::io::digital_in
+{
+    /// Column-major packed history of button matrix scans.
+    /// Each scan of a column is stored as a single mask holding the state of all rows,
+    /// so that the ISR doesn't need to touch per-key buffers. Per-key readings are
+    /// transposed from the history only once requested.
+    template<size_t Columns, size_t Rows>
+    class MatrixHistory
+    {
+        public:
+        using rowMask_t = std::conditional_t<(Rows <= 8), uint8_t, std::conditional_t<(Rows <= 16), uint16_t, uint32_t>>;
+
+        static_assert(Rows <= 32, "Unsupported amount of matrix rows");
+
+        /// Amount of scans kept for each column - matches the amount of readings in Readings structure.
+        static constexpr size_t DEPTH = 8 * sizeof(board::io::digital_in::Readings::readings);
+
+        static_assert((DEPTH & (DEPTH - 1)) == 0, "History depth must be power of two");
+
+        /// Stores single scan of the column.
+        /// param [in]: column  Scanned column.
+        /// param [in]: rows    Mask of rows which are active (pressed) in this column.
+        void store(size_t column, rowMask_t rows)
+        {
+            auto& history = _columns[column];
+
+            history.scans[history.head] = rows;
+            history.head                = (history.head + 1) & (DEPTH - 1);
+            history.total++;
+        }
+
+        /// Copy of column scans needed to produce the readings of a single key.
+        struct Snapshot
+        {
+            rowMask_t scans[DEPTH] = {};
+            uint8_t   head         = 0;
+            uint16_t  newCount     = 0;
+        };
+
+        /// Copies stored scans of the column and marks them as consumed for single key.
+        /// Must not be interrupted by store(). Only copies the scans so that the caller can keep
+        /// interrupts disabled for as short as possible and transpose the snapshot afterwards.
+        /// param [in]:     row         Row of the key.
+        /// param [in]:     column      Column of the key.
+        /// param [in,out]: snapshot    Copy of the column scans and the amount of readings since the last call.
+        void snapshot(size_t row, size_t column, Snapshot& snapshot)
+        {
+            auto& history = _columns[column];
+
+            memcpy(snapshot.scans, history.scans, sizeof(snapshot.scans));
+
+            snapshot.head          = history.head;
+            snapshot.newCount      = history.total - _consumed[row][column];
+            _consumed[row][column] = history.total;
+        }
+
+        /// Transposes column snapshot into readings for single key.
+        /// param [in]:     snapshot    Snapshot of the key column.
+        /// param [in]:     row         Row of the key.
+        /// param [in,out]: readings    Last DEPTH readings of the key and the amount of readings since the last snapshot.
+        /// returns: True if there are new readings for the key.
+        static bool transpose(const Snapshot& snapshot, size_t row, board::io::digital_in::Readings& readings)
+        {
+            readings.count    = snapshot.newCount > DEPTH ? DEPTH : snapshot.newCount;
+            readings.readings = 0;
+
+            // LSB is the newest reading
+            for (size_t i = 0; i < DEPTH; i++)
+            {
+                auto scan = snapshot.scans[(snapshot.head - 1 - i) & (DEPTH - 1)];
+                readings.readings |= static_cast<decltype(readings.readings)>((scan >> row) & 0x01) << i;
+            }
+
+            return readings.count > 0;
+        }
+
+        /// Transposes stored scans into readings for single key.
+        /// Must not be interrupted by store().
+        /// param [in]:     row         Row of the key.
+        /// param [in]:     column      Column of the key.
+        /// param [in,out]: readings    Last DEPTH readings of the key and the amount of readings since the last call.
+        /// returns: True if there are new readings for the key.
+        bool state(size_t row, size_t column, board::io::digital_in::Readings& readings)
+        {
+            Snapshot columnSnapshot;
+            snapshot(row, column, columnSnapshot);
+
+            return transpose(columnSnapshot, row, readings);
+        }
+
+        /// Marks all stored readings as consumed.
+        void flush()
+        {
+            for (size_t row = 0; row < Rows; row++)
+            {
+                for (size_t column = 0; column < Columns; column++)
+                {
+                    _consumed[row][column] = _columns[column].total;
+                }
+            }
+        }
+
+        private:
+        struct Column
+        {
+            rowMask_t scans[DEPTH] = {};
+            uint8_t   head         = 0;
+
+            // free-running scan counter: wraps together with the consumed counters
+            uint16_t total = 0;
+        };
+
+        Column   _columns[Columns]        = {};
+        uint16_t _consumed[Rows][Columns] = {};
+    };
+}    // namespace board::detail::io::digital_in
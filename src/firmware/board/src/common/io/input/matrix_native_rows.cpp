@@ -21,8 +21,14 @@ limitations under the License.
 
 #include "board/board.h"
 #include "internal.h"
+#include "matrix_history.h"
+#include "matrix_rows.h"
 #include <target.h>
 
+#ifdef OPENDECK_USE_DUAL_CONTACT_KEYS
+#include "contact_timing.h"
+#endif
+
 #include "core/util/util.h"
 #include "core/util/ring_buffer.h"
 
@@ -36,8 +42,23 @@ using namespace board::detail::io::digital_in;
 
 namespace
 {
-    volatile Readings digitalInBuffer[PROJECT_TARGET_MAX_NR_OF_DIGITAL_INPUTS];
-    volatile uint8_t  activeInColumn;
+    using History = MatrixHistory<PROJECT_TARGET_NR_OF_BUTTON_COLUMNS, PROJECT_TARGET_NR_OF_BUTTON_ROWS>;
+
+    // accessed from main loop only within atomic sections
+    History          history;
+    volatile uint8_t activeInColumn;
+
+    // rows grouped by port at compile time so that the ISR doesn't test them one by one
+    constexpr MatrixRows<PROJECT_TARGET_NR_OF_BUTTON_ROWS> MATRIX_ROWS(map::BUTTON_PORT_INDEX, map::BUTTON_PIN_INDEX);
+
+#ifdef OPENDECK_USE_DUAL_CONTACT_KEYS
+    using ContactTiming = board::detail::io::digital_in::ContactTiming<PROJECT_TARGET_NR_OF_BUTTON_COLUMNS, PROJECT_TARGET_NR_OF_BUTTON_ROWS>;
+
+    // accessed from main loop only within atomic sections
+    ContactTiming contactTiming;
+    uint32_t      scanTime;
+    uint8_t       fastScanCounter;
+#endif
 
     inline void activateInputColumn()
     {
@@ -53,25 +74,43 @@ namespace
 
     inline void storeDigitalIn()
     {
+#ifdef OPENDECK_USE_DUAL_CONTACT_KEYS
+        // matrix is scanned every FAST_SCAN_TIMEOUT_US so that the contacts can be timestamped,
+        // while the readings are still stored once per millisecond
+        scanTime += FAST_SCAN_TIMEOUT_US;
+
+        bool storeReadings = ++fastScanCounter == FAST_SCANS_PER_READING;
+
+        if (storeReadings)
+        {
+            fastScanCounter = 0;
+        }
+#endif
+
         for (uint8_t column = 0; column < PROJECT_TARGET_NR_OF_BUTTON_COLUMNS; column++)
         {
             activateInputColumn();
 
-            core::mcu::io::pin_t pin;
+            // read all row ports at once instead of reading pin by pin to reduce the time spent in ISR
+            core::mcu::io::portWidth_t portState[PROJECT_TARGET_NR_OF_DIGITAL_INPUT_PORTS];
 
-            for (uint8_t row = 0; row < PROJECT_TARGET_NR_OF_BUTTON_ROWS; row++)
+            for (uint8_t portIndex = 0; portIndex < PROJECT_TARGET_NR_OF_DIGITAL_INPUT_PORTS; portIndex++)
             {
-                size_t index = (row * PROJECT_TARGET_NR_OF_BUTTON_COLUMNS) + column;
-                pin          = map::BUTTON_PIN(row);
+                portState[portIndex] = CORE_MCU_IO_READ_IN_PORT(map::DIGITAL_IN_PORT(portIndex));
+            }
+
+            auto rows = static_cast<History::rowMask_t>(MATRIX_ROWS.read(portState));
 
-                digitalInBuffer[index].readings <<= 1;
-                digitalInBuffer[index].readings |= !CORE_MCU_IO_READ(pin.port, pin.index);
+#ifdef OPENDECK_USE_DUAL_CONTACT_KEYS
+            contactTiming.scan(column, rows, scanTime);
 
-                if (++digitalInBuffer[index].count > MAX_READING_COUNT)
-                {
-                    digitalInBuffer[index].count = MAX_READING_COUNT;
-                }
+            if (!storeReadings)
+            {
+                continue;
             }
+#endif
+
+            history.store(column, rows);
         }
     }
 }    // namespace
@@ -123,14 +162,18 @@ namespace board::io::digital_in
 
         index = map::BUTTON_INDEX(index);
 
+        const size_t ROW    = index / PROJECT_TARGET_NR_OF_BUTTON_COLUMNS;
+        const size_t COLUMN = index % PROJECT_TARGET_NR_OF_BUTTON_COLUMNS;
+
+        History::Snapshot snapshot;
+
+        // only copy the scans while the ISR is blocked: transposing is done afterwards
         CORE_MCU_ATOMIC_SECTION
         {
-            readings.count               = digitalInBuffer[index].count;
-            readings.readings            = digitalInBuffer[index].readings;
-            digitalInBuffer[index].count = 0;
+            history.snapshot(ROW, COLUMN, snapshot);
         }
 
-        return readings.count > 0;
+        return History::transpose(snapshot, ROW, readings);
     }
 
     size_t encoderFromInput(size_t index)
@@ -159,9 +202,46 @@ namespace board::io::digital_in
 
         return index + PROJECT_TARGET_NR_OF_BUTTON_COLUMNS;
     }
+
+#ifdef OPENDECK_USE_DUAL_CONTACT_KEYS
+    bool contactInterval(size_t index, uint32_t& interval)
+    {
+        if (index >= PROJECT_TARGET_MAX_NR_OF_DIGITAL_INPUTS)
+        {
+            return false;
+        }
+
+        index = map::BUTTON_INDEX(index);
+
+        bool captured = false;
+
+        CORE_MCU_ATOMIC_SECTION
+        {
+            captured = contactTiming.interval(index / PROJECT_TARGET_NR_OF_BUTTON_COLUMNS,
+                                              index % PROJECT_TARGET_NR_OF_BUTTON_COLUMNS,
+                                              interval);
+        }
+
+        return captured;
+    }
+#endif
 }    // namespace board::io::digital_in
 
-#include "common.cpp.include"
+namespace board::detail::io::digital_in
+{
+    void update()
+    {
+        storeDigitalIn();
+    }
+
+    void flush()
+    {
+        CORE_MCU_ATOMIC_SECTION
+        {
+            history.flush();
+        }
+    }
+}    // namespace board::detail::io::digital_in
 
 #endif
 #endif
\ No newline at end of file
@@ -0,0 +1,102 @@
+/*
+
+Copyright Igor Petrovic
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#pragma once
+
+#include <inttypes.h>
+#include <stddef.h>
+
+namespace board::detail::io::digital_in
+{
+    /// Extracts the state of all matrix rows from the input port states.
+    /// Rows on the same port with the same distance between pin and row index are grouped,
+    /// so that each group is moved into the row mask with a single mask and shift instead of
+    /// testing the rows one by one. With rows wired to consecutive pins, there's one group per port.
+    template<size_t Rows>
+    class MatrixRows
+    {
+        public:
+        /// param [in]: portIndex   Callable returning the index of the port to which given row is connected.
+        /// param [in]: pinIndex    Callable returning the pin index of given row within its port.
+        template<typename PortIndex, typename PinIndex>
+        constexpr MatrixRows(PortIndex portIndex, PinIndex pinIndex)
+        {
+            for (size_t row = 0; row < Rows; row++)
+            {
+                const uint8_t PORT  = portIndex(row);
+                const uint8_t PIN   = pinIndex(row);
+                const int     DELTA = static_cast<int>(PIN) - static_cast<int>(row);
+
+                size_t group = 0;
+
+                for (; group < _size; group++)
+                {
+                    if ((_groups[group].port == PORT) && ((_groups[group].rightShift - _groups[group].leftShift) == DELTA))
+                    {
+                        break;
+                    }
+                }
+
+                if (group == _size)
+                {
+                    _groups[group].port       = PORT;
+                    _groups[group].rightShift = DELTA > 0 ? DELTA : 0;
+                    _groups[group].leftShift  = DELTA < 0 ? -DELTA : 0;
+                    _size++;
+                }
+
+                _groups[group].pinMask |= static_cast<uint32_t>(1) << PIN;
+            }
+        }
+
+        /// param [in]: ports   State of all input ports.
+        /// returns: Mask of rows which are active: pressed button pulls the row low.
+        template<typename Port>
+        uint32_t read(const Port* ports) const
+        {
+            uint32_t rows = 0;
+
+            for (size_t i = 0; i < _size; i++)
+            {
+                const auto& group = _groups[i];
+
+                rows |= ((~static_cast<uint32_t>(ports[group.port]) & group.pinMask) >> group.rightShift) << group.leftShift;
+            }
+
+            return rows;
+        }
+
+        /// returns: Amount of row groups, each requiring single mask and shift.
+        constexpr size_t groups() const
+        {
+            return _size;
+        }
+
+        private:
+        struct Group
+        {
+            uint8_t  port       = 0;
+            uint8_t  rightShift = 0;
+            uint8_t  leftShift  = 0;
+            uint32_t pinMask    = 0;
+        };
+
+        Group  _groups[Rows] = {};
+        size_t _size         = 0;
+    };
+}    // namespace board::detail::io::digital_in
@@ -23,6 +23,10 @@ limitations under the License.
 #include "internal.h"
 #include <target.h>
 
+#ifdef OPENDECK_USE_DUAL_CONTACT_KEYS
+#include "contact_timing.h"
+#endif
+
 #include "core/util/util.h"
 #include "core/util/ring_buffer.h"
 
@@ -39,6 +43,15 @@ namespace
     volatile Readings digitalInBuffer[PROJECT_TARGET_MAX_NR_OF_DIGITAL_INPUTS];
     volatile uint8_t  activeInColumn;
 
+#ifdef OPENDECK_USE_DUAL_CONTACT_KEYS
+    using ContactTiming = board::detail::io::digital_in::ContactTiming<PROJECT_TARGET_NR_OF_BUTTON_COLUMNS, PROJECT_TARGET_NR_OF_IN_SR * 8>;
+
+    // accessed from main loop only within atomic sections
+    ContactTiming contactTiming;
+    uint32_t      scanTime;
+    uint8_t       fastScanCounter;
+#endif
+
     inline void activateInputColumn()
     {
         CORE_MCU_IO_SET_STATE(PIN_PORT_DEC_BM_A0, PIN_INDEX_DEC_BM_A0, core::util::BIT_READ(activeInColumn, 0));
@@ -53,6 +66,19 @@ namespace
 
     inline void storeDigitalIn()
     {
+#ifdef OPENDECK_USE_DUAL_CONTACT_KEYS
+        // matrix is scanned every FAST_SCAN_TIMEOUT_US so that the contacts can be timestamped,
+        // while the readings are still stored once per millisecond
+        scanTime += FAST_SCAN_TIMEOUT_US;
+
+        bool storeReadings = ++fastScanCounter == FAST_SCANS_PER_READING;
+
+        if (storeReadings)
+        {
+            fastScanCounter = 0;
+        }
+#endif
+
         for (uint8_t column = 0; column < PROJECT_TARGET_NR_OF_BUTTON_COLUMNS; column++)
         {
             activateInputColumn();
@@ -64,23 +90,41 @@ namespace
 
             CORE_MCU_IO_SET_HIGH(PIN_PORT_SR_IN_LATCH, PIN_INDEX_SR_IN_LATCH);
 
+#ifdef OPENDECK_USE_DUAL_CONTACT_KEYS
+            ContactTiming::rowMask_t rows = 0;
+#endif
+
             for (uint8_t row = 0; row < PROJECT_TARGET_NR_OF_BUTTON_ROWS; row++)
             {
                 // this register shifts out MSB first
-                size_t index = ((((PROJECT_TARGET_NR_OF_IN_SR * 8) - 1) - row) * PROJECT_TARGET_NR_OF_BUTTON_COLUMNS) + column;
+                uint8_t registerRow = ((PROJECT_TARGET_NR_OF_IN_SR * 8) - 1) - row;
+                size_t  index       = (registerRow * PROJECT_TARGET_NR_OF_BUTTON_COLUMNS) + column;
                 CORE_MCU_IO_SET_LOW(PIN_PORT_SR_IN_CLK, PIN_INDEX_SR_IN_CLK);
                 io::spiWait();
 
-                digitalInBuffer[index].readings <<= 1;
-                digitalInBuffer[index].readings |= !CORE_MCU_IO_READ(PIN_PORT_SR_IN_DATA, PIN_INDEX_SR_IN_DATA);
+                bool state = !CORE_MCU_IO_READ(PIN_PORT_SR_IN_DATA, PIN_INDEX_SR_IN_DATA);
 
-                if (++digitalInBuffer[index].count > MAX_READING_COUNT)
+#ifdef OPENDECK_USE_DUAL_CONTACT_KEYS
+                rows |= static_cast<ContactTiming::rowMask_t>(state) << registerRow;
+
+                if (storeReadings)
+#endif
                 {
-                    digitalInBuffer[index].count = MAX_READING_COUNT;
+                    digitalInBuffer[index].readings <<= 1;
+                    digitalInBuffer[index].readings |= state;
+
+                    if (++digitalInBuffer[index].count > MAX_READING_COUNT)
+                    {
+                        digitalInBuffer[index].count = MAX_READING_COUNT;
+                    }
                 }
 
                 CORE_MCU_IO_SET_HIGH(PIN_PORT_SR_IN_CLK, PIN_INDEX_SR_IN_CLK);
             }
+
+#ifdef OPENDECK_USE_DUAL_CONTACT_KEYS
+            contactTiming.scan(column, rows, scanTime);
+#endif
         }
     }
 }    // namespace
@@ -172,6 +216,29 @@ namespace board::io::digital_in
 
         return index + PROJECT_TARGET_NR_OF_BUTTON_COLUMNS;
     }
+
+#ifdef OPENDECK_USE_DUAL_CONTACT_KEYS
+    bool contactInterval(size_t index, uint32_t& interval)
+    {
+        if (index >= PROJECT_TARGET_MAX_NR_OF_DIGITAL_INPUTS)
+        {
+            return false;
+        }
+
+        index = map::BUTTON_INDEX(index);
+
+        bool captured = false;
+
+        CORE_MCU_ATOMIC_SECTION
+        {
+            captured = contactTiming.interval(index / PROJECT_TARGET_NR_OF_BUTTON_COLUMNS,
+                                              index % PROJECT_TARGET_NR_OF_BUTTON_COLUMNS,
+                                              interval);
+        }
+
+        return captured;
+    }
+#endif
 }    // namespace board::io::digital_in
 
 #include "common.cpp.include"
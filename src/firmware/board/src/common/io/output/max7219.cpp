@@ -117,7 +117,16 @@ namespace board::io::digital_out
         uint8_t column = index % 8;
         uint8_t row    = index / 8;
 
-        core::util::BIT_WRITE(columns[column], row, ledBrightness != ledBrightness_t::OFF);
+        uint8_t newState = columns[column];
+        core::util::BIT_WRITE(newState, row, ledBrightness != ledBrightness_t::OFF);
+
+        // brightness changes of already lit LEDs don't change anything on MAX7219
+        if (newState == columns[column])
+        {
+            return;
+        }
+
+        columns[column] = newState;
 
         // update only the changed column
         sendCommand(column + 1, columns[column]);
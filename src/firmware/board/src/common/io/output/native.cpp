@@ -26,14 +26,66 @@ limitations under the License.
 
 #include "core/util/util.h"
 
+#include <array>
+
 using namespace board::io::digital_out;
 using namespace board::detail;
 using namespace board::detail::io::digital_out;
 
+#ifdef PROJECT_TARGET_LEDS_EXT_BCM_BITS
+#ifndef BOARD_USE_FAST_SOFT_PWM_TIMER
+#error "Binary code modulation requires fast soft PWM timer"
+#endif
+#endif
+
 namespace
 {
+#ifdef PROJECT_TARGET_LEDS_EXT_BCM_BITS
+    // Binary code modulation: each bit plane of the LED duty cycle is held for
+    // 2^plane timer ticks, so the ports are written only once per plane instead of on each tick.
+    constexpr uint8_t BCM_BITS     = PROJECT_TARGET_LEDS_EXT_BCM_BITS;
+    constexpr uint8_t BCM_MAX_DUTY = (1 << BCM_BITS) - 1;
+
+    constexpr double gammaCorrect(double value)
+    {
+        // value^2.2: value^2 multiplied by fifth root of value calculated with newton's method
+        double root = 1;
+
+        for (int i = 0; i < 32; i++)
+        {
+            root -= (root * root * root * root * root - value) / (5 * root * root * root * root);
+        }
+
+        return value * value * root;
+    }
+
+    /// Perceptually linear BCM duty cycle for each 8-bit duty value.
+    constexpr auto GAMMA_DUTY = []()
+    {
+        std::array<uint8_t, 256> table = {};
+
+        for (size_t i = 1; i < table.size(); i++)
+        {
+            table[i] = static_cast<uint8_t>((gammaCorrect(i / 255.0) * BCM_MAX_DUTY) + 0.5);
+        }
+
+        return table;
+    }();
+
+    constexpr uint8_t levelDuty(ledBrightness_t brightness)
+    {
+        return static_cast<uint8_t>(brightness) * 255 / static_cast<uint8_t>(ledBrightness_t::B100);
+    }
+
+    static_assert(GAMMA_DUTY[levelDuty(ledBrightness_t::B25)] > 0, "Lowest brightness level must be visible");
+
+    uint8_t                    bcmPlane;
+    uint8_t                    bcmTicksLeft = 1;
+    core::mcu::io::portWidth_t portState[PROJECT_TARGET_NR_OF_DIGITAL_OUTPUT_PORTS][BCM_BITS];
+#else
     uint8_t                    pwmCounter;
     core::mcu::io::portWidth_t portState[PROJECT_TARGET_NR_OF_DIGITAL_OUTPUT_PORTS][static_cast<uint8_t>(ledBrightness_t::B100)];
+#endif
 }    // namespace
 
 namespace board::detail::io::digital_out
@@ -55,18 +107,37 @@ namespace board::detail::io::digital_out
 
     void update()
     {
-        for (size_t port = 0; port < PROJECT_TARGET_NR_OF_DIGITAL_OUTPUT_PORTS; port++)
+#ifdef PROJECT_TARGET_LEDS_EXT_BCM_BITS
+        // keep current bit plane on the outputs until its weight expires
+        if (--bcmTicksLeft)
         {
-            core::mcu::io::portWidth_t updatedPortState = CORE_MCU_IO_READ_OUT_PORT(map::DIGITAL_OUT_PORT(port));
-            updatedPortState &= detail::map::DIGITAL_OUT_PORT_CLEAR_MASK(port);
-            updatedPortState |= portState[port][pwmCounter];
-            CORE_MCU_IO_SET_PORT_STATE(detail::map::DIGITAL_OUT_PORT(port), updatedPortState);
+            return;
         }
 
+        auto slot = bcmPlane;
+
+        bcmTicksLeft = 1 << bcmPlane;
+
+        if (++bcmPlane >= BCM_BITS)
+        {
+            bcmPlane = 0;
+        }
+#else
+        auto slot = pwmCounter;
+
         if (++pwmCounter >= static_cast<uint8_t>(ledBrightness_t::B100))
         {
             pwmCounter = 0;
         }
+#endif
+
+        for (size_t port = 0; port < PROJECT_TARGET_NR_OF_DIGITAL_OUTPUT_PORTS; port++)
+        {
+            core::mcu::io::portWidth_t updatedPortState = CORE_MCU_IO_READ_OUT_PORT(map::DIGITAL_OUT_PORT(port));
+            updatedPortState &= detail::map::DIGITAL_OUT_PORT_CLEAR_MASK(port);
+            updatedPortState |= portState[port][slot];
+            CORE_MCU_IO_SET_PORT_STATE(detail::map::DIGITAL_OUT_PORT(port), updatedPortState);
+        }
     }
 }    // namespace board::detail::io::digital_out
 
@@ -74,6 +145,9 @@ namespace board::io::digital_out
 {
     void writeLedState(size_t index, ledBrightness_t ledBrightness)
     {
+#ifdef PROJECT_TARGET_LEDS_EXT_BCM_BITS
+        writeLedDuty(index, levelDuty(ledBrightness));
+#else
         if (index >= PROJECT_TARGET_MAX_NR_OF_DIGITAL_OUTPUTS)
         {
             return;
@@ -101,7 +175,36 @@ namespace board::io::digital_out
                 );
             }
         }
+#endif
+    }
+
+#ifdef PROJECT_TARGET_LEDS_EXT_BCM_BITS
+    void writeLedDuty(size_t index, uint8_t duty)
+    {
+        if (index >= PROJECT_TARGET_MAX_NR_OF_DIGITAL_OUTPUTS)
+        {
+            return;
+        }
+
+        index = map::LED_INDEX(index);
+
+        auto bcmDuty = GAMMA_DUTY[duty];
+
+        CORE_MCU_ATOMIC_SECTION
+        {
+            for (uint8_t plane = 0; plane < BCM_BITS; plane++)
+            {
+                bool state = (bcmDuty >> plane) & 0x01;
+
+#ifdef PROJECT_TARGET_LEDS_EXT_INVERT
+                state = !state;
+#endif
+
+                core::util::BIT_WRITE(portState[map::LED_PORT_INDEX(index)][plane], map::LED_PIN_INDEX(index), state);
+            }
+        }
     }
+#endif
 
     size_t rgbFromOutput(size_t index)
     {
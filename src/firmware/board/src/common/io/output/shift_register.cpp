@@ -32,8 +32,14 @@ using namespace board::detail::io::digital_out;
 
 namespace
 {
+    constexpr size_t LED_STATE_SIZE = (PROJECT_TARGET_MAX_NR_OF_DIGITAL_OUTPUTS / 8) + 1;
+
     uint8_t          pwmCounter;
-    volatile uint8_t ledState[(PROJECT_TARGET_MAX_NR_OF_DIGITAL_OUTPUTS / 8) + 1][static_cast<uint8_t>(ledBrightness_t::B100)];
+    volatile uint8_t ledState[LED_STATE_SIZE][static_cast<uint8_t>(ledBrightness_t::B100)];
+
+    /// Contents of the shift register chain after the last transfer.
+    uint8_t shiftedState[LED_STATE_SIZE];
+    bool    shiftedStateValid;
 }    // namespace
 
 namespace board::detail::io::digital_out
@@ -70,27 +76,40 @@ namespace board::detail::io::digital_out
 
     void update()
     {
-        CORE_MCU_IO_SET_LOW(PIN_PORT_SR_OUT_LATCH, PIN_INDEX_SR_OUT_LATCH);
+        // skip the transfer if the chain already holds the state for current PWM slot:
+        // this is always the case when none of the LEDs are dimmed and nothing has changed
+        bool changed = !shiftedStateValid;
 
         for (uint8_t shiftRegister = 0; shiftRegister < PROJECT_TARGET_NR_OF_OUT_SR; shiftRegister++)
         {
-            for (uint8_t output = 0; output < 8; output++)
+            if (ledState[shiftRegister][pwmCounter] != shiftedState[shiftRegister])
             {
-                size_t  index      = output + shiftRegister * 8;
-                uint8_t arrayIndex = index / 8;
-                uint8_t bit        = index - 8 * arrayIndex;
+                shiftedState[shiftRegister] = ledState[shiftRegister][pwmCounter];
+                changed                     = true;
+            }
+        }
 
-                core::util::BIT_READ(ledState[arrayIndex][pwmCounter], bit)
-                    ? EXT_LED_ON(PIN_PORT_SR_OUT_DATA, PIN_INDEX_SR_OUT_DATA)
-                    : EXT_LED_OFF(PIN_PORT_SR_OUT_DATA, PIN_INDEX_SR_OUT_DATA);
+        if (changed)
+        {
+            CORE_MCU_IO_SET_LOW(PIN_PORT_SR_OUT_LATCH, PIN_INDEX_SR_OUT_LATCH);
 
-                CORE_MCU_IO_SET_LOW(PIN_PORT_SR_OUT_CLK, PIN_INDEX_SR_OUT_CLK);
-                detail::io::spiWait();
-                CORE_MCU_IO_SET_HIGH(PIN_PORT_SR_OUT_CLK, PIN_INDEX_SR_OUT_CLK);
+            for (uint8_t shiftRegister = 0; shiftRegister < PROJECT_TARGET_NR_OF_OUT_SR; shiftRegister++)
+            {
+                for (uint8_t output = 0; output < 8; output++)
+                {
+                    core::util::BIT_READ(shiftedState[shiftRegister], output)
+                        ? EXT_LED_ON(PIN_PORT_SR_OUT_DATA, PIN_INDEX_SR_OUT_DATA)
+                        : EXT_LED_OFF(PIN_PORT_SR_OUT_DATA, PIN_INDEX_SR_OUT_DATA);
+
+                    CORE_MCU_IO_SET_LOW(PIN_PORT_SR_OUT_CLK, PIN_INDEX_SR_OUT_CLK);
+                    detail::io::spiWait();
+                    CORE_MCU_IO_SET_HIGH(PIN_PORT_SR_OUT_CLK, PIN_INDEX_SR_OUT_CLK);
+                }
             }
-        }
 
-        CORE_MCU_IO_SET_HIGH(PIN_PORT_SR_OUT_LATCH, PIN_INDEX_SR_OUT_LATCH);
+            CORE_MCU_IO_SET_HIGH(PIN_PORT_SR_OUT_LATCH, PIN_INDEX_SR_OUT_LATCH);
+            shiftedStateValid = true;
+        }
 
         if (++pwmCounter >= static_cast<uint8_t>(ledBrightness_t::B100))
         {
@@ -16,7 +16,94 @@ limitations under the License.
 
 */
 
-#ifdef BOARD_USE_LOGGER
+#if defined(OPENDECK_USE_DEFERRED_LOGGER) && defined(OPENDECK_FW_APP)
+
+#include "board/deferred_logger.h"
+
+#include "core/mcu.h"
+
+namespace
+{
+    // must be power of two so that free-running indexes can be masked
+    constexpr size_t BUFFER_SIZE = 512;
+    constexpr size_t BUFFER_MASK = BUFFER_SIZE - 1;
+
+    static_assert((BUFFER_SIZE & BUFFER_MASK) == 0, "Deferred log buffer size must be power of two");
+
+    uint8_t buffer[BUFFER_SIZE];
+
+    // Log calls can come from interrupts as well (BLE stack on nRF52, for instance),
+    // so the space is reserved and head updated with interrupts disabled.
+    // Single consumer (drain): tail is written by consumer only.
+    volatile size_t   head;
+    volatile size_t   tail;
+    volatile uint32_t droppedRecords;
+}    // namespace
+
+namespace board::logger
+{
+    bool write(const uint8_t* record, size_t size)
+    {
+        bool written = false;
+
+        // records are short (see MAX_RECORD_SIZE): copying them with interrupts
+        // disabled is cheaper than reserving and committing the space separately
+        CORE_MCU_ATOMIC_SECTION
+        {
+            size_t currentHead = head;
+
+            if ((BUFFER_SIZE - (currentHead - tail)) < size)
+            {
+                droppedRecords = droppedRecords + 1;
+            }
+            else
+            {
+                for (size_t i = 0; i < size; i++)
+                {
+                    buffer[(currentHead + i) & BUFFER_MASK] = record[i];
+                }
+
+                // make sure data is visible before the new head
+                __atomic_thread_fence(__ATOMIC_RELEASE);
+                head    = currentHead + size;
+                written = true;
+            }
+        }
+
+        return written;
+    }
+
+    size_t read(uint8_t* data, size_t maxSize)
+    {
+        size_t currentTail = tail;
+        size_t available   = head - currentTail;
+
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+
+        if (available > maxSize)
+        {
+            available = maxSize;
+        }
+
+        for (size_t i = 0; i < available; i++)
+        {
+            data[i] = buffer[(currentTail + i) & BUFFER_MASK];
+        }
+
+        // data must be copied before the space is released to producer
+        __atomic_thread_fence(__ATOMIC_RELEASE);
+        tail = currentTail + available;
+
+        return available;
+    }
+
+    uint32_t dropped()
+    {
+        return droppedRecords;
+    }
+}    // namespace board::logger
+
+#elif defined(BOARD_USE_LOGGER)
 #ifdef OPENDECK_FW_APP
 
 #include "logger.h"
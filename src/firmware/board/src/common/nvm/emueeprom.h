@@ -0,0 +1,141 @@
+/*
+
+Copyright Igor Petrovic
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#pragma once
+
+#include "index.h"
+#include "board/board.h"
+#include "lib/emueeprom/emueeprom.h"
+
+namespace board::detail::nvm
+{
+    /// Board NVM on top of emulated EEPROM, with optional RAM index of the stored values (see Index).
+    /// IndexSize is the amount of indexed addresses: with 0, all reads search the flash page.
+    template<size_t IndexSize>
+    class EmuEeprom
+    {
+        public:
+        EmuEeprom(lib::emueeprom::EmuEEPROM& emuEeprom)
+            : _emuEeprom(emuEeprom)
+        {}
+
+        bool init()
+        {
+            _index.clear();
+            return _emuEeprom.init();
+        }
+
+        uint32_t size()
+        {
+            return _emuEeprom.maxAddress();
+        }
+
+        bool read(uint32_t address, uint32_t& value, board::nvm::parameterType_t type)
+        {
+            uint16_t tempData;
+
+            switch (type)
+            {
+            case board::nvm::parameterType_t::BYTE:
+            case board::nvm::parameterType_t::WORD:
+            {
+                if (_index.get(address, tempData))
+                {
+                    value = tempData;
+                    break;
+                }
+
+                auto readStatus = _emuEeprom.read(address, tempData);
+                value           = tempData;
+
+                if (readStatus == lib::emueeprom::readStatus_t::OK)
+                {
+                    value = tempData;
+                }
+                else if (readStatus == lib::emueeprom::readStatus_t::NO_VAR)
+                {
+                    // variable with this address doesn't exist yet - set value to 0
+                    value = 0;
+                }
+
+                if ((readStatus == lib::emueeprom::readStatus_t::OK) || (readStatus == lib::emueeprom::readStatus_t::NO_VAR))
+                {
+                    _index.set(address, value);
+                }
+            }
+            break;
+
+            default:
+                return false;
+            }
+
+            return true;
+        }
+
+        bool write(uint32_t address, uint32_t value, board::nvm::parameterType_t type, bool cacheOnly)
+        {
+            uint16_t tempData;
+
+            switch (type)
+            {
+            case board::nvm::parameterType_t::BYTE:
+            case board::nvm::parameterType_t::WORD:
+            {
+                tempData = value;
+
+                if (_emuEeprom.write(address, tempData, cacheOnly) != lib::emueeprom::writeStatus_t::OK)
+                {
+                    _index.invalidate(address);
+                    return false;
+                }
+
+                if (cacheOnly)
+                {
+                    // value isn't in flash until the cache is written: let emulated EEPROM resolve it
+                    _index.invalidate(address);
+                }
+                else
+                {
+                    _index.set(address, tempData);
+                }
+            }
+            break;
+
+            default:
+                return false;
+            }
+
+            return true;
+        }
+
+        bool clear()
+        {
+            _index.clear();
+            return _emuEeprom.format();
+        }
+
+        void writeCacheToFlash()
+        {
+            _emuEeprom.writeCacheToFlash();
+        }
+
+        private:
+        lib::emueeprom::EmuEEPROM& _emuEeprom;
+        Index<IndexSize>           _index;
+    };
+}    // namespace board::detail::nvm
@@ -0,0 +1,90 @@
+/*
+
+Copyright Igor Petrovic
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#pragma once
+
+#include <inttypes.h>
+#include <stddef.h>
+#include <array>
+
+namespace board::detail::nvm
+{
+    /// RAM index of the latest value stored at each virtual NVM address.
+    /// Reading a variable from emulated EEPROM requires searching the flash page for the
+    /// latest record with given address. Entries are filled on first read and kept up to date
+    /// on writes, so that each address is searched for at most once. Since values don't change
+    /// when emulated EEPROM moves live records to another page, the index stays valid across
+    /// page transfers and needs to be cleared only once the memory is formatted.
+    template<size_t Size>
+    class Index
+    {
+        public:
+        /// Retrieves indexed value.
+        /// returns: False if the address isn't indexed yet and needs to be read from memory.
+        bool get(uint32_t address, uint16_t& value) const
+        {
+            if (!indexed(address))
+            {
+                return false;
+            }
+
+            value = _values[address];
+            return true;
+        }
+
+        void set(uint32_t address, uint16_t value)
+        {
+            if (address >= Size)
+            {
+                return;
+            }
+
+            _values[address] = value;
+            _indexed[address / 8] |= (1 << (address % 8));
+        }
+
+        void invalidate(uint32_t address)
+        {
+            if (address >= Size)
+            {
+                return;
+            }
+
+            _indexed[address / 8] &= ~(1 << (address % 8));
+        }
+
+        void clear()
+        {
+            _indexed.fill(0);
+        }
+
+        bool indexed(uint32_t address) const
+        {
+            if (address >= Size)
+            {
+                return false;
+            }
+
+            return (_indexed[address / 8] >> (address % 8)) & 0x01;
+        }
+
+        private:
+        std::array<uint16_t, Size>          _values  = {};
+        std::array<uint8_t, (Size + 7) / 8> _indexed = {};
+    };
+}    // namespace board::detail::nvm
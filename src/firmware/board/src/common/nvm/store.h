@@ -0,0 +1,380 @@
+/*
+
+Copyright Igor Petrovic
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#pragma once
+
+#include <inttypes.h>
+#include <stddef.h>
+
+namespace board::detail::nvm
+{
+    /// Flash access used by Store.
+    /// Each of the two pages consists of one or more sectors, the smallest erasable flash units.
+    class StoreHwa
+    {
+        public:
+        virtual ~StoreHwa() = default;
+
+        virtual bool eraseSector(size_t page, size_t sector)              = 0;
+        virtual bool write32(size_t page, uint32_t offset, uint32_t data) = 0;
+        virtual bool read32(size_t page, uint32_t offset, uint32_t& data) = 0;
+    };
+
+    /// Emulated EEPROM on two flash pages which moves live values to the spare page in bounded
+    /// steps instead of in a single blocking call once the active page gets full.
+    /// Each page starts with a status word, followed by 32-bit records (16-bit address, 16-bit value).
+    /// Transfer starts once the active page reaches a fill threshold. On each update() call, single
+    /// address is copied to the spare page or single sector of the old page is erased. Writes made
+    /// while copying are stored in the old page and mirrored to the spare page if the address has
+    /// already been copied, so the old page stays complete until the spare one is marked as valid.
+    /// Page status only ever clears bits (ERASED -> RECEIVING -> VALID -> OBSOLETE) and the old page
+    /// is marked as obsolete before the new one is marked as valid, so init() can always tell which
+    /// page holds the data and finish the interrupted transfer.
+    template<size_t PageSize, size_t Sectors>
+    class Store
+    {
+        public:
+        Store(StoreHwa& hwa)
+            : _hwa(hwa)
+        {}
+
+        /// Amount of records which fit in single page.
+        static constexpr size_t RECORDS = (PageSize / sizeof(uint32_t)) - 1;
+
+        /// Amount of free records left in active page once the transfer starts.
+        /// Writes made while copying need to fit in both pages.
+        static constexpr size_t HEADROOM = RECORDS / 16;
+
+        /// Amount of used records in active page after which transfer starts.
+        static constexpr size_t TRANSFER_THRESHOLD = RECORDS - HEADROOM;
+
+        /// Amount of addresses which can be stored.
+        /// Part of the page is left free so that, even with all addresses in use, there's
+        /// room for a number of writes before the next transfer starts.
+        static constexpr size_t SIZE = (RECORDS * 3) / 4;
+
+        static_assert(((PageSize % (Sectors * sizeof(uint32_t))) == 0) && HEADROOM, "Invalid page size");
+        static_assert(SIZE < 0xFFFF, "Address 0xFFFF is reserved for erased records");
+
+        bool init()
+        {
+            uint32_t status[2] = {};
+
+            if (!_hwa.read32(0, 0, status[0]) || !_hwa.read32(1, 0, status[1]))
+            {
+                return false;
+            }
+
+            _state = state_t::IDLE;
+
+            if ((status[0] == STATUS_VALID) != (status[1] == STATUS_VALID))
+            {
+                _active = status[0] == STATUS_VALID ? 0 : 1;
+
+                // The other page is either blank or a leftover of interrupted transfer or erase.
+                // Interrupted erase can leave the status erased while rest of the page isn't,
+                // so check the entire page.
+                if (!blank(spare()) && !erase(spare()))
+                {
+                    return false;
+                }
+            }
+            else if ((status[0] == STATUS_OBSOLETE) && (status[1] == STATUS_RECEIVING))
+            {
+                // all values have been copied before the power loss: finish the transfer
+                _active = 1;
+
+                if (!_hwa.write32(_active, 0, STATUS_VALID) || !erase(spare()))
+                {
+                    return false;
+                }
+            }
+            else if ((status[1] == STATUS_OBSOLETE) && (status[0] == STATUS_RECEIVING))
+            {
+                _active = 0;
+
+                if (!_hwa.write32(_active, 0, STATUS_VALID) || !erase(spare()))
+                {
+                    return false;
+                }
+            }
+            else
+            {
+                return format();
+            }
+
+            // find the first free record
+            for (_writeOffset = FIRST_RECORD; _writeOffset < PageSize; _writeOffset += sizeof(uint32_t))
+            {
+                uint32_t data = 0;
+
+                if (!_hwa.read32(_active, _writeOffset, data))
+                {
+                    return false;
+                }
+
+                if (data == ERASED)
+                {
+                    break;
+                }
+            }
+
+            return true;
+        }
+
+        bool format()
+        {
+            _state = state_t::IDLE;
+
+            if (!erase(0) || !erase(1))
+            {
+                return false;
+            }
+
+            _active      = 0;
+            _writeOffset = FIRST_RECORD;
+
+            return _hwa.write32(_active, 0, STATUS_VALID);
+        }
+
+        /// Retrieves the latest value stored at given address.
+        /// returns: False if the address hasn't been written yet.
+        bool read(uint32_t address, uint16_t& value)
+        {
+            return find(_active, _writeOffset, address, value);
+        }
+
+        bool write(uint32_t address, uint16_t value)
+        {
+            if (address >= SIZE)
+            {
+                return false;
+            }
+
+            // Transfer should be finished from update() long before the page is full.
+            // If it isn't, finish it here, with all the blocking it involves.
+            while (_writeOffset >= PageSize)
+            {
+                if (!step())
+                {
+                    return false;
+                }
+            }
+
+            if (!append(_active, _writeOffset, address, value))
+            {
+                return false;
+            }
+
+            if ((_state == state_t::COPY) && (address < _cursor))
+            {
+                // already copied - make sure the spare page has the latest value as well
+                return append(spare(), _spareOffset, address, value);
+            }
+
+            return true;
+        }
+
+        /// Performs single step of page transfer, if needed.
+        /// param [in]: eraseAllowed    If set to false, erase steps, which stall the CPU the longest, are postponed.
+        /// returns: False on flash error, true otherwise.
+        bool update(bool eraseAllowed)
+        {
+            if ((_state == state_t::ERASE) && !eraseAllowed)
+            {
+                return true;
+            }
+
+            return step();
+        }
+
+        /// returns: True if the page transfer is in progress.
+        bool transferring() const
+        {
+            return _state != state_t::IDLE;
+        }
+
+        private:
+        enum class state_t : uint8_t
+        {
+            IDLE,
+            COPY,
+            ERASE,
+        };
+
+        static constexpr uint32_t ERASED           = 0xFFFFFFFF;
+        static constexpr uint32_t STATUS_RECEIVING = 0xEEEEEEEE;
+        static constexpr uint32_t STATUS_VALID     = 0xAAAAAAAA;
+        static constexpr uint32_t STATUS_OBSOLETE  = 0x00000000;
+        static constexpr uint32_t FIRST_RECORD     = sizeof(uint32_t);
+        static constexpr uint32_t SECTOR_SIZE      = PageSize / Sectors;
+
+        StoreHwa& _hwa;
+        state_t   _state       = state_t::IDLE;
+        size_t    _active      = 0;
+        uint32_t  _writeOffset = FIRST_RECORD;
+        uint32_t  _spareOffset = FIRST_RECORD;
+
+        /// Next address to copy while copying, or next sector to erase while erasing.
+        uint32_t _cursor = 0;
+
+        size_t spare() const
+        {
+            return _active ^ 1;
+        }
+
+        bool step()
+        {
+            switch (_state)
+            {
+            case state_t::IDLE:
+            {
+                if ((_writeOffset - FIRST_RECORD) / sizeof(uint32_t) < TRANSFER_THRESHOLD)
+                {
+                    return true;
+                }
+
+                if (!_hwa.write32(spare(), 0, STATUS_RECEIVING))
+                {
+                    return false;
+                }
+
+                _spareOffset = FIRST_RECORD;
+                _cursor      = 0;
+                _state       = state_t::COPY;
+            }
+            break;
+
+            case state_t::COPY:
+            {
+                if (_cursor < SIZE)
+                {
+                    uint16_t value = 0;
+
+                    if (find(_active, _writeOffset, _cursor, value) && !append(spare(), _spareOffset, _cursor, value))
+                    {
+                        return false;
+                    }
+
+                    _cursor++;
+                    break;
+                }
+
+                // old page needs to be marked first: if the power is lost in between,
+                // obsolete and receiving page together mean that the copy is complete
+                if (!_hwa.write32(_active, 0, STATUS_OBSOLETE) || !_hwa.write32(spare(), 0, STATUS_VALID))
+                {
+                    return false;
+                }
+
+                _active      = spare();
+                _writeOffset = _spareOffset;
+                _cursor      = Sectors;
+                _state       = state_t::ERASE;
+            }
+            break;
+
+            case state_t::ERASE:
+            {
+                // status is in the first sector: erase it last so that the page doesn't
+                // look erased while the remaining sectors aren't
+                if (!_hwa.eraseSector(spare(), _cursor - 1))
+                {
+                    return false;
+                }
+
+                if (!--_cursor)
+                {
+                    _state = state_t::IDLE;
+                }
+            }
+            break;
+            }
+
+            return true;
+        }
+
+        bool find(size_t page, uint32_t end, uint32_t address, uint16_t& value)
+        {
+            // the latest record is the valid one
+            for (uint32_t offset = end; offset > FIRST_RECORD;)
+            {
+                offset -= sizeof(uint32_t);
+
+                uint32_t data = 0;
+
+                if (!_hwa.read32(page, offset, data))
+                {
+                    return false;
+                }
+
+                if ((data >> 16) == address)
+                {
+                    value = data & 0xFFFF;
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        bool append(size_t page, uint32_t& offset, uint32_t address, uint16_t value)
+        {
+            if (offset >= PageSize)
+            {
+                return false;
+            }
+
+            if (!_hwa.write32(page, offset, (address << 16) | value))
+            {
+                return false;
+            }
+
+            offset += sizeof(uint32_t);
+            return true;
+        }
+
+        bool blank(size_t page)
+        {
+            for (uint32_t offset = 0; offset < PageSize; offset += sizeof(uint32_t))
+            {
+                uint32_t data = 0;
+
+                if (!_hwa.read32(page, offset, data) || (data != ERASED))
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        bool erase(size_t page)
+        {
+            for (size_t sector = Sectors; sector; sector--)
+            {
+                if (!_hwa.eraseSector(page, sector - 1))
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+    };
+}    // namespace board::detail::nvm
@@ -26,8 +26,15 @@ namespace
     constexpr uint32_t MAIN_TIMER_TIMEOUT_US = 1000;
 #ifdef OPENDECK_FW_APP
 #if defined(BOARD_USE_FAST_SOFT_PWM_TIMER) && defined(PROJECT_TARGET_SUPPORT_SOFT_PWM)
+#ifdef PROJECT_TARGET_LEDS_EXT_BCM_BITS
+    // The timer ticks at the weight of the least significant bit plane and the planes are
+    // counted down in update(). Core timer API doesn't guarantee that the period can be
+    // changed from within the timer callback, so it isn't changed per plane.
+    constexpr uint32_t SOFT_PWM_TIMER_TIMEOUT_US = board::detail::io::digital_out::BCM_BASE_PERIOD_US;
+#else
     constexpr uint32_t SOFT_PWM_TIMER_TIMEOUT_US = 200;
 #endif
+#endif
 #endif
 
     bool usbInitialized;
@@ -46,7 +53,9 @@ namespace board
                                     {
                                         detail::io::indicators::update();
 #ifndef PROJECT_TARGET_USB_OVER_SERIAL_HOST
+#ifndef OPENDECK_USE_DUAL_CONTACT_KEYS
                                         detail::io::digital_in::update();
+#endif
 #ifndef BOARD_USE_FAST_SOFT_PWM_TIMER
 #if PROJECT_TARGET_MAX_NR_OF_DIGITAL_OUTPUTS > 0
                                         detail::io::digital_out::update();
@@ -58,6 +67,19 @@ namespace board
         core::mcu::timers::setPeriod(mainTimerIndex, MAIN_TIMER_TIMEOUT_US);
         core::mcu::timers::start(mainTimerIndex);
 
+#if defined(OPENDECK_USE_DUAL_CONTACT_KEYS) && !defined(PROJECT_TARGET_USB_OVER_SERIAL_HOST)
+        // inputs are scanned faster so that the contacts of dual-contact keys can be timestamped
+        size_t digitalInTimerIndex = 0;
+
+        core::mcu::timers::allocate(digitalInTimerIndex, []()
+                                    {
+                                        detail::io::digital_in::update();
+                                    });
+
+        core::mcu::timers::setPeriod(digitalInTimerIndex, detail::io::digital_in::FAST_SCAN_TIMEOUT_US);
+        core::mcu::timers::start(digitalInTimerIndex);
+#endif
+
 #if defined(BOARD_USE_FAST_SOFT_PWM_TIMER) && defined(PROJECT_TARGET_SUPPORT_SOFT_PWM)
         size_t pwmTimerIndex = 0;
 
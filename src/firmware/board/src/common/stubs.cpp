@@ -46,6 +46,11 @@ namespace board
             {
                 return 0;
             }
+
+            __attribute__((weak)) bool contactInterval(size_t index, uint32_t& interval)
+            {
+                return false;
+            }
         }    // namespace digital_in
 
         namespace digital_out
@@ -54,6 +59,13 @@ namespace board
             {
             }
 
+            __attribute__((weak)) void writeLedDuty(size_t index, uint8_t duty)
+            {
+                constexpr uint8_t LEVELS = static_cast<uint8_t>(ledBrightness_t::B100);
+
+                writeLedState(index, static_cast<ledBrightness_t>(((duty * LEVELS) + 127) / 255));
+            }
+
             __attribute__((weak)) size_t rgbFromOutput(size_t index)
             {
                 return 0;
@@ -71,6 +83,10 @@ namespace board
             {
                 return 0;
             }
+
+            __attribute__((weak)) void setEnabled(size_t index, bool state)
+            {
+            }
         }    // namespace analog
 
         namespace indicators
@@ -89,6 +105,13 @@ namespace board
         }    // namespace indicators
     }    // namespace io
 
+    namespace nvm
+    {
+        __attribute__((weak)) void update(bool eraseAllowed)
+        {
+        }
+    }    // namespace nvm
+
     namespace detail::io
     {
         __attribute__((weak)) void init()
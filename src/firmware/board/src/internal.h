@@ -89,6 +89,12 @@ namespace board::detail
             // constant used to easily access maximum amount of previous readings for a given digital input
             constexpr inline size_t MAX_READING_COUNT = (8 * sizeof(((board::io::digital_in::Readings*)0)->readings));
 
+            /// Period in microseconds at which the inputs are scanned when contacts of dual-contact keys are timestamped.
+            constexpr inline uint32_t FAST_SCAN_TIMEOUT_US = 100;
+
+            /// Readings are still stored once per millisecond: amount of fast scans between two stored readings.
+            constexpr inline uint32_t FAST_SCANS_PER_READING = 1000 / FAST_SCAN_TIMEOUT_US;
+
             void init();
 
             /// Continuously reads all digital inputs.
@@ -104,6 +110,12 @@ namespace board::detail
 
             /// Checks if digital outputs need to be updated.
             void update();
+
+#ifdef PROJECT_TARGET_LEDS_EXT_BCM_BITS
+            /// Duration of the least significant bit plane in microseconds, used as soft PWM timer period.
+            /// Each next plane lasts twice as long, so that the frame of (2^bits - 1) ticks lasts ~12.8ms (~80Hz).
+            constexpr inline uint32_t BCM_BASE_PERIOD_US = 12800 >> PROJECT_TARGET_LEDS_EXT_BCM_BITS;
+#endif
         }    // namespace digital_out
 
         namespace analog
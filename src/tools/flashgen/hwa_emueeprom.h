@@ -0,0 +1,126 @@
+/*
+
+Copyright Igor Petrovic
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#pragma once
+
+#include "lib/emueeprom/emueeprom.h"
+
+#include <array>
+#include <algorithm>
+
+namespace flashgen
+{
+    /// Emulated EEPROM pages kept in host memory.
+    /// Factory page isn't available.
+    class HwaEmuEeprom : public lib::emueeprom::Hwa
+    {
+        public:
+        HwaEmuEeprom()
+        {
+            std::fill(_pageArray.at(0).begin(), _pageArray.at(0).end(), 0xFF);
+            std::fill(_pageArray.at(1).begin(), _pageArray.at(1).end(), 0xFF);
+        }
+
+        bool init() override
+        {
+            return true;
+        }
+
+        bool erasePage(lib::emueeprom::page_t page) override
+        {
+            if (page == lib::emueeprom::page_t::PAGE_FACTORY)
+            {
+                return false;
+            }
+
+            switch (page)
+            {
+            case lib::emueeprom::page_t::PAGE_1:
+            {
+                std::fill(_pageArray.at(0).begin(), _pageArray.at(0).end(), 0xFF);
+            }
+            break;
+
+            case lib::emueeprom::page_t::PAGE_2:
+            {
+                std::fill(_pageArray.at(1).begin(), _pageArray.at(1).end(), 0xFF);
+            }
+            break;
+
+            default:
+                break;
+            }
+
+            return true;
+        }
+
+        bool write32(lib::emueeprom::page_t page, uint32_t offset, uint32_t data) override
+        {
+            if (page == lib::emueeprom::page_t::PAGE_FACTORY)
+            {
+                return false;
+            }
+
+            if (offset == 0)
+            {
+                if (
+                    (data == static_cast<uint32_t>(lib::emueeprom::pageStatus_t::RECEIVING)) ||
+                    (data == static_cast<uint32_t>(lib::emueeprom::pageStatus_t::VALID)))
+                {
+                    _activePageWrite = page;
+                }
+            }
+
+            auto& ref = page == lib::emueeprom::page_t::PAGE_1 ? _pageArray.at(0) : _pageArray.at(1);
+
+            ref.at(offset + 0) = data >> 0 & static_cast<uint16_t>(0xFF);
+            ref.at(offset + 1) = data >> 8 & static_cast<uint16_t>(0xFF);
+            ref.at(offset + 2) = data >> 16 & static_cast<uint16_t>(0xFF);
+            ref.at(offset + 3) = data >> 24 & static_cast<uint16_t>(0xFF);
+
+            return true;
+        }
+
+        bool read32(lib::emueeprom::page_t page, uint32_t offset, uint32_t& data) override
+        {
+            // no factory page here
+            if (page == lib::emueeprom::page_t::PAGE_FACTORY)
+            {
+                return false;
+            }
+
+            auto& ref = page == lib::emueeprom::page_t::PAGE_1 ? _pageArray.at(0) : _pageArray.at(1);
+
+            data = ref.at(offset + 3);
+            data <<= 8;
+            data |= ref.at(offset + 2);
+            data <<= 8;
+            data |= ref.at(offset + 1);
+            data <<= 8;
+            data |= ref.at(offset + 0);
+
+            return true;
+        }
+
+        protected:
+        std::array<std::array<uint8_t, EMU_EEPROM_PAGE_SIZE>, 2> _pageArray;
+
+        /// Page which has last been marked as receiving or valid.
+        lib::emueeprom::page_t _activePageWrite = lib::emueeprom::page_t::PAGE_1;
+    };
+}    // namespace flashgen
@@ -19,6 +19,7 @@ limitations under the License.
 #include "application/database/database.h"
 #include "application/database/layout.h"
 #include "lib/emueeprom/emueeprom.h"
+#include "hwa_emueeprom.h"
 
 // Here, generated MCU header for real MCU is included, however,
 // this application actually links with stub MCU. Because of this
@@ -38,95 +39,10 @@ namespace flashgen
 
 namespace
 {
-    class HwaEmuEeprom : public lib::emueeprom::Hwa
+    class HwaEmuEeprom : public flashgen::HwaEmuEeprom
     {
         public:
-        HwaEmuEeprom()
-        {
-            std::fill(_pageArray.at(0).begin(), _pageArray.at(0).end(), 0xFF);
-            std::fill(_pageArray.at(1).begin(), _pageArray.at(1).end(), 0xFF);
-        }
-
-        bool init() override
-        {
-            return true;
-        }
-
-        bool erasePage(lib::emueeprom::page_t page) override
-        {
-            if (page == lib::emueeprom::page_t::PAGE_FACTORY)
-            {
-                return false;
-            }
-
-            switch (page)
-            {
-            case lib::emueeprom::page_t::PAGE_1:
-            {
-                std::fill(_pageArray.at(0).begin(), _pageArray.at(0).end(), 0xFF);
-            }
-            break;
-
-            case lib::emueeprom::page_t::PAGE_2:
-            {
-                std::fill(_pageArray.at(1).begin(), _pageArray.at(1).end(), 0xFF);
-            }
-            break;
-
-            default:
-                break;
-            }
-
-            return true;
-        }
-
-        bool write32(lib::emueeprom::page_t page, uint32_t offset, uint32_t data) override
-        {
-            if (page == lib::emueeprom::page_t::PAGE_FACTORY)
-            {
-                return false;
-            }
-
-            if (offset == 0)
-            {
-                if (
-                    (data == static_cast<uint32_t>(lib::emueeprom::pageStatus_t::RECEIVING)) ||
-                    (data == static_cast<uint32_t>(lib::emueeprom::pageStatus_t::VALID)))
-                {
-                    _activePageWrite = page;
-                }
-            }
-
-            auto& ref = page == lib::emueeprom::page_t::PAGE_1 ? _pageArray.at(0) : _pageArray.at(1);
-
-            ref.at(offset + 0) = data >> 0 & static_cast<uint16_t>(0xFF);
-            ref.at(offset + 1) = data >> 8 & static_cast<uint16_t>(0xFF);
-            ref.at(offset + 2) = data >> 16 & static_cast<uint16_t>(0xFF);
-            ref.at(offset + 3) = data >> 24 & static_cast<uint16_t>(0xFF);
-
-            return true;
-        }
-
-        bool read32(lib::emueeprom::page_t page, uint32_t offset, uint32_t& data) override
-        {
-            // no factory page here
-            if (page == lib::emueeprom::page_t::PAGE_FACTORY)
-            {
-                return false;
-            }
-
-            auto& ref = page == lib::emueeprom::page_t::PAGE_1 ? _pageArray.at(0) : _pageArray.at(1);
-
-            data = ref.at(offset + 3);
-            data <<= 8;
-            data |= ref.at(offset + 2);
-            data <<= 8;
-            data |= ref.at(offset + 1);
-            data <<= 8;
-            data |= ref.at(offset + 0);
-
-            return true;
-        }
+        HwaEmuEeprom() = default;
 
         void setFilename(const char* filename)
         {
@@ -189,9 +105,7 @@ namespace
         }
 
         private:
-        std::array<std::array<uint8_t, EMU_EEPROM_PAGE_SIZE>, 2> _pageArray;
-        std::string                                              _filename;
-        lib::emueeprom::page_t                                   _activePageWrite = lib::emueeprom::page_t::PAGE_1;
+        std::string _filename;
     } hwaEmuEeprom;
 
     lib::emueeprom::EmuEEPROM emuEeprom(hwaEmuEeprom, false);
@@ -275,6 +189,10 @@ namespace
         {
             return true;
         }
+
+        void update() override
+        {
+        }
     } _hwaDatabase;
 
     database::AppLayout _layout;
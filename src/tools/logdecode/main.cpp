@@ -0,0 +1,309 @@
+/*
+
+Copyright Igor Petrovic
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#include "board/deferred_logger.h"
+
+#include <iostream>
+#include <fstream>
+#include <filesystem>
+#include <iterator>
+#include <map>
+#include <regex>
+#include <string>
+#include <vector>
+#include <cstdio>
+
+namespace
+{
+    struct Argument
+    {
+        board::logger::argType_t type    = board::logger::argType_t::INTEGER;
+        uint32_t                 integer = 0;
+        std::string              string  = {};
+    };
+
+    /// Converts escape sequences in string literal the same way compiler would for the characters used in log messages.
+    std::string unescape(const std::string& literal)
+    {
+        std::string result = {};
+
+        for (size_t i = 0; i < literal.size(); i++)
+        {
+            if ((literal.at(i) == '\\') && ((i + 1) < literal.size()))
+            {
+                switch (literal.at(++i))
+                {
+                case 'n':
+                    result += '\n';
+                    break;
+
+                case 't':
+                    result += '\t';
+                    break;
+
+                case 'r':
+                    result += '\r';
+                    break;
+
+                default:
+                    result += literal.at(i);
+                    break;
+                }
+            }
+            else
+            {
+                result += literal.at(i);
+            }
+        }
+
+        return result;
+    }
+
+    /// Scans all sources in provided directory for LOG_* calls and maps format IDs to format strings.
+    void collectFormats(const std::filesystem::path& root, std::map<uint32_t, std::string>& formats)
+    {
+        static const std::regex LOG_CALL(R"(LOG_(INF|WRN|ERR)\s*\(\s*\"((?:[^\"\\]|\\.)*)\")");
+
+        for (const auto& entry : std::filesystem::recursive_directory_iterator(root))
+        {
+            auto extension = entry.path().extension();
+
+            if (!entry.is_regular_file() || ((extension != ".cpp") && (extension != ".h") && (extension != ".include")))
+            {
+                continue;
+            }
+
+            std::ifstream stream(entry.path());
+            std::string   contents((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+
+            for (auto it = std::sregex_iterator(contents.begin(), contents.end(), LOG_CALL); it != std::sregex_iterator(); ++it)
+            {
+                auto format = unescape((*it)[2].str());
+                auto id     = board::logger::formatId(format.c_str());
+                auto found  = formats.find(id);
+
+                if ((found != formats.end()) && (found->second != format))
+                {
+                    std::cerr << "WARNING: format ID collision between \"" << found->second << "\" and \"" << format << "\"" << std::endl;
+                }
+
+                formats[id] = format;
+            }
+        }
+    }
+
+    /// Expands format string using decoded arguments.
+    std::string expand(const std::string& format, const std::vector<Argument>& arguments)
+    {
+        std::string result   = {};
+        size_t      argIndex = 0;
+
+        for (size_t i = 0; i < format.size(); i++)
+        {
+            if (format.at(i) != '%')
+            {
+                result += format.at(i);
+                continue;
+            }
+
+            if (((i + 1) < format.size()) && (format.at(i + 1) == '%'))
+            {
+                result += '%';
+                i++;
+                continue;
+            }
+
+            // collect flags and width, drop length modifiers since all integers are stored as 32-bit values
+            std::string spec = "%";
+            size_t      j    = i + 1;
+
+            while ((j < format.size()) && (std::string("-+ #0123456789.").find(format.at(j)) != std::string::npos))
+            {
+                spec += format.at(j++);
+            }
+
+            while ((j < format.size()) && (std::string("hljzt").find(format.at(j)) != std::string::npos))
+            {
+                j++;
+            }
+
+            if (j >= format.size())
+            {
+                break;
+            }
+
+            char conversion = format.at(j);
+            i               = j;
+
+            if (argIndex >= arguments.size())
+            {
+                result += "<missing>";
+                continue;
+            }
+
+            const auto& argument = arguments.at(argIndex++);
+            char        buffer[128];
+
+            if (argument.type == board::logger::argType_t::STRING)
+            {
+                snprintf(buffer, sizeof(buffer), (spec + 's').c_str(), argument.string.c_str());
+            }
+            else if ((conversion == 'd') || (conversion == 'i'))
+            {
+                snprintf(buffer, sizeof(buffer), (spec + "ld").c_str(), static_cast<long>(static_cast<int32_t>(argument.integer)));
+            }
+            else if (conversion == 'c')
+            {
+                snprintf(buffer, sizeof(buffer), (spec + 'c').c_str(), static_cast<int>(argument.integer));
+            }
+            else
+            {
+                snprintf(buffer, sizeof(buffer), (spec + 'l' + conversion).c_str(), static_cast<unsigned long>(argument.integer));
+            }
+
+            result += buffer;
+        }
+
+        return result;
+    }
+
+    bool decodeArguments(const uint8_t* data, size_t size, std::vector<Argument>& arguments)
+    {
+        size_t i = 0;
+
+        while (i < size)
+        {
+            Argument argument = {};
+            argument.type     = static_cast<board::logger::argType_t>(data[i++]);
+
+            if (argument.type == board::logger::argType_t::INTEGER)
+            {
+                if ((i + 4) > size)
+                {
+                    return false;
+                }
+
+                argument.integer = data[i] | (data[i + 1] << 8) | (data[i + 2] << 16) | (static_cast<uint32_t>(data[i + 3]) << 24);
+                i += 4;
+            }
+            else if (argument.type == board::logger::argType_t::STRING)
+            {
+                if (i >= size)
+                {
+                    return false;
+                }
+
+                size_t length = data[i++];
+
+                if ((i + length) > size)
+                {
+                    return false;
+                }
+
+                argument.string.assign(reinterpret_cast<const char*>(&data[i]), length);
+                i += length;
+            }
+            else
+            {
+                return false;
+            }
+
+            arguments.push_back(argument);
+        }
+
+        return true;
+    }
+}    // namespace
+
+int main(int argc, char* argv[])
+{
+    // first argument should be path to the binary log stream (raw UART capture or
+    // concatenated payload of SysEx log read responses)
+    // all other arguments should be paths to source directories used to build the firmware
+    if (argc <= 2)
+    {
+        std::cout << argv[0] << " ERROR: Log file and source directories not provided" << std::endl;
+        return -1;
+    }
+
+    std::map<uint32_t, std::string> formats = {};
+
+    for (int i = 2; i < argc; i++)
+    {
+        collectFormats(argv[i], formats);
+    }
+
+    std::ifstream        stream(argv[1], std::ios::in | std::ios::binary);
+    std::vector<uint8_t> contents((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+
+    static constexpr const char* SOURCE_STRING[] = { "BOARD", "APP" };
+    static constexpr const char* LEVEL_STRING[]  = { "INF", "WRN", "ERR" };
+
+    size_t i = 0;
+
+    while ((i + board::logger::RECORD_HEADER_SIZE) <= contents.size())
+    {
+        // resynchronize on garbage or partially captured records
+        if (contents.at(i) != board::logger::RECORD_SYNC)
+        {
+            i++;
+            continue;
+        }
+
+        size_t recordSize = contents.at(i + 1) + 2;
+
+        if ((recordSize < board::logger::RECORD_HEADER_SIZE) ||
+            (recordSize > board::logger::MAX_RECORD_SIZE) ||
+            ((i + recordSize) > contents.size()))
+        {
+            i++;
+            continue;
+        }
+
+        const uint8_t* record = &contents.at(i);
+        uint8_t        source = record[2] >> 4;
+        uint8_t        level  = record[2] & 0x0F;
+        uint32_t       id     = record[3] | (record[4] << 8) | (record[5] << 16) | (static_cast<uint32_t>(record[6]) << 24);
+
+        std::vector<Argument> arguments = {};
+
+        if ((source > 1) || (level > 2) || !decodeArguments(&record[board::logger::RECORD_HEADER_SIZE], recordSize - board::logger::RECORD_HEADER_SIZE, arguments))
+        {
+            i++;
+            continue;
+        }
+
+        std::cout << "[" << SOURCE_STRING[source] << "][" << LEVEL_STRING[level] << "] ";
+
+        auto format = formats.find(id);
+
+        if (format != formats.end())
+        {
+            std::cout << expand(format->second, arguments);
+        }
+        else
+        {
+            std::cout << "<unknown format 0x" << std::hex << id << std::dec << ">";
+        }
+
+        std::cout << std::endl;
+        i += recordSize;
+    }
+
+    return 0;
+}
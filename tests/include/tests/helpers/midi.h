@@ -59,45 +59,17 @@ namespace test
 
         std::vector<protocol::midi::UsbPacket> rawSysExToUSBPackets(std::vector<uint8_t>& raw)
         {
-            messaging::Event event = {};
-            event.sysEx            = &raw[0];
-            event.sysExLength      = raw.size();
-            event.message          = protocol::midi::messageType_t::SYS_EX;
+            HWAWriteToUSB       hwaWriteToUSB;
+            lib::midi::usb::Usb writeToUsb(hwaWriteToUSB);
+            writeToUsb.init();
+            writeToUsb.sendSysEx(raw.size(), &raw[0], true);
 
-            return midiToUsbPackets(event);
+            return hwaWriteToUSB._buffer;
         }
 
         std::vector<protocol::midi::UsbPacket> midiToUsbPackets(messaging::Event event)
         {
-            class HWAWriteToUSB : public lib::midi::usb::Hwa
-            {
-                public:
-                HWAWriteToUSB() = default;
-
-                bool init() override
-                {
-                    return true;
-                }
-
-                bool deInit() override
-                {
-                    return true;
-                }
-
-                bool read(protocol::midi::UsbPacket& packet) override
-                {
-                    return false;
-                }
-
-                bool write(protocol::midi::UsbPacket& packet) override
-                {
-                    _buffer.push_back(packet);
-                    return true;
-                }
-
-                std::vector<protocol::midi::UsbPacket> _buffer;
-            } hwaWriteToUSB;
-
+            HWAWriteToUSB       hwaWriteToUSB;
             lib::midi::usb::Usb writeToUsb(hwaWriteToUSB);
             writeToUsb.init();
 
@@ -229,12 +201,6 @@ namespace test
             }
             break;
 
-            case protocol::midi::messageType_t::SYS_EX:
-            {
-                writeToUsb.sendSysEx(event.sysExLength, event.sysEx, true);
-            }
-            break;
-
             default:
                 break;
             }
@@ -529,12 +495,7 @@ namespace test
 
             std::cout << std::endl;
 
-            messaging::Event event = {};
-            event.sysEx            = &request[0];
-            event.sysExLength      = request.size();
-            event.message          = protocol::midi::messageType_t::SYS_EX;
-
-            processIncoming(event);
+            processIncoming(rawSysExToUSBPackets(request));
 
             auto response     = _system->_components._builderMidi._hwaUsb._writeParser.writtenMessages().at(0).sysexArray;
             auto responseSize = _system->_components._builderMidi._hwaUsb._writeParser.writtenMessages().at(0).length;
@@ -556,6 +517,11 @@ namespace test
         }
 
         void processIncoming(messaging::Event event)
+        {
+            processIncoming(midiToUsbPackets(event));
+        }
+
+        void processIncoming(std::vector<protocol::midi::UsbPacket> packets)
         {
             if (_system == nullptr)
             {
@@ -567,7 +533,7 @@ namespace test
             _system->_components._builderMidi._hwaUsb.clear();
             _system->_components._builderMidi._hwaSerial.clear();
 
-            _system->_components._builderMidi._hwaUsb._readPackets = midiToUsbPackets(event);
+            _system->_components._builderMidi._hwaUsb._readPackets = packets;
 
             // don't care about hwa calls here
             EXPECT_CALL(_system->_components._builderButtons._hwa, state(_, _, _))
@@ -577,7 +543,8 @@ namespace test
                 .Times(AnyNumber());
 
             // now just call system which will call midi.read which in turn will read the filled packets
-            while (_system->_components._builderMidi._hwaUsb._readPackets.size())
+            // incoming messages are processed in limited batches so keep running until everything is processed
+            while (_system->_components._builderMidi._hwaUsb._readPackets.size() || _system->_components._builderMidi._instance.pending())
             {
                 _system->_instance.run();
             }
@@ -625,6 +592,35 @@ namespace test
         }
 
         private:
+        class HWAWriteToUSB : public lib::midi::usb::Hwa
+        {
+            public:
+            HWAWriteToUSB() = default;
+
+            bool init() override
+            {
+                return true;
+            }
+
+            bool deInit() override
+            {
+                return true;
+            }
+
+            bool read(protocol::midi::UsbPacket& packet) override
+            {
+                return false;
+            }
+
+            bool write(protocol::midi::UsbPacket& packet) override
+            {
+                _buffer.push_back(packet);
+                return true;
+            }
+
+            std::vector<protocol::midi::UsbPacket> _buffer;
+        };
+
 #ifdef PROJECT_TARGET_HW_TESTS_SUPPORTED
         int32_t sendRequestToDevice(std::vector<uint8_t>& request, lib::sysexconf::wish_t wish)
         {
@@ -0,0 +1,130 @@
+/*
+
+Copyright Igor Petrovic
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#include "tests/common.h"
+#include "common/io/analog/scan_list.h"
+
+#include <vector>
+
+using namespace board::detail::io::analog;
+
+namespace
+{
+    constexpr size_t CHANNELS = 8;
+
+    /// Smallest difference between two readings after which the channel is considered moving.
+    constexpr uint16_t MOVEMENT = (CORE_MCU_ADC_MAX_VALUE + 1) / 128;
+
+    /// Amount of readings without movement after which the channel is returned to regular scanning.
+    constexpr size_t HOLD_READINGS = 255;
+
+    class AnalogInTest : public ::testing::Test
+    {
+        protected:
+        std::vector<uint8_t> scan(size_t conversions)
+        {
+            std::vector<uint8_t> channels;
+
+            for (size_t i = 0; i < conversions; i++)
+            {
+                channels.push_back(_scanList.next());
+            }
+
+            return channels;
+        }
+
+        ScanList<CHANNELS> _scanList;
+    };
+}    // namespace
+
+TEST_F(AnalogInTest, Order)
+{
+    // all channels are enabled by default and scanned in ascending order
+    ASSERT_EQ((std::vector<uint8_t>{ 0, 1, 2, 3, 4, 5, 6, 7, 0, 1 }), scan(10));
+
+    // change is applied only once the current pass is completed
+    _scanList.setEnabled(2, false);
+    _scanList.setEnabled(5, false);
+
+    ASSERT_EQ((std::vector<uint8_t>{ 2, 3, 4, 5, 6, 7, 0, 1, 3, 4, 6, 7, 0 }), scan(13));
+
+    _scanList.setEnabled(5, true);
+
+    ASSERT_EQ((std::vector<uint8_t>{ 1, 3, 4, 6, 7, 0, 1, 3, 4, 5, 6, 7 }), scan(12));
+
+    // out of range channels are ignored
+    _scanList.setEnabled(CHANNELS, false);
+
+    ASSERT_EQ((std::vector<uint8_t>{ 0, 1, 3, 4, 5, 6, 7 }), scan(7));
+}
+
+TEST_F(AnalogInTest, SingleEnabledChannel)
+{
+    for (size_t channel = 0; channel < CHANNELS; channel++)
+    {
+        _scanList.setEnabled(channel, channel == 4);
+    }
+
+    ASSERT_EQ(std::vector<uint8_t>(5, 4), scan(5));
+
+    // moving channel doesn't change anything when it's the only one scanned
+    _scanList.reading(4, 0, MOVEMENT);
+
+    ASSERT_EQ(std::vector<uint8_t>(5, 4), scan(5));
+
+    // nothing enabled: first channel keeps being converted
+    _scanList.setEnabled(4, false);
+    scan(1);
+
+    ASSERT_EQ(std::vector<uint8_t>(5, 0), scan(5));
+}
+
+TEST_F(AnalogInTest, MovingChannelIsPrioritized)
+{
+    // difference below the threshold isn't considered as movement
+    _scanList.reading(3, 100, 100 + MOVEMENT - 1);
+
+    ASSERT_EQ((std::vector<uint8_t>{ 0, 1, 2, 3, 4, 5, 6, 7 }), scan(CHANNELS));
+
+    // moving channel is scanned on every other conversion, in either direction
+    _scanList.reading(3, 100 + MOVEMENT, 100);
+
+    ASSERT_EQ((std::vector<uint8_t>{ 3, 0, 3, 1, 3, 2, 3, 3, 3, 4, 3, 5, 3, 6, 3, 7 }), scan(CHANNELS * 2));
+
+    // multiple moving channels are served in turns
+    _scanList.reading(6, 0, MOVEMENT);
+
+    ASSERT_EQ((std::vector<uint8_t>{ 6, 0, 3, 1, 6, 2, 3, 3 }), scan(CHANNELS));
+
+    // channel is returned to regular scanning only after it stops moving for a while
+    for (size_t i = 0; i < HOLD_READINGS - 1; i++)
+    {
+        _scanList.reading(3, 100, 100);
+    }
+
+    ASSERT_EQ((std::vector<uint8_t>{ 6, 4, 3, 5 }), scan(4));
+
+    _scanList.reading(3, 100, 100);
+
+    ASSERT_EQ((std::vector<uint8_t>{ 6, 6, 6, 7, 6, 0 }), scan(6));
+
+    // disabled channel is no longer prioritized once the list is rebuilt at the start of the next pass
+    _scanList.setEnabled(6, false);
+
+    ASSERT_EQ((std::vector<uint8_t>{ 6, 1, 6, 2, 6, 3, 6, 4, 6, 5, 6, 6, 6, 7, 6, 0, 1, 2, 3 }), scan(19));
+}
@@ -20,6 +20,7 @@ limitations under the License.
 
 #include "tests/common.h"
 #include "application/database/builder.h"
+#include "application/database/hwa_hw.h"
 #include "application/io/buttons/buttons.h"
 #include "application/io/encoders/encoders.h"
 #include "application/io/analog/analog.h"
@@ -29,6 +30,9 @@ limitations under the License.
 #include "application/protocol/midi/midi.h"
 #include "application/util/configurable/configurable.h"
 
+#include <chrono>
+#include <map>
+
 namespace
 {
     class DatabaseTest : public ::testing::Test
@@ -45,14 +49,207 @@ namespace
         {
             ConfigHandler.clear();
             MidiDispatcher.clear();
+            SysExDispatcher.clear();
         }
 
         database::Builder _database;
     };
 
     uint32_t _dbReadRetVal;
+
+    /// Board NVM on which database::HwaHw is tested.
+    /// Values end up in the same storage as used by the test database, while cache-only writes
+    /// are kept aside until the cache is flushed, same as with emulated EEPROM.
+    class BoardNvm
+    {
+        public:
+        void reset()
+        {
+            _cache.clear();
+            _storageWrites = 0;
+            _flushes       = 0;
+            _updates       = 0;
+            _eraseAllowed  = false;
+        }
+
+        bool init()
+        {
+            _cache.clear();
+            return _storage.init();
+        }
+
+        uint32_t size()
+        {
+            return _storage.size();
+        }
+
+        bool clear()
+        {
+            _cache.clear();
+            return _storage.clear();
+        }
+
+        bool read(uint32_t address, uint32_t& value, board::nvm::parameterType_t type)
+        {
+            auto cached = _cache.find(address);
+
+            if (cached != _cache.end())
+            {
+                value = cached->second.value;
+                return true;
+            }
+
+            return _storage.read(address, value, storageType(type));
+        }
+
+        bool write(uint32_t address, uint32_t value, board::nvm::parameterType_t type, bool cacheOnly)
+        {
+            if (cacheOnly)
+            {
+                _cache[address] = { value, type };
+                return true;
+            }
+
+            _cache.erase(address);
+            _storageWrites++;
+
+            return _storage.write(address, value, storageType(type));
+        }
+
+        void writeCacheToFlash()
+        {
+            _flushes++;
+
+            for (const auto& [address, cached] : _cache)
+            {
+                _storageWrites++;
+                _storage.write(address, cached.value, storageType(cached.type));
+            }
+
+            _cache.clear();
+        }
+
+        void update(bool eraseAllowed)
+        {
+            _updates++;
+            _eraseAllowed = eraseAllowed;
+        }
+
+        /// Amount of values which have reached the storage.
+        size_t _storageWrites = 0;
+
+        /// Amount of cache flushes.
+        size_t _flushes = 0;
+
+        /// Amount of maintenance steps and whether the last one was allowed to erase flash.
+        size_t _updates      = 0;
+        bool   _eraseAllowed = false;
+
+        private:
+        struct Cached
+        {
+            uint32_t                    value;
+            board::nvm::parameterType_t type;
+        };
+
+        database::HwaTest          _storage;
+        std::map<uint32_t, Cached> _cache;
+
+        static lib::lessdb::sectionParameterType_t storageType(board::nvm::parameterType_t type)
+        {
+            switch (type)
+            {
+            case board::nvm::parameterType_t::WORD:
+                return lib::lessdb::sectionParameterType_t::WORD;
+
+            case board::nvm::parameterType_t::DWORD:
+                return lib::lessdb::sectionParameterType_t::DWORD;
+
+            default:
+                return lib::lessdb::sectionParameterType_t::BYTE;
+            }
+        }
+    } boardNvm;
+
+    class DatabaseHwaTest : public ::testing::Test
+    {
+        protected:
+        void SetUp() override
+        {
+            ASSERT_TRUE(_hwa.init());
+            ASSERT_TRUE(boardNvm.clear());
+            boardNvm.reset();
+        }
+
+        void TearDown() override
+        {
+            ConfigHandler.clear();
+            MidiDispatcher.clear();
+            SysExDispatcher.clear();
+        }
+
+        void notify(messaging::systemMessage_t message)
+        {
+            messaging::Event event = {};
+            event.systemMessage    = message;
+
+            MidiDispatcher.notify(messaging::eventType_t::SYSTEM, event);
+        }
+
+        database::HwaHw _hwa;
+    };
 }    // namespace
 
+namespace board
+{
+    void reboot()
+    {}
+
+    namespace usb
+    {
+        void deInit()
+        {}
+    }    // namespace usb
+
+    namespace nvm
+    {
+        bool init()
+        {
+            return boardNvm.init();
+        }
+
+        uint32_t size()
+        {
+            return boardNvm.size();
+        }
+
+        bool clear(uint32_t start, uint32_t end)
+        {
+            return boardNvm.clear();
+        }
+
+        bool read(uint32_t address, uint32_t& value, parameterType_t type)
+        {
+            return boardNvm.read(address, value, type);
+        }
+
+        bool write(uint32_t address, uint32_t value, parameterType_t type, bool cacheOnly)
+        {
+            return boardNvm.write(address, value, type, cacheOnly);
+        }
+
+        void writeCacheToFlash()
+        {
+            boardNvm.writeCacheToFlash();
+        }
+
+        void update(bool eraseAllowed)
+        {
+            boardNvm.update(eraseAllowed);
+        }
+    }    // namespace nvm
+}    // namespace board
+
 // more detailed check
 #define DB_READ_VERIFY(expected, section, value)                               \
     do                                                                         \
@@ -277,6 +474,20 @@ TEST_F(DatabaseTest, ReadInitialValues)
             DB_READ_VERIFY(0, database::Config::Section::analog_t::UPPER_OFFSET, i);
         }
 
+        // aftertouch rate section
+        // all values should be set to 0
+        for (size_t i = 0; i < io::analog::Collection::SIZE(); i++)
+        {
+            DB_READ_VERIFY(0, database::Config::Section::analog_t::AFTERTOUCH_RATE, i);
+        }
+
+        // aftertouch slew section
+        // all values should be set to 0
+        for (size_t i = 0; i < io::analog::Collection::SIZE(); i++)
+        {
+            DB_READ_VERIFY(0, database::Config::Section::analog_t::AFTERTOUCH_SLEW, i);
+        }
+
         // LED block
         //----------------------------------
         // global section
@@ -484,6 +695,145 @@ TEST_F(DatabaseTest, FactoryReset)
     ASSERT_FALSE(_database.instance().getPresetPreserveState());
 }
 
+TEST_F(DatabaseTest, SystemSettings)
+{
+    constexpr auto SETTING = static_cast<size_t>(database::Config::systemSetting_t::CUSTOM_SYSTEM_SETTING_START);
+
+    ASSERT_TRUE(_database.instance().update(database::Config::Section::system_t::SYSTEM_SETTINGS, SETTING, 1234));
+    ASSERT_EQ(1234, _database.instance().read(database::Config::Section::system_t::SYSTEM_SETTINGS, SETTING));
+
+    // system block is shared between presets
+    if (_database.instance().getSupportedPresets() > 1)
+    {
+        ASSERT_TRUE(_database.instance().setPreset(1));
+        ASSERT_EQ(1234, _database.instance().read(database::Config::Section::system_t::SYSTEM_SETTINGS, SETTING));
+    }
+
+    // value must be stored, not only cached
+    ASSERT_TRUE(_database.instance().init());
+    ASSERT_EQ(1234, _database.instance().read(database::Config::Section::system_t::SYSTEM_SETTINGS, SETTING));
+
+    ASSERT_TRUE(_database.instance().factoryReset());
+    ASSERT_EQ(0, _database.instance().read(database::Config::Section::system_t::SYSTEM_SETTINGS, SETTING));
+}
+
+TEST_F(DatabaseHwaTest, TransactionCollapsesFlashWrites)
+{
+    constexpr uint32_t ADDRESS_1 = 10;
+    constexpr uint32_t ADDRESS_2 = 20;
+    constexpr size_t   TOGGLES   = 16;
+
+    notify(messaging::systemMessage_t::CONFIG_TRANSACTION_START);
+
+    for (size_t i = 0; i < TOGGLES; i++)
+    {
+        ASSERT_TRUE(_hwa.write(ADDRESS_1, i % 2, database::Admin::sectionParameterType_t::BYTE));
+        ASSERT_TRUE(_hwa.write(ADDRESS_2, i, database::Admin::sectionParameterType_t::WORD));
+    }
+
+    // nothing is stored before commit, but the latest values are readable
+    ASSERT_EQ(0, boardNvm._storageWrites);
+
+    uint32_t value = 0;
+    ASSERT_TRUE(_hwa.read(ADDRESS_2, value, database::Admin::sectionParameterType_t::WORD));
+    ASSERT_EQ(TOGGLES - 1, value);
+
+    // commit stores each changed value once
+    notify(messaging::systemMessage_t::CONFIG_TRANSACTION_END);
+
+    ASSERT_EQ(1, boardNvm._flushes);
+    ASSERT_EQ(2, boardNvm._storageWrites);
+
+    ASSERT_TRUE(_hwa.read(ADDRESS_1, value, database::Admin::sectionParameterType_t::BYTE));
+    ASSERT_EQ((TOGGLES - 1) % 2, value);
+    ASSERT_TRUE(_hwa.read(ADDRESS_2, value, database::Admin::sectionParameterType_t::WORD));
+    ASSERT_EQ(TOGGLES - 1, value);
+
+    // writes after commit go straight to flash again
+    ASSERT_TRUE(_hwa.write(ADDRESS_1, 0x55, database::Admin::sectionParameterType_t::BYTE));
+    ASSERT_EQ(3, boardNvm._storageWrites);
+}
+
+TEST_F(DatabaseHwaTest, TrafficPostponesErase)
+{
+    constexpr uint32_t ADDRESS = 10;
+
+    _hwa.update();
+    ASSERT_EQ(1, boardNvm._updates);
+    ASSERT_TRUE(boardNvm._eraseAllowed);
+
+    notify(messaging::systemMessage_t::TRAFFIC_ACTIVE);
+
+    // storage keeps being maintained during traffic, but without erasing the flash
+    _hwa.update();
+    ASSERT_EQ(2, boardNvm._updates);
+    ASSERT_FALSE(boardNvm._eraseAllowed);
+
+    // writes are deferred until idle
+    ASSERT_TRUE(_hwa.write(ADDRESS, 0x55, database::Admin::sectionParameterType_t::BYTE));
+    ASSERT_EQ(0, boardNvm._storageWrites);
+
+    notify(messaging::systemMessage_t::TRAFFIC_IDLE);
+
+    ASSERT_EQ(1, boardNvm._flushes);
+    ASSERT_EQ(1, boardNvm._storageWrites);
+
+    _hwa.update();
+    ASSERT_TRUE(boardNvm._eraseAllowed);
+}
+
+TEST_F(DatabaseHwaTest, FactoryResetWrites)
+{
+    // amount of writes requested by database: test hardware stores all of them
+    database::Builder reference;
+
+    ASSERT_TRUE(reference.instance().init());
+    reference._hwa.resetStats();
+    ASSERT_TRUE(reference.instance().factoryReset());
+
+    database::AppLayout layout;
+    database::Admin     admin(_hwa, layout);
+
+    ASSERT_TRUE(admin.init());
+    boardNvm.reset();
+
+    auto start = std::chrono::steady_clock::now();
+
+    ASSERT_TRUE(admin.factoryReset());
+
+    auto elapsedUs = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+    LOG(INFO) << "Factory reset with " << static_cast<int>(admin.getSupportedPresets()) << " presets: "
+              << boardNvm._storageWrites << " of " << reference._hwa._writes << " parameter writes ("
+              << reference._hwa._bytesWritten << " bytes) stored in " << elapsedUs << " us";
+
+    // most parameters default to 0 which is what erased memory reads as anyway
+    ASSERT_LT(boardNvm._storageWrites, reference._hwa._writes);
+
+    // every requested write stores at least one byte
+    ASSERT_GE(reference._hwa._bytesWritten, reference._hwa._writes);
+
+    // same values are already stored: nothing is written again
+    constexpr uint32_t ADDRESS = 10;
+
+    uint32_t value = 0;
+    ASSERT_TRUE(_hwa.read(ADDRESS, value, database::Admin::sectionParameterType_t::BYTE));
+
+    boardNvm.reset();
+    ASSERT_TRUE(_hwa.write(ADDRESS, value, database::Admin::sectionParameterType_t::BYTE));
+    ASSERT_EQ(0, boardNvm._storageWrites);
+
+    // changed value is stored
+    ASSERT_TRUE(_hwa.write(ADDRESS, value + 1, database::Admin::sectionParameterType_t::BYTE));
+    ASSERT_EQ(1, boardNvm._storageWrites);
+
+    // cached writes are always passed through
+    notify(messaging::systemMessage_t::CONFIG_TRANSACTION_START);
+    ASSERT_TRUE(_hwa.write(ADDRESS, value + 1, database::Admin::sectionParameterType_t::BYTE));
+    notify(messaging::systemMessage_t::CONFIG_TRANSACTION_END);
+    ASSERT_EQ(2, boardNvm._storageWrites);
+}
+
 #ifdef PROJECT_TARGET_SUPPORT_LEDS
 TEST_F(DatabaseTest, LEDs)
 {
@@ -0,0 +1,602 @@
+/*
+
+Copyright Igor Petrovic
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#include "tests/common.h"
+#include "common/io/input/matrix_history.h"
+#include "common/io/input/matrix_rows.h"
+#include "common/io/input/contact_timing.h"
+#include "internal.h"
+#include "application/io/buttons/velocity.h"
+
+#include <chrono>
+#include <cmath>
+#include <type_traits>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define CYCLE_COUNTER() __rdtsc()
+#else
+#define CYCLE_COUNTER() static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count())
+#endif
+
+using namespace board::io::digital_in;
+using namespace board::detail::io::digital_in;
+
+namespace
+{
+    constexpr size_t SIM_PORTS = 3;
+
+    /// Simulated row wiring similar to the real boards: rows are split over several ports,
+    /// on consecutive pins which start at a different pin on each port.
+    template<size_t Rows>
+    constexpr uint8_t simPortIndex(size_t row)
+    {
+        return row / ((Rows + SIM_PORTS - 1) / SIM_PORTS);
+    }
+
+    template<size_t Rows>
+    constexpr uint8_t simPinIndex(size_t row)
+    {
+        return (row % ((Rows + SIM_PORTS - 1) / SIM_PORTS)) + (simPortIndex<Rows>(row) * 2) + 1;
+    }
+
+    /// Simulated GPIO scanned with the same row extraction and history as the board ISR.
+    template<size_t Columns, size_t Rows>
+    class SimulatedMatrix
+    {
+        public:
+        using History = MatrixHistory<Columns, Rows>;
+
+        static constexpr MatrixRows<Rows> MATRIX_ROWS = MatrixRows<Rows>(simPortIndex<Rows>, simPinIndex<Rows>);
+
+        void randomize(uint32_t& seed)
+        {
+            for (auto& port : gpio)
+            {
+                seed = seed * 1664525 + 1013904223;
+                port = seed;
+            }
+        }
+
+        /// Reference implementation: every row pin is read separately and
+        /// stored into per-key readings buffer.
+        void scanPerKey(size_t column)
+        {
+            for (size_t row = 0; row < Rows; row++)
+            {
+                size_t index = (row * Columns) + column;
+
+                uint16_t readings = perKey[index].readings;
+                uint8_t  count    = perKey[index].count;
+
+                readings = (readings << 1) | !((gpio[simPortIndex<Rows>(row)] >> simPinIndex<Rows>(row)) & 0x01);
+
+                if (++count > History::DEPTH)
+                {
+                    count = History::DEPTH;
+                }
+
+                perKey[index].readings = readings;
+                perKey[index].count    = count;
+            }
+        }
+
+        /// Same as the board ISR: each port is read once and rows are packed into the column history.
+        void scanPorts(size_t column)
+        {
+            uint32_t ports[SIM_PORTS];
+
+            for (size_t port = 0; port < SIM_PORTS; port++)
+            {
+                ports[port] = gpio[port];
+            }
+
+            history.store(column, static_cast<typename History::rowMask_t>(MATRIX_ROWS.read(ports)));
+        }
+
+        bool perKeyState(size_t index, Readings& readings)
+        {
+            readings.count      = perKey[index].count;
+            readings.readings   = perKey[index].readings;
+            perKey[index].count = 0;
+
+            return readings.count > 0;
+        }
+
+        /// Same as the board state(): only the snapshot is taken while the ISR would be blocked.
+        bool state(size_t index, Readings& readings)
+        {
+            typename History::Snapshot snapshot;
+            history.snapshot(index / Columns, index % Columns, snapshot);
+
+            return History::transpose(snapshot, index / Columns, readings);
+        }
+
+        volatile uint32_t gpio[SIM_PORTS]        = {};
+        volatile Readings perKey[Columns * Rows] = {};
+        History           history;
+    };
+
+    template<size_t Columns, size_t Rows>
+    void benchmark()
+    {
+        using Matrix = SimulatedMatrix<Columns, Rows>;
+
+        static constexpr size_t SCANS   = 4000;
+        static constexpr size_t REPEATS = 5;
+        auto                    matrix  = std::make_unique<Matrix>();
+        uint32_t                seed    = 1;
+
+        // rows on consecutive pins need single mask and shift per port
+        static_assert(Matrix::MATRIX_ROWS.groups() == SIM_PORTS);
+
+        // only the snapshot is taken under lock: transposing doesn't access the shared history
+        static_assert(std::is_same_v<decltype(&Matrix::History::transpose),
+                                     bool (*)(const typename Matrix::History::Snapshot&, size_t, Readings&)>);
+
+        matrix->randomize(seed);
+
+        // fastest of several runs is used to filter out preemption and other noise
+        auto measure = [&](auto scan)
+        {
+            double fastest = 0;
+
+            for (size_t repeat = 0; repeat < REPEATS; repeat++)
+            {
+                auto start = CYCLE_COUNTER();
+
+                for (size_t i = 0; i < SCANS; i++)
+                {
+                    for (size_t column = 0; column < Columns; column++)
+                    {
+                        scan(column);
+                    }
+                }
+
+                auto cycles = static_cast<double>(CYCLE_COUNTER() - start) / SCANS;
+
+                if (!repeat || (cycles < fastest))
+                {
+                    fastest = cycles;
+                }
+            }
+
+            return fastest;
+        };
+
+        auto perKey = measure([&](size_t column)
+                              {
+                                  matrix->scanPerKey(column);
+                              });
+
+        auto ports = measure([&](size_t column)
+                             {
+                                 matrix->scanPorts(column);
+                             });
+
+        // single key per column is read on each call to keep the history from being consumed entirely
+        Readings                           readings = {};
+        typename Matrix::History::Snapshot snapshot;
+        size_t                             sink = 0;
+
+        auto locked = measure([&](size_t column)
+                              {
+                                  matrix->history.snapshot(column % Rows, column, snapshot);
+                                  sink += snapshot.newCount;
+                              });
+
+        auto state = measure([&](size_t column)
+                             {
+                                 sink += matrix->state(((column % Rows) * Columns) + column, readings);
+                             });
+
+        LOG(INFO) << Columns << "x" << Rows << " matrix, cycles per ISR scan: per key " << perKey << ", port-wide " << ports
+                  << ", cycles per matrix state read: under lock " << locked << ", total " << state << " (" << sink << ")";
+
+        // ISR reads each port once instead of each row separately
+        ASSERT_LT(ports, perKey);
+    }
+
+    /// Simulated dual-contact keys in button matrix scanned every FAST_SCAN_TIMEOUT_US.
+    /// Contacts of each key are closed and opened at exact (sub-scan) times. Optionally, contacts
+    /// bounce after each change: every other scan within the bounce time reads the previous state.
+    template<size_t Columns, size_t Rows>
+    class SimulatedKeybed
+    {
+        public:
+        static constexpr uint32_t SCAN_TIME = FAST_SCAN_TIMEOUT_US;
+
+        struct Strike
+        {
+            size_t   row;
+            size_t   column;
+            uint32_t firstClose;
+            uint32_t secondClose;
+            uint32_t secondOpen;
+            uint32_t firstOpen;
+            uint32_t bounce;
+        };
+
+        /// Scans the matrix until the specified time.
+        void run(const Strike& strike, uint32_t until)
+        {
+            for (; _time < until; _time += SCAN_TIME)
+            {
+                typename ContactTiming<Columns, Rows>::rowMask_t rows = 0;
+
+                if (contact(strike.firstClose, strike.firstOpen, strike.bounce))
+                {
+                    rows |= static_cast<decltype(rows)>(1) << strike.row;
+                }
+
+                if (contact(strike.secondClose, strike.secondOpen, strike.bounce))
+                {
+                    rows |= static_cast<decltype(rows)>(1) << (strike.row + 1);
+                }
+
+                timing.scan(strike.column, rows, _time);
+            }
+        }
+
+        uint32_t time() const
+        {
+            return _time;
+        }
+
+        ContactTiming<Columns, Rows> timing;
+
+        private:
+        uint32_t _time = 0;
+
+        bool contact(uint32_t close, uint32_t open, uint32_t bounce) const
+        {
+            bool state = (_time >= close) && (_time < open);
+
+            for (auto change : { close, open })
+            {
+                if ((_time >= change) && ((_time - change) < bounce) && (((_time - change) / SCAN_TIME) % 2))
+                {
+                    state = !state;
+                }
+            }
+
+            return state;
+        }
+    };
+
+    /// Reference velocity calculated in floating point from the exact time between the contacts.
+    double referenceVelocity(double interval)
+    {
+        const double FASTEST = io::buttons::Velocity::FASTEST_INTERVAL_US;
+        const double SLOWEST = io::buttons::Velocity::SLOWEST_INTERVAL_US;
+
+        double speed = std::log(SLOWEST / interval) / std::log(SLOWEST / FASTEST);
+        speed        = std::min(1.0, std::max(0.0, speed));
+
+        return 1 + (126 * speed);
+    }
+
+    class DigitalInTest : public ::testing::Test
+    {};
+}    // namespace
+
+TEST_F(DigitalInTest, LazyReadingsMatchPerKeyBuffers)
+{
+    constexpr size_t COLUMNS = 8;
+    constexpr size_t ROWS    = 8;
+
+    auto     matrix = std::make_unique<SimulatedMatrix<COLUMNS, ROWS>>();
+    uint32_t seed   = 1;
+
+    for (size_t iteration = 0; iteration < 100; iteration++)
+    {
+        // vary the amount of scans between two reads, including more than history depth
+        size_t scans = iteration % 20;
+
+        for (size_t scan = 0; scan < scans; scan++)
+        {
+            matrix->randomize(seed);
+
+            for (size_t column = 0; column < COLUMNS; column++)
+            {
+                matrix->scanPerKey(column);
+                matrix->scanPorts(column);
+            }
+        }
+
+        for (size_t index = 0; index < COLUMNS * ROWS; index++)
+        {
+            Readings expected = {};
+            Readings actual   = {};
+
+            ASSERT_EQ(matrix->perKeyState(index, expected), matrix->state(index, actual));
+            ASSERT_EQ(expected.count, actual.count);
+            ASSERT_EQ(expected.readings, actual.readings);
+        }
+    }
+}
+
+TEST_F(DigitalInTest, RowGroupsMatchPerRowReads)
+{
+    constexpr size_t ROWS = 16;
+
+    // scattered wiring: no two rows can share a group
+    constexpr auto SCATTERED = MatrixRows<ROWS>([](size_t row)
+                                                {
+                                                    return static_cast<uint8_t>(row % SIM_PORTS);
+                                                },
+                                                [](size_t row)
+                                                {
+                                                    return static_cast<uint8_t>(((row / SIM_PORTS) * 2) + 1);
+                                                });
+
+    // reversed wiring on single port: rows and pins run in opposite directions
+    constexpr auto REVERSED = MatrixRows<ROWS>([](size_t)
+                                               {
+                                                   return static_cast<uint8_t>(0);
+                                               },
+                                               [](size_t row)
+                                               {
+                                                   return static_cast<uint8_t>(31 - row);
+                                               });
+
+    static_assert(SCATTERED.groups() == ROWS);
+    static_assert(REVERSED.groups() == ROWS);
+    constexpr auto& SIMULATED = SimulatedMatrix<1, ROWS>::MATRIX_ROWS;
+
+    static_assert(SIMULATED.groups() == SIM_PORTS);
+
+    uint32_t seed = 1;
+
+    for (size_t iteration = 0; iteration < 1000; iteration++)
+    {
+        uint32_t ports[SIM_PORTS];
+
+        for (auto& port : ports)
+        {
+            seed = seed * 1664525 + 1013904223;
+            port = seed;
+        }
+
+        uint32_t scattered = 0;
+        uint32_t reversed  = 0;
+        uint32_t simulated = 0;
+
+        for (size_t row = 0; row < ROWS; row++)
+        {
+            scattered |= static_cast<uint32_t>(!((ports[row % SIM_PORTS] >> (((row / SIM_PORTS) * 2) + 1)) & 0x01)) << row;
+            reversed |= static_cast<uint32_t>(!((ports[0] >> (31 - row)) & 0x01)) << row;
+            simulated |= static_cast<uint32_t>(!((ports[simPortIndex<ROWS>(row)] >> simPinIndex<ROWS>(row)) & 0x01)) << row;
+        }
+
+        ASSERT_EQ(scattered, SCATTERED.read(ports));
+        ASSERT_EQ(reversed, REVERSED.read(ports));
+        ASSERT_EQ(simulated, SIMULATED.read(ports));
+    }
+}
+
+TEST_F(DigitalInTest, FlushDiscardsReadings)
+{
+    auto     matrix = std::make_unique<SimulatedMatrix<8, 8>>();
+    uint32_t seed   = 1;
+
+    matrix->randomize(seed);
+    matrix->scanPorts(0);
+    matrix->history.flush();
+
+    Readings readings = {};
+    ASSERT_FALSE(matrix->history.state(0, 0, readings));
+}
+
+TEST_F(DigitalInTest, Benchmark)
+{
+    benchmark<8, 8>();
+    benchmark<16, 16>();
+}
+
+TEST_F(DigitalInTest, DualContactVelocity)
+{
+    constexpr size_t COLUMNS = 8;
+    constexpr size_t ROWS    = 8;
+
+    using Keybed = SimulatedKeybed<COLUMNS, ROWS>;
+
+    auto     keybed   = std::make_unique<Keybed>();
+    uint32_t seed     = 1;
+    size_t   key      = 0;
+    double   maxError = 0;
+    double   sumError = 0;
+    size_t   strikes  = 0;
+
+    // sweep the whole playing range, including strikes faster and slower than the velocity limits
+    for (double interval = 1000; interval < 100000; interval *= 1.02)
+    {
+        seed = seed * 1664525 + 1013904223;
+
+        Keybed::Strike strike = {};
+        strike.row            = (key % (ROWS / 2)) * 2;
+        strike.column         = (key / (ROWS / 2)) % COLUMNS;
+        strike.firstClose     = keybed->time() + 1000 + (seed % Keybed::SCAN_TIME);
+        strike.secondClose    = strike.firstClose + static_cast<uint32_t>(interval);
+        strike.secondOpen     = strike.secondClose + 50000;
+        strike.firstOpen      = strike.secondOpen + 5000;
+        key++;
+
+        keybed->run(strike, strike.firstOpen + Keybed::SCAN_TIME);
+
+        // interval is reported only via the first contact
+        uint32_t captured = 0;
+        ASSERT_FALSE(keybed->timing.interval(strike.row + 1, strike.column, captured));
+        ASSERT_TRUE(keybed->timing.interval(strike.row, strike.column, captured));
+
+        // only one interval per strike
+        uint32_t again = 0;
+        ASSERT_FALSE(keybed->timing.interval(strike.row, strike.column, again));
+
+        // contacts are timestamped with the resolution of a single scan
+        ASSERT_LT(std::abs(static_cast<double>(captured) - interval), Keybed::SCAN_TIME);
+
+        auto   velocity = io::buttons::Velocity::value(captured, io::buttons::velocityCurve_t::LINEAR);
+        double error    = std::abs(velocity - referenceVelocity(interval));
+
+        // allowed error: timestamp resolution, linear interpolation in fixed point logarithm (up to 2) and rounding
+        double allowed = std::abs(referenceVelocity(interval - Keybed::SCAN_TIME) - referenceVelocity(interval + Keybed::SCAN_TIME)) + 2.5;
+
+        ASSERT_LE(error, allowed) << "interval " << interval << "us, captured " << captured << "us";
+
+        maxError = std::max(maxError, error);
+        sumError += error;
+        strikes++;
+    }
+
+    ASSERT_LT(sumError / strikes, 1);
+
+    LOG(INFO) << "Dual-contact velocity over " << strikes << " strikes: mean error " << (sumError / strikes) << ", max error " << maxError;
+}
+
+TEST_F(DigitalInTest, DualContactPartialStrokes)
+{
+    using Keybed = SimulatedKeybed<4, 4>;
+
+    auto     keybed   = std::make_unique<Keybed>();
+    uint32_t captured = 0;
+
+    // key doesn't reach the second contact: no note
+    Keybed::Strike strike = {};
+    strike.row            = 2;
+    strike.column         = 1;
+    strike.firstClose     = 1000;
+    strike.secondClose    = UINT32_MAX;
+    strike.secondOpen     = UINT32_MAX;
+    strike.firstOpen      = 20000;
+
+    keybed->run(strike, 30000);
+    ASSERT_FALSE(keybed->timing.interval(strike.row, strike.column, captured));
+
+    // full strike
+    strike.firstClose  = 30000;
+    strike.secondClose = 40000;
+    strike.secondOpen  = 60000;
+    strike.firstOpen   = 200000;
+
+    keybed->run(strike, 60000);
+    ASSERT_TRUE(keybed->timing.interval(strike.row, strike.column, captured));
+    ASSERT_EQ(10000, captured);
+
+    // key partially released and struck again while the first contact is still closed:
+    // timing restarts once the second contact opens
+    strike.secondClose = 65000;
+    strike.secondOpen  = 100000;
+
+    keybed->run(strike, 100000);
+    ASSERT_TRUE(keybed->timing.interval(strike.row, strike.column, captured));
+    ASSERT_EQ(5000, captured);
+
+    // both contacts closed within the same scan: fastest possible strike
+    strike.firstClose  = 300000;
+    strike.secondClose = 300000;
+    strike.secondOpen  = 310000;
+    strike.firstOpen   = 320000;
+
+    keybed->run(strike, 330000);
+    ASSERT_TRUE(keybed->timing.interval(strike.row, strike.column, captured));
+    ASSERT_EQ(0, captured);
+    ASSERT_EQ(127, io::buttons::Velocity::value(captured, io::buttons::velocityCurve_t::LINEAR));
+
+    // captured interval isn't lost if the key is released before it's retrieved
+    strike.firstClose  = 400000;
+    strike.secondClose = 420000;
+    strike.secondOpen  = 430000;
+    strike.firstOpen   = 440000;
+
+    keybed->run(strike, 450000);
+    ASSERT_TRUE(keybed->timing.interval(strike.row, strike.column, captured));
+    ASSERT_EQ(20000, captured);
+    ASSERT_FALSE(keybed->timing.interval(strike.row, strike.column, captured));
+}
+
+TEST_F(DigitalInTest, DualContactBouncing)
+{
+    constexpr size_t COLUMNS = 4;
+    constexpr size_t ROWS    = 4;
+    constexpr size_t BOUNCE  = 500;
+
+    using Keybed = SimulatedKeybed<COLUMNS, ROWS>;
+
+    static_assert((Keybed::SCAN_TIME < decltype(Keybed::timing)::DEBOUNCE_TIME) &&
+                      (Keybed::SCAN_TIME < decltype(Keybed::timing)::RELEASE_HOLD_TIME),
+                  "Single bounce should be shorter than debounce times");
+
+    auto     keybed  = std::make_unique<Keybed>();
+    uint32_t seed    = 1;
+    size_t   strikes = 0;
+
+    // every contact change bounces, yet each strike results in single interval timed from the first closing
+    for (double interval = 1000; interval < 100000; interval *= 1.1)
+    {
+        seed = seed * 1664525 + 1013904223;
+
+        Keybed::Strike strike = {};
+        strike.row            = (strikes % (ROWS / 2)) * 2;
+        strike.column         = (strikes / (ROWS / 2)) % COLUMNS;
+        strike.firstClose     = keybed->time() + 2000 + (seed % Keybed::SCAN_TIME);
+        strike.secondClose    = strike.firstClose + static_cast<uint32_t>(interval);
+        strike.secondOpen     = strike.secondClose + 50000;
+        strike.firstOpen      = strike.secondOpen + 5000;
+        strike.bounce         = BOUNCE;
+
+        keybed->run(strike, strike.firstOpen + BOUNCE + Keybed::SCAN_TIME);
+
+        uint32_t captured = 0;
+        ASSERT_TRUE(keybed->timing.interval(strike.row, strike.column, captured)) << "interval " << interval << "us";
+        ASSERT_LT(std::abs(static_cast<double>(captured) - interval), Keybed::SCAN_TIME) << "interval " << interval << "us";
+
+        // bouncing of the second contact isn't a new strike
+        ASSERT_FALSE(keybed->timing.interval(strike.row, strike.column, captured));
+
+        strikes++;
+    }
+
+    // second contact reopened only briefly while the key is held: no new strike
+    Keybed::Strike strike = {};
+    strike.row            = 0;
+    strike.column         = 0;
+    strike.firstClose     = keybed->time() + 2000;
+    strike.secondClose    = strike.firstClose + 5000;
+    strike.secondOpen     = strike.secondClose + 10000;
+    strike.firstOpen      = UINT32_MAX;
+
+    uint32_t captured = 0;
+
+    keybed->run(strike, strike.secondOpen);
+    ASSERT_TRUE(keybed->timing.interval(strike.row, strike.column, captured));
+
+    strike.secondClose = strike.secondOpen + decltype(Keybed::timing)::RELEASE_HOLD_TIME - Keybed::SCAN_TIME;
+    strike.secondOpen  = strike.secondClose + 10000;
+
+    keybed->run(strike, strike.secondOpen);
+    ASSERT_FALSE(keybed->timing.interval(strike.row, strike.column, captured));
+
+    // held open for long enough: key is struck again
+    strike.secondClose = strike.secondOpen + decltype(Keybed::timing)::RELEASE_HOLD_TIME + Keybed::SCAN_TIME;
+    strike.secondOpen  = UINT32_MAX;
+
+    keybed->run(strike, strike.secondClose + Keybed::SCAN_TIME);
+    ASSERT_TRUE(keybed->timing.interval(strike.row, strike.column, captured));
+    ASSERT_LT(std::abs(static_cast<double>(captured) - (decltype(Keybed::timing)::RELEASE_HOLD_TIME + Keybed::SCAN_TIME)), Keybed::SCAN_TIME);
+}
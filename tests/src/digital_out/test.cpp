@@ -0,0 +1,157 @@
+/*
+
+Copyright Igor Petrovic
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#if defined(PROJECT_TARGET_DRIVER_DIGITAL_OUTPUT_SHIFT_REGISTER) || defined(PROJECT_TARGET_DRIVER_DIGITAL_OUTPUT_MAX7219)
+
+#include "tests/common.h"
+#include "board/board.h"
+#include "internal.h"
+#include "helpers.h"
+
+#include <target.h>
+
+namespace
+{
+    size_t clockEdges;
+
+    template<typename Port, typename Index>
+    void tracePinLow(Port port, Index index)
+    {
+#ifdef PROJECT_TARGET_DRIVER_DIGITAL_OUTPUT_SHIFT_REGISTER
+        if ((port == PIN_PORT_SR_OUT_CLK) && (index == PIN_INDEX_SR_OUT_CLK))
+#else
+        if ((port == PIN_PORT_MAX7219_CLK) && (index == PIN_INDEX_MAX7219_CLK))
+#endif
+        {
+            clockEdges++;
+        }
+    }
+
+    template<typename Port, typename Index>
+    void tracePinHigh(Port port, Index index)
+    {}
+}    // namespace
+
+// trace all pin writes performed by the driver
+#undef CORE_MCU_IO_SET_LOW
+#undef CORE_MCU_IO_SET_HIGH
+#define CORE_MCU_IO_SET_LOW(port, index)  tracePinLow(port, index)
+#define CORE_MCU_IO_SET_HIGH(port, index) tracePinHigh(port, index)
+
+#ifdef PROJECT_TARGET_DRIVER_DIGITAL_OUTPUT_SHIFT_REGISTER
+#include "shift_register.cpp"
+#else
+#include "max7219.cpp"
+#endif
+
+namespace board::detail::io
+{
+    void spiWait()
+    {}
+}    // namespace board::detail::io
+
+using namespace board::io::digital_out;
+
+namespace
+{
+    constexpr size_t PWM_SLOTS = static_cast<size_t>(ledBrightness_t::B100);
+
+    class DigitalOutTest : public ::testing::Test
+    {
+        protected:
+        void SetUp() override
+        {
+            board::detail::io::digital_out::init();
+
+            for (size_t i = 0; i < PROJECT_TARGET_MAX_NR_OF_DIGITAL_OUTPUTS; i++)
+            {
+                writeLedState(i, ledBrightness_t::OFF);
+            }
+
+            tick(PWM_SLOTS);
+            clockEdges = 0;
+        }
+
+        void tick(size_t ticks)
+        {
+#ifdef PROJECT_TARGET_DRIVER_DIGITAL_OUTPUT_SHIFT_REGISTER
+            for (size_t i = 0; i < ticks; i++)
+            {
+                board::detail::io::digital_out::update();
+            }
+#endif
+        }
+    };
+}    // namespace
+
+#ifdef PROJECT_TARGET_DRIVER_DIGITAL_OUTPUT_SHIFT_REGISTER
+TEST_F(DigitalOutTest, IdleTickSendsNothing)
+{
+    tick(PWM_SLOTS * 10);
+    ASSERT_EQ(0, clockEdges);
+
+    // single full chain transfer once the state changes, nothing afterwards
+    writeLedState(0, ledBrightness_t::B100);
+    tick(PWM_SLOTS);
+    ASSERT_EQ(PROJECT_TARGET_NR_OF_OUT_SR * 8, clockEdges);
+    clockEdges = 0;
+
+    tick(PWM_SLOTS * 10);
+    ASSERT_EQ(0, clockEdges);
+}
+
+TEST_F(DigitalOutTest, ChangeShiftsWholeChainOnce)
+{
+    writeLedState(0, ledBrightness_t::B100);
+    tick(PWM_SLOTS);
+
+    ASSERT_EQ(PROJECT_TARGET_NR_OF_OUT_SR * 8, clockEdges);
+}
+
+TEST_F(DigitalOutTest, DimmedLedShiftsOnlyOnSlotChange)
+{
+    writeLedState(0, ledBrightness_t::B50);
+
+    // settle
+    tick(PWM_SLOTS);
+    clockEdges = 0;
+
+    // LED is on for two slots and off for the other two:
+    // chain needs to be updated only twice per PWM period
+    tick(PWM_SLOTS);
+    ASSERT_EQ(PROJECT_TARGET_NR_OF_OUT_SR * 8 * 2, clockEdges);
+}
+#else
+TEST_F(DigitalOutTest, UnchangedColumnSendsNothing)
+{
+    writeLedState(0, ledBrightness_t::B100);
+
+    // register and data byte
+    ASSERT_EQ(16, clockEdges);
+    clockEdges = 0;
+
+    writeLedState(0, ledBrightness_t::B100);
+    writeLedState(0, ledBrightness_t::B50);
+    ASSERT_EQ(0, clockEdges);
+
+    writeLedState(0, ledBrightness_t::OFF);
+    ASSERT_EQ(16, clockEdges);
+}
+#endif
+
+#endif
@@ -681,6 +681,20 @@ TEST_F(HWTest, DatabaseInitialValues)
             ASSERT_EQ(0, _helper.databaseReadFromSystemViaSysEx(sys::Config::Section::analog_t::UPPER_OFFSET, i));
         }
 
+        // aftertouch rate section
+        // all values should be set to 0
+        for (size_t i = 0; i < io::analog::Collection::SIZE(); i += PARAM_SKIP)
+        {
+            ASSERT_EQ(0, _helper.databaseReadFromSystemViaSysEx(sys::Config::Section::analog_t::AFTERTOUCH_RATE, i));
+        }
+
+        // aftertouch slew section
+        // all values should be set to 0
+        for (size_t i = 0; i < io::analog::Collection::SIZE(); i += PARAM_SKIP)
+        {
+            ASSERT_EQ(0, _helper.databaseReadFromSystemViaSysEx(sys::Config::Section::analog_t::AFTERTOUCH_SLEW, i));
+        }
+
         // LED block
         //----------------------------------
         // global section
@@ -21,8 +21,12 @@ limitations under the License.
 #include "tests/common.h"
 #include "tests/helpers/listener.h"
 #include "application/io/analog/builder.h"
+#include "application/io/analog/filter_hw.h"
 #include "application/io/buttons/buttons.h"
 #include "application/util/configurable/configurable.h"
+#include "core/mcu.h"
+
+#include <algorithm>
 
 using namespace io;
 using namespace protocol;
@@ -57,6 +61,7 @@ namespace
         {
             ConfigHandler.clear();
             MidiDispatcher.clear();
+            SysExDispatcher.clear();
             _listener._event.clear();
         }
 
@@ -490,4 +495,185 @@ TEST_F(AnalogTest, ButtonForwarding)
     EXPECT_EQ(2, dispatchMessageAnalogFwd.size());
 }
 
+TEST_F(AnalogTest, FSRAftertouch)
+{
+    constexpr uint8_t  RATE          = 50;
+    constexpr uint32_t PERIOD        = 1000 / RATE;
+    constexpr uint32_t PRESSURE_TIME = 1000;
+    constexpr uint16_t FINAL_VALUE   = 64;
+
+    for (size_t i = 0; i < analog::Collection::SIZE(analog::GROUP_ANALOG_INPUTS); i++)
+    {
+        ASSERT_TRUE(_analog._database.update(database::Config::Section::analog_t::TYPE, i, analog::type_t::FSR));
+        ASSERT_TRUE(_analog._database.update(database::Config::Section::analog_t::AFTERTOUCH_RATE, i, RATE));
+    }
+
+    auto aftertouch = [this](size_t index)
+    {
+        std::vector<uint16_t> values;
+
+        for (const auto& event : _listener._event)
+        {
+            if ((event.message == midi::messageType_t::AFTER_TOUCH_POLY) && (event.componentIndex == index))
+            {
+                values.push_back(event.value);
+            }
+        }
+
+        return values;
+    };
+
+    // press all sensors
+    stateChangeRegister(10);
+
+    ASSERT_EQ(analog::Collection::SIZE(analog::GROUP_ANALOG_INPUTS), _listener._event.size());
+    _listener._event.clear();
+
+    // pressure changes on every reading
+    for (uint32_t i = 0; i < PRESSURE_TIME; i++)
+    {
+        core::mcu::timing::setMs(core::mcu::timing::ms() + 1);
+        stateChangeRegister(11 + (i % 100));
+    }
+
+    // settle at the final pressure
+    stateChangeRegister(FINAL_VALUE);
+
+    for (uint32_t i = 0; i < PERIOD; i++)
+    {
+        core::mcu::timing::setMs(core::mcu::timing::ms() + 1);
+        _analog._instance.updateAll();
+    }
+
+    for (size_t i = 0; i < analog::Collection::SIZE(analog::GROUP_ANALOG_INPUTS); i++)
+    {
+        auto values = aftertouch(i);
+
+        ASSERT_FALSE(values.empty());
+        ASSERT_LE(values.size(), (PRESSURE_TIME + PERIOD) / PERIOD);
+        ASSERT_EQ(FINAL_VALUE, values.back());
+    }
+
+    // with slew enabled, pressure is approached gradually but the final value still arrives
+    for (size_t i = 0; i < analog::Collection::SIZE(analog::GROUP_ANALOG_INPUTS); i++)
+    {
+        ASSERT_TRUE(_analog._database.update(database::Config::Section::analog_t::AFTERTOUCH_SLEW, i, 2));
+    }
+
+    _listener._event.clear();
+    stateChangeRegister(127);
+
+    for (uint32_t i = 0; i < PRESSURE_TIME; i++)
+    {
+        core::mcu::timing::setMs(core::mcu::timing::ms() + 1);
+        _analog._instance.updateAll();
+    }
+
+    for (size_t i = 0; i < analog::Collection::SIZE(analog::GROUP_ANALOG_INPUTS); i++)
+    {
+        auto values = aftertouch(i);
+
+        ASSERT_GT(values.size(), 1);
+        ASSERT_TRUE(std::is_sorted(values.begin(), values.end()));
+        ASSERT_EQ(127, values.back());
+    }
+
+    // releasing the sensor sends note off only
+    _listener._event.clear();
+    stateChangeRegister(0);
+
+    for (uint32_t i = 0; i < PERIOD; i++)
+    {
+        core::mcu::timing::setMs(core::mcu::timing::ms() + 1);
+        _analog._instance.updateAll();
+    }
+
+    ASSERT_EQ(analog::Collection::SIZE(analog::GROUP_ANALOG_INPUTS), _listener._event.size());
+
+    for (const auto& event : _listener._event)
+    {
+        ASSERT_EQ(midi::messageType_t::NOTE_OFF, event.message);
+    }
+}
+
+TEST_F(AnalogTest, HighResolutionFilter)
+{
+    analog::FilterHw filter(12);
+
+    // ADC noise of +-1 step
+    const std::vector<int> NOISE = { 0, 1, -1, 1, 0, -1 };
+    size_t                 sample = 0;
+
+    auto read = [&](int raw, uint16_t& value)
+    {
+        analog::Filter::Descriptor descriptor;
+        descriptor.type     = analog::type_t::CONTROL_CHANGE_14BIT;
+        descriptor.maxValue = midi::MAX_VALUE_14BIT;
+        descriptor.value    = std::clamp(raw + NOISE.at(sample++ % NOISE.size()), 0, 4095);
+
+        if (!filter.isFiltered(0, descriptor))
+        {
+            return false;
+        }
+
+        value = descriptor.value;
+        return true;
+    };
+
+    uint16_t value    = 0;
+    size_t   messages = 0;
+
+    // first reading is always reported
+    ASSERT_TRUE(read(2000, value));
+
+    // noise of stationary input isn't reported as movement
+    for (size_t i = 0; i < 1000; i++)
+    {
+        if (read(2000, value))
+        {
+            messages++;
+        }
+    }
+
+    ASSERT_EQ(0, messages);
+
+    // slow sweep through the entire range: values change in small steps and both edges are reached
+    uint16_t minValue = 0xFFFF;
+    uint16_t maxValue = 0;
+    uint16_t maxStep  = 0;
+
+    for (int raw = 2000; raw >= 0; raw--)
+    {
+        if (read(raw, value))
+        {
+            minValue = std::min(minValue, value);
+        }
+    }
+
+    uint16_t lastValue = minValue;
+
+    for (int raw = 0; raw <= 4095; raw++)
+    {
+        if (read(raw, value))
+        {
+            maxValue  = std::max(maxValue, value);
+            maxStep   = std::max(maxStep, static_cast<uint16_t>(abs(value - lastValue)));
+            lastValue = value;
+            messages++;
+        }
+    }
+
+    ASSERT_EQ(0, minValue);
+    ASSERT_EQ(midi::MAX_VALUE_14BIT, maxValue);
+
+    // single ADC step corresponds to ~4 14-bit steps, larger step is allowed only when snapping to the edge
+    ASSERT_LE(maxStep, 32);
+
+    // far less messages than 14-bit steps, far more than 7-bit steps
+    ASSERT_GT(messages, 1000);
+    ASSERT_LT(messages, static_cast<size_t>(midi::MAX_VALUE_14BIT));
+
+    LOG(INFO) << "Full range sweep: " << messages << " messages, largest step " << maxStep;
+}
+
 #endif
\ No newline at end of file
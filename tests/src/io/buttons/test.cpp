@@ -19,6 +19,7 @@ limitations under the License.
 #include "tests/common.h"
 #include "tests/helpers/listener.h"
 #include "application/io/buttons/builder.h"
+#include "application/io/buttons/velocity.h"
 #include "application/util/configurable/configurable.h"
 
 #ifdef PROJECT_TARGET_SUPPORT_BUTTONS
@@ -58,6 +59,7 @@ namespace
         {
             ConfigHandler.clear();
             MidiDispatcher.clear();
+            SysExDispatcher.clear();
             _listener._event.clear();
         }
 
@@ -174,6 +176,123 @@ TEST_F(ButtonsTest, Note)
     }
 }
 
+TEST_F(ButtonsTest, DualContactNote)
+{
+    if (!buttons::Collection::SIZE(buttons::GROUP_DIGITAL_INPUTS))
+    {
+        return;
+    }
+
+    constexpr size_t   INDEX           = 0;
+    constexpr uint32_t MEDIUM_INTERVAL = 10000;
+
+    auto strike = [&](buttons::velocityCurve_t curve, uint32_t interval)
+    {
+        ASSERT_TRUE(_buttons._database.update(database::Config::Section::button_t::TYPE, INDEX, buttons::type_t::MOMENTARY));
+        ASSERT_TRUE(_buttons._database.update(database::Config::Section::button_t::MESSAGE_TYPE, INDEX, buttons::messageType_t::NOTE_DUAL_CONTACT));
+        ASSERT_TRUE(_buttons._database.update(database::Config::Section::button_t::VALUE, INDEX, curve));
+        _buttons._instance.reset(INDEX);
+
+        // note on is sent once both contacts are closed
+        _buttons._hwa._contactInterval[INDEX] = interval;
+        stateChangeRegisterSingle(INDEX, true);
+        ASSERT_EQ(1, _listener._event.size());
+        ASSERT_EQ(midi::messageType_t::NOTE_ON, _listener._event.at(0).message);
+        ASSERT_EQ(buttons::Velocity::value(interval, curve), _listener._event.at(0).value);
+        ASSERT_EQ(INDEX, _listener._event.at(0).index);
+    };
+
+    auto release = [&]()
+    {
+        stateChangeRegisterSingle(INDEX, false);
+        ASSERT_EQ(1, _listener._event.size());
+        ASSERT_EQ(midi::messageType_t::NOTE_OFF, _listener._event.at(0).message);
+        ASSERT_EQ(0, _listener._event.at(0).value);
+    };
+
+    // fastest and slowest strikes
+    strike(buttons::velocityCurve_t::LINEAR, buttons::Velocity::FASTEST_INTERVAL_US);
+    ASSERT_EQ(127, _listener._event.at(0).value);
+    release();
+
+    strike(buttons::velocityCurve_t::LINEAR, buttons::Velocity::SLOWEST_INTERVAL_US);
+    ASSERT_EQ(1, _listener._event.at(0).value);
+    release();
+
+    // key pressed without reaching the second contact: nothing should be sent
+    stateChangeRegisterSingle(INDEX, true);
+    ASSERT_EQ(0, _listener._event.size());
+    stateChangeRegisterSingle(INDEX, false);
+    ASSERT_EQ(0, _listener._event.size());
+
+    // key struck again before it was released: previous note should be turned off first
+    strike(buttons::velocityCurve_t::LINEAR, MEDIUM_INTERVAL);
+    _buttons._hwa._contactInterval[INDEX] = MEDIUM_INTERVAL;
+    stateChangeRegisterSingle(INDEX, true);
+    ASSERT_EQ(2, _listener._event.size());
+    ASSERT_EQ(midi::messageType_t::NOTE_OFF, _listener._event.at(0).message);
+    ASSERT_EQ(midi::messageType_t::NOTE_ON, _listener._event.at(1).message);
+    release();
+
+    // same strike on all curves
+    strike(buttons::velocityCurve_t::HARD, MEDIUM_INTERVAL);
+    auto hard = _listener._event.at(0).value;
+    release();
+
+    strike(buttons::velocityCurve_t::LINEAR, MEDIUM_INTERVAL);
+    auto linear = _listener._event.at(0).value;
+    release();
+
+    strike(buttons::velocityCurve_t::SOFT, MEDIUM_INTERVAL);
+    auto soft = _listener._event.at(0).value;
+    release();
+
+    ASSERT_LT(hard, linear);
+    ASSERT_LT(linear, soft);
+
+    // invalid curve falls back to linear
+    strike(buttons::velocityCurve_t::AMOUNT, MEDIUM_INTERVAL);
+    ASSERT_EQ(linear, _listener._event.at(0).value);
+    release();
+}
+
+TEST_F(ButtonsTest, DualContactShortStrike)
+{
+    if (buttons::Collection::SIZE(buttons::GROUP_DIGITAL_INPUTS) < 2)
+    {
+        return;
+    }
+
+    constexpr size_t   INDEX    = 0;
+    constexpr uint32_t INTERVAL = 10000;
+
+    ASSERT_TRUE(_buttons._database.update(database::Config::Section::button_t::TYPE, INDEX, buttons::type_t::MOMENTARY));
+    ASSERT_TRUE(_buttons._database.update(database::Config::Section::button_t::MESSAGE_TYPE, INDEX, buttons::messageType_t::NOTE_DUAL_CONTACT));
+    ASSERT_TRUE(_buttons._database.update(database::Config::Section::button_t::VALUE, INDEX, buttons::velocityCurve_t::LINEAR));
+    _buttons._instance.reset(INDEX);
+
+    // strike shorter than the debounce time: both contacts were timed, but debounced state never went to pressed
+    _buttons._hwa._contactInterval[INDEX] = INTERVAL;
+    stateChangeRegisterSingle(INDEX, false);
+    ASSERT_EQ(1, _listener._event.size());
+    ASSERT_EQ(midi::messageType_t::NOTE_ON, _listener._event.at(0).message);
+
+    // next released reading should turn the note off even though the state didn't change
+    stateChangeRegisterSingle(INDEX, false);
+    ASSERT_EQ(1, _listener._event.size());
+    ASSERT_EQ(midi::messageType_t::NOTE_OFF, _listener._event.at(0).message);
+
+    // note off is sent only once
+    stateChangeRegisterSingle(INDEX, false);
+    ASSERT_EQ(0, _listener._event.size());
+
+    // second contact of the key doesn't send anything on its own
+    stateChangeRegisterSingle(INDEX + 1, true);
+    ASSERT_EQ(0, _listener._event.size());
+    stateChangeRegisterSingle(INDEX + 1, false);
+    ASSERT_EQ(0, _listener._event.size());
+}
+
 TEST_F(ButtonsTest, ProgramChange)
 {
     if (!buttons::Collection::SIZE(buttons::GROUP_DIGITAL_INPUTS))
@@ -46,6 +46,9 @@ namespace
                 ASSERT_TRUE(_encoders._database.update(database::Config::Section::encoder_t::PULSES_PER_STEP, i, 1));
             }
 
+            // settings are cached
+            ASSERT_TRUE(_encoders._instance.init());
+
             MidiDispatcher.listen(messaging::eventType_t::ENCODER,
                                   [this](const messaging::Event& dispatchMessage)
                                   {
@@ -57,6 +60,7 @@ namespace
         {
             ConfigHandler.clear();
             MidiDispatcher.clear();
+            SysExDispatcher.clear();
             _listener._event.clear();
         }
 
@@ -384,4 +388,166 @@ TEST_F(EncodersTest, Messages)
     verifyValue(midi::messageType_t::NOTE_ON, 0);
 }
 
-#endif
\ No newline at end of file
+TEST_F(EncodersTest, PresetChange)
+{
+    if (!encoders::Collection::SIZE() || (_databaseAdmin.getSupportedPresets() < 2))
+    {
+        return;
+    }
+
+    size_t   stateIndex = 0;
+    uint32_t time       = 1000;
+
+    // moves all encoders clockwise by one step
+    // returns: value sent for the first encoder
+    auto step = [&]()
+    {
+        time += 200;
+        core::mcu::timing::setMs(time);
+        stateIndex = (stateIndex + 1) % ENCODER_STATE.size();
+        stateChangeRegister(ENCODER_STATE.at(stateIndex));
+
+        EXPECT_EQ(encoders::Collection::SIZE(), _listener._event.size());
+        return _listener._event.empty() ? 0 : _listener._event.at(0).value;
+    };
+
+    auto setMode = [&](encoders::type_t mode)
+    {
+        for (size_t i = 0; i < encoders::Collection::SIZE(); i++)
+        {
+            ASSERT_TRUE(_encoders._database.update(database::Config::Section::encoder_t::MODE, i, mode));
+        }
+    };
+
+    auto notify = [](messaging::systemMessage_t message)
+    {
+        messaging::Event event = {};
+        event.systemMessage    = message;
+
+        MidiDispatcher.notify(messaging::eventType_t::SYSTEM, event);
+    };
+
+    core::mcu::timing::setMs(time);
+    stateChangeRegister(ENCODER_STATE.at(stateIndex));
+
+    ASSERT_TRUE(_databaseAdmin.setPreset(1));
+    setMode(encoders::type_t::CONTROL_CHANGE_3FH41H);
+    ASSERT_TRUE(_databaseAdmin.setPreset(0));
+    ASSERT_EQ(1, step());
+
+    // settings are reloaded right after the preset change, without waiting for PRESET_CHANGED
+    ASSERT_TRUE(_databaseAdmin.setPreset(1));
+    ASSERT_EQ(65, step());
+
+    ASSERT_TRUE(_databaseAdmin.setPreset(0));
+    ASSERT_EQ(1, step());
+
+    // settings written directly into the database, as during restore or factory reset
+    setMode(encoders::type_t::CONTROL_CHANGE_3FH41H);
+    ASSERT_EQ(1, step());
+
+    notify(messaging::systemMessage_t::RESTORE_END);
+    ASSERT_EQ(65, step());
+
+    setMode(encoders::type_t::CONTROL_CHANGE_7FH01H);
+    notify(messaging::systemMessage_t::FACTORY_RESET_END);
+    ASSERT_EQ(1, step());
+}
+
+TEST_F(EncodersTest, Acceleration)
+{
+    if (!encoders::Collection::SIZE())
+    {
+        return;
+    }
+
+    for (size_t i = 0; i < encoders::Collection::SIZE(); i++)
+    {
+        ASSERT_TRUE(_encoders._database.update(database::Config::Section::encoder_t::MODE, i, encoders::type_t::NRPN_14BIT));
+        ASSERT_TRUE(_encoders._database.update(database::Config::Section::encoder_t::ACCELERATION, i, encoders::acceleration_t::FAST));
+        ASSERT_TRUE(_encoders._database.update(database::Config::Section::encoder_t::LOWER_LIMIT, i, 0));
+        ASSERT_TRUE(_encoders._database.update(database::Config::Section::encoder_t::UPPER_LIMIT, i, 16383));
+        _encoders._instance.reset(i);
+    }
+
+    size_t stateIndex = 0;
+
+    // moves all encoders clockwise by one step at specified time
+    // returns: amount by which the value of first encoder has changed
+    auto step = [&](uint32_t time)
+    {
+        core::mcu::timing::setMs(time);
+        stateIndex = (stateIndex + 1) % ENCODER_STATE.size();
+        stateChangeRegister(ENCODER_STATE.at(stateIndex));
+
+        EXPECT_EQ(encoders::Collection::SIZE(), _listener._event.size());
+        return _listener._event.empty() ? 0 : _listener._event.at(0).value;
+    };
+
+    uint32_t time  = 1000;
+    uint16_t value = 0;
+
+    // initial reading
+    core::mcu::timing::setMs(time);
+    stateChangeRegister(ENCODER_STATE.at(stateIndex));
+
+    // slow movement: value changes by single step only
+    for (int i = 0; i < 5; i++)
+    {
+        time += 200;
+        auto newValue = step(time);
+        ASSERT_EQ(value + 1, newValue);
+        value = newValue;
+    }
+
+    // speeding up: amount of steps grows with the velocity
+    uint16_t lastChange = 1;
+
+    for (uint32_t interval = 60; interval >= 5; interval -= 5)
+    {
+        time += interval;
+        auto newValue = step(time);
+        ASSERT_GE(newValue - value, lastChange);
+        lastChange = newValue - value;
+        value      = newValue;
+    }
+
+    ASSERT_GT(lastChange, 1);
+
+    // constant fast spin reaches the largest amount of steps
+    for (int i = 0; i < 10; i++)
+    {
+        time += 5;
+        auto newValue = step(time);
+        lastChange    = newValue - value;
+        value         = newValue;
+    }
+
+    // 14-bit values are changed by four times larger amount
+    ASSERT_EQ(400, lastChange);
+
+    // once stopped, acceleration starts over
+    time += 500;
+    auto newValue = step(time);
+    ASSERT_EQ(value + 1, newValue);
+
+    // same movement without acceleration
+    for (size_t i = 0; i < encoders::Collection::SIZE(); i++)
+    {
+        ASSERT_TRUE(_encoders._database.update(database::Config::Section::encoder_t::ACCELERATION, i, encoders::acceleration_t::DISABLED));
+        _encoders._instance.reset(i);
+    }
+
+    stateChangeRegister(ENCODER_STATE.at(stateIndex));
+    value = 0;
+
+    for (int i = 0; i < 10; i++)
+    {
+        time += 5;
+        auto newValue = step(time);
+        ASSERT_EQ(value + 1, newValue);
+        value = newValue;
+    }
+}
+
+#endif
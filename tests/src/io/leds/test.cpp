@@ -21,6 +21,10 @@ limitations under the License.
 #include "application/io/leds/builder.h"
 #include "application/util/configurable/configurable.h"
 #include "application/global/midi_program.h"
+#include "core/mcu.h"
+
+#include <algorithm>
+#include <chrono>
 
 #ifdef PROJECT_TARGET_SUPPORT_LEDS
 
@@ -50,6 +54,7 @@ namespace
         {
             ConfigHandler.clear();
             MidiDispatcher.clear();
+            SysExDispatcher.clear();
         }
 
         static constexpr size_t MIDI_CHANNEL = 1;
@@ -353,11 +358,9 @@ TEST_F(LEDsTest, MultiValue)
             MidiDispatcher.notify(messaging::eventType_t::MIDI_IN,
                                   {
                                       {},                              // componentIndex
-                                      MIDI_CHANNEL,                    // channel
                                       static_cast<uint16_t>(led),      // index
                                       value,                           // value
-                                      {},                              // sysEx
-                                      {},                              // sysExLength
+                                      MIDI_CHANNEL,                    // channel
                                       {},                              // forcedRefresh
                                       midi::messageType_t::NOTE_ON,    // message
                                       {},                              // systemMessage
@@ -390,11 +393,9 @@ TEST_F(LEDsTest, MultiValue)
             MidiDispatcher.notify(messaging::eventType_t::MIDI_IN,
                                   {
                                       {},                                     // componentIndex
-                                      MIDI_CHANNEL,                           // channel
                                       static_cast<uint16_t>(led),             // index
                                       value,                                  // value
-                                      {},                                     // sysEx
-                                      {},                                     // sysExLength
+                                      MIDI_CHANNEL,                           // channel
                                       {},                                     // forcedRefresh
                                       midi::messageType_t::CONTROL_CHANGE,    // message
                                       {},                                     // systemMessage
@@ -427,11 +428,9 @@ TEST_F(LEDsTest, MultiValue)
             MidiDispatcher.notify(messaging::eventType_t::BUTTON,
                                   {
                                       {},                              // componentIndex
-                                      MIDI_CHANNEL,                    // channel
                                       static_cast<uint16_t>(led),      // index
                                       value,                           // value
-                                      {},                              // sysEx
-                                      {},                              // sysExLength
+                                      MIDI_CHANNEL,                    // channel
                                       {},                              // forcedRefresh
                                       midi::messageType_t::NOTE_ON,    // message
                                       {},                              // systemMessage
@@ -457,11 +456,9 @@ TEST_F(LEDsTest, MultiValue)
             MidiDispatcher.notify(messaging::eventType_t::ANALOG,
                                   {
                                       {},                              // componentIndex
-                                      MIDI_CHANNEL,                    // channel
                                       static_cast<uint16_t>(led),      // index
                                       value,                           // value
-                                      {},                              // sysEx
-                                      {},                              // sysExLength
+                                      MIDI_CHANNEL,                    // channel
                                       {},                              // forcedRefresh
                                       midi::messageType_t::NOTE_ON,    // message
                                       {},                              // systemMessage
@@ -494,11 +491,9 @@ TEST_F(LEDsTest, MultiValue)
             MidiDispatcher.notify(messaging::eventType_t::BUTTON,
                                   {
                                       {},                                     // componentIndex
-                                      MIDI_CHANNEL,                           // channel
                                       static_cast<uint16_t>(led),             // index
                                       value,                                  // value
-                                      {},                                     // sysEx
-                                      {},                                     // sysExLength
+                                      MIDI_CHANNEL,                           // channel
                                       {},                                     // forcedRefresh
                                       midi::messageType_t::CONTROL_CHANGE,    // message
                                       {},                                     // systemMessage
@@ -523,11 +518,9 @@ TEST_F(LEDsTest, MultiValue)
             MidiDispatcher.notify(messaging::eventType_t::ANALOG,
                                   {
                                       {},                                     // componentIndex
-                                      MIDI_CHANNEL,                           // channel
                                       static_cast<uint16_t>(led),             // index
                                       value,                                  // value
-                                      {},                                     // sysEx
-                                      {},                                     // sysExLength
+                                      MIDI_CHANNEL,                           // channel
                                       {},                                     // forcedRefresh
                                       midi::messageType_t::CONTROL_CHANGE,    // message
                                       {},                                     // systemMessage
@@ -571,11 +564,9 @@ TEST_F(LEDsTest, SingleValue)
                 MidiDispatcher.notify(messaging::eventType_t::MIDI_IN,
                                       {
                                           {},                              // componentIndex
-                                          MIDI_CHANNEL,                    // channel
                                           static_cast<uint16_t>(led),      // index
                                           value,                           // value
-                                          {},                              // sysEx
-                                          {},                              // sysExLength
+                                          MIDI_CHANNEL,                    // channel
                                           {},                              // forcedRefresh
                                           midi::messageType_t::NOTE_ON,    // message
                                           {},                              // systemMessage
@@ -612,11 +603,9 @@ TEST_F(LEDsTest, SingleValue)
                 MidiDispatcher.notify(messaging::eventType_t::MIDI_IN,
                                       {
                                           {},                                     // componentIndex
-                                          MIDI_CHANNEL,                           // channel
                                           static_cast<uint16_t>(led),             // index
                                           value,                                  // value
-                                          {},                                     // sysEx
-                                          {},                                     // sysExLength
+                                          MIDI_CHANNEL,                           // channel
                                           {},                                     // forcedRefresh
                                           midi::messageType_t::CONTROL_CHANGE,    // message
                                           {},                                     // systemMessage
@@ -653,11 +642,9 @@ TEST_F(LEDsTest, SingleValue)
                 MidiDispatcher.notify(messaging::eventType_t::BUTTON,
                                       {
                                           {},                              // componentIndex
-                                          MIDI_CHANNEL,                    // channel
                                           static_cast<uint16_t>(led),      // index
                                           value,                           // value
-                                          {},                              // sysEx
-                                          {},                              // sysExLength
+                                          MIDI_CHANNEL,                    // channel
                                           {},                              // forcedRefresh
                                           midi::messageType_t::NOTE_ON,    // message
                                           {},                              // systemMessage
@@ -694,11 +681,9 @@ TEST_F(LEDsTest, SingleValue)
                 MidiDispatcher.notify(messaging::eventType_t::BUTTON,
                                       {
                                           {},                                     // componentIndex
-                                          MIDI_CHANNEL,                           // channel
                                           static_cast<uint16_t>(led),             // index
                                           value,                                  // value
-                                          {},                                     // sysEx
-                                          {},                                     // sysExLength
+                                          MIDI_CHANNEL,                           // channel
                                           {},                                     // forcedRefresh
                                           midi::messageType_t::CONTROL_CHANGE,    // message
                                           {},                                     // systemMessage
@@ -727,11 +712,9 @@ TEST_F(LEDsTest, SingleLEDstate)
     MidiDispatcher.notify(messaging::eventType_t::MIDI_IN,
                           {
                               {},                              // componentIndex
-                              MIDI_CHANNEL,                    // channel
                               MIDI_ID,                         // index
                               127,                             // value
-                              {},                              // sysEx
-                              {},                              // sysExLength
+                              MIDI_CHANNEL,                    // channel
                               {},                              // forcedRefresh
                               midi::messageType_t::NOTE_ON,    // message
                               {},                              // systemMessage
@@ -744,11 +727,9 @@ TEST_F(LEDsTest, SingleLEDstate)
     MidiDispatcher.notify(messaging::eventType_t::MIDI_IN,
                           {
                               {},                              // componentIndex
-                              MIDI_CHANNEL,                    // channel
                               MIDI_ID,                         // index
                               0,                               // value
-                              {},                              // sysEx
-                              {},                              // sysExLength
+                              MIDI_CHANNEL,                    // channel
                               {},                              // forcedRefresh
                               midi::messageType_t::NOTE_ON,    // message
                               {},                              // systemMessage
@@ -776,11 +757,9 @@ TEST_F(LEDsTest, SingleLEDstate)
     MidiDispatcher.notify(messaging::eventType_t::MIDI_IN,
                           {
                               {},                              // componentIndex
-                              MIDI_CHANNEL,                    // channel
                               MIDI_ID,                         // index
                               127,                             // value
-                              {},                              // sysEx
-                              {},                              // sysExLength
+                              MIDI_CHANNEL,                    // channel
                               {},                              // forcedRefresh
                               midi::messageType_t::NOTE_ON,    // message
                               {},                              // systemMessage
@@ -815,11 +794,9 @@ TEST_F(LEDsTest, ProgramChangeWithOffset)
     MidiDispatcher.notify(messaging::eventType_t::PROGRAM,
                           {
                               {},                                     // componentIndex
-                              MIDI_CHANNEL,                           // channel
                               program,                                // index
                               {},                                     // value
-                              {},                                     // sysEx
-                              {},                                     // sysExLength
+                              MIDI_CHANNEL,                           // channel
                               {},                                     // forcedRefresh
                               midi::messageType_t::PROGRAM_CHANGE,    // message
                               {},                                     // systemMessage
@@ -844,11 +821,9 @@ TEST_F(LEDsTest, ProgramChangeWithOffset)
     MidiDispatcher.notify(messaging::eventType_t::PROGRAM,
                           {
                               {},                                     // componentIndex
-                              MIDI_CHANNEL,                           // channel
                               program,                                // index
                               {},                                     // value
-                              {},                                     // sysEx
-                              {},                                     // sysExLength
+                              MIDI_CHANNEL,                           // channel
                               {},                                     // forcedRefresh
                               midi::messageType_t::PROGRAM_CHANGE,    // message
                               {},                                     // systemMessage
@@ -874,11 +849,9 @@ TEST_F(LEDsTest, ProgramChangeWithOffset)
     MidiDispatcher.notify(messaging::eventType_t::PROGRAM,
                           {
                               {},                                     // componentIndex
-                              MIDI_CHANNEL,                           // channel
                               program,                                // index
                               {},                                     // value
-                              {},                                     // sysEx
-                              {},                                     // sysExLength
+                              MIDI_CHANNEL,                           // channel
                               {},                                     // forcedRefresh
                               midi::messageType_t::PROGRAM_CHANGE,    // message
                               {},                                     // systemMessage
@@ -899,11 +872,9 @@ TEST_F(LEDsTest, ProgramChangeWithOffset)
     MidiDispatcher.notify(messaging::eventType_t::PROGRAM,
                           {
                               {},                                     // componentIndex
-                              MIDI_CHANNEL,                           // channel
                               program,                                // index
                               {},                                     // value
-                              {},                                     // sysEx
-                              {},                                     // sysExLength
+                              MIDI_CHANNEL,                           // channel
                               {},                                     // forcedRefresh
                               midi::messageType_t::PROGRAM_CHANGE,    // message
                               {},                                     // systemMessage
@@ -951,11 +922,9 @@ TEST_F(LEDsTest, GlobalChannel)
     MidiDispatcher.notify(messaging::eventType_t::MIDI_IN,
                           {
                               {},                              // componentIndex
-                              DEFAULT_CHANNEL,                 // channel
                               LED_INDEX,                       // index
                               ON_VALUE,                        // value
-                              {},                              // sysEx
-                              {},                              // sysExLength
+                              DEFAULT_CHANNEL,                 // channel
                               {},                              // forcedRefresh
                               midi::messageType_t::NOTE_ON,    // message
                               {},                              // systemMessage
@@ -968,11 +937,9 @@ TEST_F(LEDsTest, GlobalChannel)
     MidiDispatcher.notify(messaging::eventType_t::MIDI_IN,
                           {
                               {},                              // componentIndex
-                              GLOBAL_CHANNEL,                  // channel
                               LED_INDEX,                       // index
                               ON_VALUE,                        // value
-                              {},                              // sysEx
-                              {},                              // sysExLength
+                              GLOBAL_CHANNEL,                  // channel
                               {},                              // forcedRefresh
                               midi::messageType_t::NOTE_ON,    // message
                               {},                              // systemMessage
@@ -991,11 +958,9 @@ TEST_F(LEDsTest, GlobalChannel)
         MidiDispatcher.notify(messaging::eventType_t::MIDI_IN,
                               {
                                   {},                              // componentIndex
-                                  i,                               // channel
                                   LED_INDEX,                       // index
                                   ON_VALUE,                        // value
-                                  {},                              // sysEx
-                                  {},                              // sysExLength
+                                  i,                               // channel
                                   {},                              // forcedRefresh
                                   midi::messageType_t::NOTE_ON,    // message
                                   {},                              // systemMessage
@@ -1016,16 +981,162 @@ TEST_F(LEDsTest, GlobalChannel)
         MidiDispatcher.notify(messaging::eventType_t::MIDI_IN,
                               {
                                   {},                              // componentIndex
-                                  i,                               // channel
                                   LED_INDEX,                       // index
                                   ON_VALUE,                        // value
-                                  {},                              // sysEx
-                                  {},                              // sysExLength
+                                  i,                               // channel
+                                  {},                              // forcedRefresh
+                                  midi::messageType_t::NOTE_ON,    // message
+                                  {},                              // systemMessage
+                              });
+    }
+}
+
+TEST_F(LEDsTest, Effects)
+{
+    if (!leds::Collection::SIZE(leds::GROUP_DIGITAL_OUTPUTS))
+    {
+        return;
+    }
+
+    constexpr size_t  LED_INDEX = 0;
+    constexpr uint8_t RED       = 16;
+
+    // lower 4 bits select the effect and its speed
+    constexpr uint8_t FADE_OUT_FAST = RED + 6;
+    constexpr uint8_t PULSE_FAST    = RED + 9;
+
+    ASSERT_TRUE(_leds._database.update(database::Config::Section::leds_t::CONTROL_TYPE, LED_INDEX, leds::controlType_t::MIDI_IN_NOTE_EFFECT));
+
+    std::vector<leds::brightness_t> states;
+    std::vector<uint8_t>            duties;
+
+    EXPECT_CALL(_leds._hwa, setState(LED_INDEX, _))
+        .WillRepeatedly([&states](size_t, leds::brightness_t brightness)
+                        {
+                            states.push_back(brightness);
+                        });
+
+    EXPECT_CALL(_leds._hwa, setDuty(LED_INDEX, _))
+        .WillRepeatedly([&duties](size_t, uint8_t duty)
+                        {
+                            duties.push_back(duty);
+                        });
+
+    auto note = [](uint8_t value)
+    {
+        MidiDispatcher.notify(messaging::eventType_t::MIDI_IN,
+                              {
+                                  {},                              // componentIndex
+                                  LED_INDEX,                       // index
+                                  value,                           // value
+                                  MIDI_CHANNEL,                    // channel
                                   {},                              // forcedRefresh
                                   midi::messageType_t::NOTE_ON,    // message
                                   {},                              // systemMessage
                               });
+    };
+
+    auto run = [this](uint32_t time)
+    {
+        for (uint32_t i = 0; i < time; i++)
+        {
+            core::mcu::timing::setMs(core::mcu::timing::ms() + 1);
+            _leds._instance.updateAll();
+        }
+    };
+
+    // fade out: duty only decreases and the LED is turned off once done
+    note(FADE_OUT_FAST);
+
+    ASSERT_FALSE(duties.empty());
+    ASSERT_EQ(0xFF, duties.back());
+    ASSERT_EQ(leds::color_t::RED, _leds._instance.color(LED_INDEX));
+
+    states.clear();
+    duties.clear();
+    run(600);
+
+    // effects are written with full duty resolution, not only with brightness levels
+    ASSERT_GT(duties.size(), 16);
+    ASSERT_TRUE(std::is_sorted(duties.rbegin(), duties.rend()));
+    ASSERT_EQ(duties.end(), std::adjacent_find(duties.begin(), duties.end()));
+    ASSERT_FALSE(states.empty());
+    ASSERT_EQ(leds::brightness_t::OFF, states.back());
+    ASSERT_EQ(leds::color_t::OFF, _leds._instance.color(LED_INDEX));
+
+    // pulse: goes through the whole range, back to the bottom after single cycle, and keeps running
+    note(PULSE_FAST);
+    duties.clear();
+    run(500);
+
+    ASSERT_NE(duties.end(), std::find(duties.begin(), duties.end(), 0xFF));
+    ASSERT_LT(duties.back(), 0x20);
+    ASSERT_EQ(leds::color_t::RED, _leds._instance.color(LED_INDEX));
+
+    // turning the LED off stops the effect
+    note(0);
+    states.clear();
+    duties.clear();
+    run(500);
+
+    ASSERT_TRUE(duties.empty());
+
+    // meter decay starts from the received level and goes down to off
+    constexpr uint8_t METER_LEVEL      = 3;
+    constexpr uint8_t METER_DECAY_FAST = (METER_LEVEL * 16) + 15;
+
+    note(METER_DECAY_FAST);
+
+    ASSERT_FALSE(duties.empty());
+    ASSERT_EQ(METER_LEVEL * 0xFF / 7, duties.back());
+
+    states.clear();
+    duties.clear();
+    run(1000);
+
+    ASSERT_FALSE(duties.empty());
+    ASSERT_LT(duties.front(), METER_LEVEL * 0xFF / 7);
+    ASSERT_TRUE(std::is_sorted(duties.rbegin(), duties.rend()));
+    ASSERT_FALSE(states.empty());
+    ASSERT_EQ(leds::brightness_t::OFF, states.back());
+}
+
+TEST_F(LEDsTest, EffectsFrameCost)
+{
+    constexpr size_t FRAMES = 10000;
+
+    leds::Effects<leds::Collection::SIZE()> effects;
+
+    // worst case: all LEDs animating, with the brightness changing on most frames
+    for (size_t i = 0; i < leds::Collection::SIZE(); i++)
+    {
+        effects.start(i, leds::effect_t::CHASE, leds::effectSpeed_t::FAST);
+    }
+
+    ASSERT_EQ(leds::Collection::SIZE(), effects.active());
+
+    size_t updates = 0;
+    auto   start   = std::chrono::steady_clock::now();
+
+    for (size_t frame = 0; frame < FRAMES; frame++)
+    {
+        effects.frame([&updates](size_t, uint8_t, bool)
+                      {
+                          updates++;
+                      });
     }
+
+    auto elapsedNs = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+
+    LOG(INFO) << "LED effects: " << leds::Collection::SIZE() << " LEDs, "
+              << (elapsedNs / static_cast<double>(FRAMES)) << " ns per frame, "
+              << (updates / static_cast<double>(FRAMES)) << " LED updates per frame";
+
+    // periodic effects never end on their own
+    ASSERT_EQ(leds::Collection::SIZE(), effects.active());
+
+    effects.clear();
+    ASSERT_EQ(0, effects.active());
 }
 
 #endif
\ No newline at end of file
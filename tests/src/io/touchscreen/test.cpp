@@ -0,0 +1,227 @@
+/*
+
+Copyright Igor Petrovic
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#include "tests/common.h"
+
+#ifdef PROJECT_TARGET_SUPPORT_TOUCHSCREEN
+
+#include "application/io/touchscreen/hwa_test.h"
+#include "application/io/touchscreen/models/viewtech/viewtech.h"
+
+#include "core/mcu.h"
+
+using namespace io;
+
+namespace
+{
+    class TouchscreenViewtechTest : public ::testing::Test
+    {
+        protected:
+        void SetUp() override
+        {
+            ASSERT_TRUE(_viewtech.init());
+
+            // skip post-init delay
+            core::mcu::timing::setMs(core::mcu::timing::ms() + POST_INIT_DELAY);
+            _viewtech.flush();
+            _hwa._writeBuffer.clear();
+        }
+
+        bool setIcon(uint16_t address, bool state)
+        {
+            touchscreen::Icon icon = {};
+            icon.xPos              = address;
+
+            return _viewtech.setIconState(icon, state);
+        }
+
+        static std::vector<uint8_t> frame(uint16_t address, std::vector<uint16_t> values)
+        {
+            std::vector<uint8_t> bytes = {
+                0xA5,
+                0x5A,
+                static_cast<uint8_t>(3 + (values.size() * 2)),
+                0x82,
+                static_cast<uint8_t>(address >> 8),
+                static_cast<uint8_t>(address & 0xFF),
+            };
+
+            for (auto value : values)
+            {
+                bytes.push_back(value >> 8);
+                bytes.push_back(value & 0xFF);
+            }
+
+            return bytes;
+        }
+
+        static constexpr uint32_t POST_INIT_DELAY  = 3000;
+        static constexpr size_t   BYTES_PER_ICON   = 8;    // size of single-register frame
+        static constexpr size_t   FRAME_OVERHEAD   = 6;
+        static constexpr size_t   BYTES_PER_VALUE  = 2;
+        static constexpr uint16_t BASE_VP_ADDRESS  = 0x1000;
+        static constexpr size_t   MAX_REGISTERS    = PROJECT_TARGET_TOUCHSCREEN_MAX_FRAME_REGISTERS;
+        static constexpr size_t   TOTAL_ICONS      = touchscreen::Collection::SIZE();
+        static constexpr uint16_t ICON_STATE_ON    = 0x00;
+        static constexpr uint16_t ICON_STATE_OFF   = 0x01;
+        static constexpr uint16_t UNRELATED_OFFSET = 0x100;
+
+        touchscreen::HwaTest  _hwa;
+        touchscreen::Viewtech _viewtech = touchscreen::Viewtech(_hwa);
+    };
+}    // namespace
+
+TEST_F(TouchscreenViewtechTest, NothingSentBeforeFlush)
+{
+    setIcon(BASE_VP_ADDRESS, true);
+    ASSERT_TRUE(_hwa._writeBuffer.empty());
+
+    _viewtech.flush();
+    ASSERT_EQ(frame(BASE_VP_ADDRESS, { ICON_STATE_ON }), _hwa._writeBuffer);
+
+    // nothing pending anymore
+    _hwa._writeBuffer.clear();
+    _viewtech.flush();
+    ASSERT_TRUE(_hwa._writeBuffer.empty());
+}
+
+TEST_F(TouchscreenViewtechTest, LastStateWins)
+{
+    setIcon(BASE_VP_ADDRESS, true);
+    setIcon(BASE_VP_ADDRESS, false);
+    setIcon(BASE_VP_ADDRESS, true);
+    setIcon(BASE_VP_ADDRESS, false);
+
+    _viewtech.flush();
+    ASSERT_EQ(frame(BASE_VP_ADDRESS, { ICON_STATE_OFF }), _hwa._writeBuffer);
+}
+
+TEST_F(TouchscreenViewtechTest, ContiguousAddressesGrouped)
+{
+    if (TOTAL_ICONS < 4)
+    {
+        GTEST_SKIP();
+    }
+
+    // out of order on purpose, with one address outside of contiguous block
+    setIcon(BASE_VP_ADDRESS + 1, false);
+    setIcon(BASE_VP_ADDRESS + UNRELATED_OFFSET, true);
+    setIcon(BASE_VP_ADDRESS, true);
+    setIcon(BASE_VP_ADDRESS + 2, true);
+
+    _viewtech.flush();
+
+    std::vector<uint8_t> expected;
+
+    for (uint16_t i = 0; i < 3; i += MAX_REGISTERS)
+    {
+        std::vector<uint16_t> values;
+
+        for (uint16_t j = i; (j < 3) && (j < (i + MAX_REGISTERS)); j++)
+        {
+            values.push_back(j == 1 ? ICON_STATE_OFF : ICON_STATE_ON);
+        }
+
+        auto part = frame(BASE_VP_ADDRESS + i, values);
+        expected.insert(expected.end(), part.begin(), part.end());
+    }
+
+    auto unrelated = frame(BASE_VP_ADDRESS + UNRELATED_OFFSET, { ICON_STATE_ON });
+    expected.insert(expected.end(), unrelated.begin(), unrelated.end());
+
+    ASSERT_EQ(expected, _hwa._writeBuffer);
+}
+
+TEST_F(TouchscreenViewtechTest, QueueFullBeforePostInit)
+{
+    // display reinitialized: nothing can be sent until post-init delay passes
+    ASSERT_TRUE(_viewtech.init());
+
+    for (size_t i = 0; i < TOTAL_ICONS; i++)
+    {
+        ASSERT_TRUE(setIcon(BASE_VP_ADDRESS + i, true));
+    }
+
+    // queued address can still be updated
+    ASSERT_TRUE(setIcon(BASE_VP_ADDRESS, false));
+
+    // new address doesn't fit anymore and is rejected instead of silently dropped
+    ASSERT_FALSE(setIcon(BASE_VP_ADDRESS + TOTAL_ICONS, true));
+
+    _viewtech.flush();
+    ASSERT_TRUE(_hwa._writeBuffer.empty());
+
+    core::mcu::timing::setMs(core::mcu::timing::ms() + POST_INIT_DELAY);
+
+    // once the display is ready, the queue gets flushed and rejected write is accepted
+    ASSERT_TRUE(setIcon(BASE_VP_ADDRESS + TOTAL_ICONS, true));
+    ASSERT_FALSE(_hwa._writeBuffer.empty());
+
+    _hwa._writeBuffer.clear();
+    _viewtech.flush();
+    ASSERT_EQ(frame(BASE_VP_ADDRESS + TOTAL_ICONS, { ICON_STATE_ON }), _hwa._writeBuffer);
+}
+
+TEST_F(TouchscreenViewtechTest, FullScreenRefresh)
+{
+    for (size_t i = 0; i < TOTAL_ICONS; i++)
+    {
+        setIcon(BASE_VP_ADDRESS + i, i % 2);
+    }
+
+    _viewtech.flush();
+
+    // verify frame split
+    size_t offset = 0;
+
+    for (size_t i = 0; i < TOTAL_ICONS; i += MAX_REGISTERS)
+    {
+        std::vector<uint16_t> values;
+
+        for (size_t j = i; (j < TOTAL_ICONS) && (j < (i + MAX_REGISTERS)); j++)
+        {
+            values.push_back(j % 2 ? ICON_STATE_ON : ICON_STATE_OFF);
+        }
+
+        auto expected = frame(BASE_VP_ADDRESS + i, values);
+
+        ASSERT_LE(offset + expected.size(), _hwa._writeBuffer.size());
+        ASSERT_EQ(expected, std::vector<uint8_t>(_hwa._writeBuffer.begin() + offset, _hwa._writeBuffer.begin() + offset + expected.size()));
+
+        offset += expected.size();
+    }
+
+    ASSERT_EQ(offset, _hwa._writeBuffer.size());
+
+    // verify reduction against one frame per icon
+    size_t totalFrames   = (TOTAL_ICONS + MAX_REGISTERS - 1) / MAX_REGISTERS;
+    size_t expectedBytes = (totalFrames * FRAME_OVERHEAD) + (TOTAL_ICONS * BYTES_PER_VALUE);
+
+    ASSERT_EQ(expectedBytes, _hwa._writeBuffer.size());
+
+    if ((TOTAL_ICONS > 1) && (MAX_REGISTERS > 1))
+    {
+        ASSERT_LT(_hwa._writeBuffer.size(), TOTAL_ICONS * BYTES_PER_ICON);
+    }
+
+    LOG(INFO) << "Full screen refresh of " << TOTAL_ICONS << " icons: "
+              << _hwa._writeBuffer.size() << " bytes, "
+              << TOTAL_ICONS * BYTES_PER_ICON << " bytes with single-register frames";
+}
+
+#endif
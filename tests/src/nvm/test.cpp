@@ -0,0 +1,487 @@
+/*
+
+Copyright Igor Petrovic
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#include "tests/common.h"
+#include "common/nvm/index.h"
+#include "common/nvm/store.h"
+
+#ifdef PROJECT_MCU_USE_EMU_EEPROM
+#include "common/nvm/emueeprom.h"
+#include "flashgen/hwa_emueeprom.h"
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <optional>
+
+using namespace board::detail::nvm;
+
+namespace
+{
+    /// Host flash for Store with power loss simulation.
+    /// Each erase or write is a single operation: once the configured amount of
+    /// operations is used up, power is lost and all further operations fail.
+    template<size_t PageSize, size_t Sectors>
+    class StoreFlash : public StoreHwa
+    {
+        public:
+        StoreFlash()
+        {
+            for (auto& page : _pages)
+            {
+                page.fill(0xFFFFFFFF);
+            }
+        }
+
+        bool eraseSector(size_t page, size_t sector) override
+        {
+            if (!operation())
+            {
+                return false;
+            }
+
+            constexpr size_t SECTOR_WORDS = PageSize / Sectors / sizeof(uint32_t);
+
+            std::fill(_pages.at(page).begin() + (sector * SECTOR_WORDS),
+                      _pages.at(page).begin() + ((sector + 1) * SECTOR_WORDS),
+                      0xFFFFFFFF);
+
+            _erases++;
+            return true;
+        }
+
+        bool write32(size_t page, uint32_t offset, uint32_t data) override
+        {
+            if (!operation())
+            {
+                return false;
+            }
+
+            auto& word = _pages.at(page).at(offset / sizeof(uint32_t));
+
+            // flash can only clear bits
+            if (data & ~word)
+            {
+                _invalidWrites++;
+                return false;
+            }
+
+            word = data;
+            _writes++;
+            return true;
+        }
+
+        bool read32(size_t page, uint32_t offset, uint32_t& data) override
+        {
+            if (_powerLost)
+            {
+                return false;
+            }
+
+            data = _pages.at(page).at(offset / sizeof(uint32_t));
+            return true;
+        }
+
+        /// Cuts the power after specified amount of erase and write operations.
+        void cutPowerAfter(size_t operations)
+        {
+            _operationsLeft = operations;
+            _powerLost      = false;
+        }
+
+        void restorePower()
+        {
+            _operationsLeft = SIZE_MAX;
+            _powerLost      = false;
+        }
+
+        bool powerLost() const
+        {
+            return _powerLost;
+        }
+
+        size_t _erases        = 0;
+        size_t _writes        = 0;
+        size_t _invalidWrites = 0;
+
+        private:
+        std::array<std::array<uint32_t, PageSize / sizeof(uint32_t)>, 2> _pages          = {};
+        size_t                                                           _operationsLeft = SIZE_MAX;
+        bool                                                             _powerLost      = false;
+
+        bool operation()
+        {
+            if (_powerLost || !_operationsLeft)
+            {
+                _powerLost = true;
+                return false;
+            }
+
+            if (_operationsLeft != SIZE_MAX)
+            {
+                _operationsLeft--;
+            }
+
+            return true;
+        }
+    };
+
+    constexpr size_t STORE_PAGE_SIZE = 256;
+    constexpr size_t STORE_SECTORS   = 2;
+
+    using TestStore      = Store<STORE_PAGE_SIZE, STORE_SECTORS>;
+    using TestStoreFlash = StoreFlash<STORE_PAGE_SIZE, STORE_SECTORS>;
+
+    /// Writes which overwrite every address several times so that multiple transfers happen.
+    /// Returns false once the flash fails, with the failed write (if any) in inFlight.
+    bool storeWorkload(TestStore&                         store,
+                       size_t                             writes,
+                       std::map<uint32_t, uint16_t>&      committed,
+                       std::optional<std::pair<uint32_t, uint16_t>>& inFlight)
+    {
+        for (size_t i = 0; i < writes; i++)
+        {
+            uint32_t address = (i * 5) % TestStore::SIZE;
+            auto     value   = static_cast<uint16_t>(i + 1);
+
+            if (!store.write(address, value))
+            {
+                inFlight = { address, value };
+                return false;
+            }
+
+            committed[address] = value;
+
+            // erase only from time to time, as if the traffic was sometimes active
+            if (!store.update(i % 4))
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+}    // namespace
+
+TEST(NvmIndex, TracksValues)
+{
+    constexpr size_t SIZE = 20;
+
+    Index<SIZE> index;
+    uint16_t    value = 0;
+
+    ASSERT_FALSE(index.get(0, value));
+
+    index.set(0, 1234);
+    index.set(SIZE - 1, 4321);
+
+    ASSERT_TRUE(index.get(0, value));
+    ASSERT_EQ(1234, value);
+    ASSERT_TRUE(index.get(SIZE - 1, value));
+    ASSERT_EQ(4321, value);
+
+    // out of range addresses are never indexed
+    index.set(SIZE, 1);
+    ASSERT_FALSE(index.get(SIZE, value));
+
+    index.invalidate(0);
+    ASSERT_FALSE(index.get(0, value));
+    ASSERT_TRUE(index.get(SIZE - 1, value));
+
+    index.clear();
+    ASSERT_FALSE(index.get(SIZE - 1, value));
+}
+
+#ifdef PROJECT_MCU_USE_EMU_EEPROM
+TEST(NvmIndex, ReadLatency)
+{
+    constexpr size_t RECORDS = EMU_EEPROM_PAGE_SIZE / sizeof(uint32_t);
+    constexpr auto   TYPE    = board::nvm::parameterType_t::WORD;
+
+    // both use the same emulated EEPROM: one with index, as used by the board, and one without it
+    flashgen::HwaEmuEeprom    hwa;
+    lib::emueeprom::EmuEEPROM emuEeprom(hwa, false);
+    EmuEeprom<RECORDS>        indexed(emuEeprom);
+    EmuEeprom<0>              searched(emuEeprom);
+
+    ASSERT_TRUE(indexed.init());
+
+    const uint32_t ADDRESSES = std::min<uint32_t>(indexed.size(), 256);
+    const size_t   WRITES    = (RECORDS * 9) / 10;
+
+    auto readAll = [&](auto& nvm)
+    {
+        uint32_t checksum = 0;
+
+        for (uint32_t address = 0; address < ADDRESSES; address++)
+        {
+            uint32_t value = 0;
+
+            if (!nvm.read(address, value, TYPE))
+            {
+                return std::optional<uint32_t>();
+            }
+
+            checksum += value;
+        }
+
+        return std::optional<uint32_t>(checksum);
+    };
+
+    // fill the page up to ~90% with repeated writes so that the latest records are near its end
+    size_t written = 0;
+
+    for (; written < WRITES; written++)
+    {
+        ASSERT_TRUE(indexed.write(written % ADDRESSES, static_cast<uint16_t>(written), TYPE, false));
+    }
+
+    auto start        = std::chrono::steady_clock::now();
+    auto scanChecksum = readAll(searched);
+    auto scanNs       = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+
+    start              = std::chrono::steady_clock::now();
+    auto indexChecksum = readAll(indexed);
+    auto indexNs       = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+
+    // index must resolve the same latest values as the page search
+    ASSERT_TRUE(scanChecksum.has_value());
+    ASSERT_EQ(scanChecksum, indexChecksum);
+
+    LOG(INFO) << "Emulated EEPROM page with " << WRITES << " of " << RECORDS << " records used, " << ADDRESSES << " addresses";
+    LOG(INFO) << "Average read: " << (scanNs / ADDRESSES) << " ns searching the page, "
+              << (indexNs / ADDRESSES) << " ns with RAM index";
+
+    // value written to cache only must not be served from the index once it reaches flash
+    constexpr uint16_t CACHED_VALUE = 0xABCD;
+
+    uint32_t value = 0;
+
+    ASSERT_TRUE(indexed.write(0, CACHED_VALUE, TYPE, true));
+    indexed.writeCacheToFlash();
+    ASSERT_TRUE(indexed.read(0, value, TYPE));
+    ASSERT_EQ(CACHED_VALUE, value);
+
+    // index stays valid across page transfers
+    for (size_t i = 0; i < RECORDS; i++, written++)
+    {
+        ASSERT_TRUE(indexed.write(written % ADDRESSES, static_cast<uint16_t>(written), TYPE, false));
+    }
+
+    ASSERT_EQ(readAll(searched), readAll(indexed));
+
+    // and is cleared together with the memory
+    ASSERT_TRUE(indexed.clear());
+    ASSERT_EQ(std::optional<uint32_t>(0), readAll(indexed));
+}
+#endif
+
+TEST(NvmStore, TransferInSteps)
+{
+    TestStoreFlash flash;
+    TestStore      store(flash);
+
+    ASSERT_TRUE(store.init());
+
+    constexpr size_t WRITES = TestStore::RECORDS * 8;
+
+    // enough steps to copy all the addresses before the headroom is used up
+    constexpr size_t UPDATES_PER_WRITE = (TestStore::SIZE / TestStore::HEADROOM) + 1;
+
+    std::map<uint32_t, uint16_t> values;
+    size_t                       transfers = 0;
+
+    for (size_t i = 0; i < WRITES; i++)
+    {
+        uint32_t address = (i * 5) % TestStore::SIZE;
+        auto     value   = static_cast<uint16_t>(i + 1);
+
+        auto erases = flash._erases;
+        auto writes = flash._writes;
+
+        // write never waits for the transfer: at most the mirrored record is written as well
+        ASSERT_TRUE(store.write(address, value));
+        ASSERT_EQ(erases, flash._erases);
+        ASSERT_LE(flash._writes - writes, 2);
+
+        values[address] = value;
+
+        // erase is postponed while not allowed
+        erases = flash._erases;
+        ASSERT_TRUE(store.update(false));
+        ASSERT_EQ(erases, flash._erases);
+
+        // main loop runs far more often than values are written
+        for (size_t step = 0; step < UPDATES_PER_WRITE; step++)
+        {
+            bool transferring = store.transferring();
+
+            // single step erases at most one sector
+            erases = flash._erases;
+            ASSERT_TRUE(store.update(true));
+            ASSERT_LE(flash._erases - erases, 1);
+
+            if (transferring && !store.transferring())
+            {
+                transfers++;
+            }
+        }
+    }
+
+    ASSERT_GT(transfers, 2);
+    ASSERT_EQ(0, flash._invalidWrites);
+
+    for (const auto& [address, value] : values)
+    {
+        uint16_t readValue = 0;
+
+        ASSERT_TRUE(store.read(address, readValue));
+        ASSERT_EQ(value, readValue);
+    }
+
+    LOG(INFO) << WRITES << " writes with " << transfers << " page transfers, " << flash._erases << " sector erases";
+}
+
+TEST(NvmStore, FullPageWithoutUpdate)
+{
+    TestStoreFlash flash;
+    TestStore      store(flash);
+
+    ASSERT_TRUE(store.init());
+
+    // without update() calls the transfer has to be done on write once the page is full
+    for (size_t i = 0; i < TestStore::RECORDS * 3; i++)
+    {
+        ASSERT_TRUE(store.write(i % TestStore::SIZE, i));
+    }
+
+    for (size_t i = (TestStore::RECORDS * 3) - TestStore::SIZE; i < TestStore::RECORDS * 3; i++)
+    {
+        uint16_t value = 0;
+
+        ASSERT_TRUE(store.read(i % TestStore::SIZE, value));
+        ASSERT_EQ(i, value);
+    }
+
+    // invalid address
+    ASSERT_FALSE(store.write(TestStore::SIZE, 0));
+}
+
+TEST(NvmStore, PowerLoss)
+{
+    constexpr size_t WRITES = TestStore::RECORDS * 6;
+
+    // find out how many flash operations the entire workload takes
+    size_t totalOperations = 0;
+
+    {
+        TestStoreFlash                               flash;
+        TestStore                                    store(flash);
+        std::map<uint32_t, uint16_t>                 committed;
+        std::optional<std::pair<uint32_t, uint16_t>> inFlight;
+
+        ASSERT_TRUE(store.init());
+
+        auto start = flash._erases + flash._writes;
+        ASSERT_TRUE(storeWorkload(store, WRITES, committed, inFlight));
+        totalOperations = flash._erases + flash._writes - start;
+    }
+
+    // cut the power after every single operation and verify that nothing acknowledged is lost
+    for (size_t cut = 0; cut < totalOperations; cut++)
+    {
+        TestStoreFlash                               flash;
+        std::map<uint32_t, uint16_t>                 committed;
+        std::optional<std::pair<uint32_t, uint16_t>> inFlight;
+
+        {
+            TestStore store(flash);
+            ASSERT_TRUE(store.init());
+
+            flash.cutPowerAfter(cut);
+            ASSERT_FALSE(storeWorkload(store, WRITES, committed, inFlight));
+            ASSERT_TRUE(flash.powerLost());
+        }
+
+        // power can be lost again while recovering
+        for (size_t recoveryCut = 0;; recoveryCut++)
+        {
+            auto recoveryFlash = flash;
+            bool recovered     = false;
+
+            {
+                TestStore store(recoveryFlash);
+
+                recoveryFlash.cutPowerAfter(recoveryCut);
+                recovered = store.init();
+            }
+
+            recoveryFlash.restorePower();
+
+            TestStore store(recoveryFlash);
+            ASSERT_TRUE(store.init());
+            ASSERT_EQ(0, recoveryFlash._invalidWrites);
+
+            for (uint32_t address = 0; address < TestStore::SIZE; address++)
+            {
+                uint16_t value = 0;
+                bool     found = store.read(address, value);
+
+                // interrupted write either made it or not
+                if (inFlight && (inFlight->first == address) && found && (value == inFlight->second))
+                {
+                    continue;
+                }
+
+                auto it = committed.find(address);
+
+                if (it == committed.end())
+                {
+                    ASSERT_FALSE(found) << "cut " << cut << ", address " << address;
+                }
+                else
+                {
+                    ASSERT_TRUE(found) << "cut " << cut << ", address " << address;
+                    ASSERT_EQ(it->second, value) << "cut " << cut << ", address " << address;
+                }
+            }
+
+            // recovered store keeps working
+            std::map<uint32_t, uint16_t>                 newValues;
+            std::optional<std::pair<uint32_t, uint16_t>> newInFlight;
+
+            ASSERT_TRUE(storeWorkload(store, TestStore::RECORDS * 2, newValues, newInFlight));
+
+            for (const auto& [address, value] : newValues)
+            {
+                uint16_t readValue = 0;
+
+                ASSERT_TRUE(store.read(address, readValue));
+                ASSERT_EQ(value, readValue);
+            }
+
+            if (recovered)
+            {
+                break;
+            }
+        }
+    }
+
+    LOG(INFO) << "Power loss verified after each of " << totalOperations << " flash operations";
+}
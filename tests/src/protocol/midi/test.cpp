@@ -20,6 +20,10 @@ limitations under the License.
 
 #include "tests/common.h"
 #include "application/protocol/midi/builder.h"
+#include "application/global/midi_clock.h"
+
+#include <cmath>
+#include <chrono>
 
 using namespace io;
 using namespace protocol;
@@ -31,6 +35,9 @@ namespace
         protected:
         void SetUp() override
         {
+            // clock tracking is global: don't let previous tests affect it
+            MidiClock.reset();
+
             ASSERT_TRUE(_databaseAdmin.init());
 
             EXPECT_CALL(_midi._hwaSerial, setLoopback(false))
@@ -41,6 +48,7 @@ namespace
 
         void TearDown() override
         {
+            MidiClock.reset();
         }
 
         database::Builder       _builderDatabase;
@@ -82,4 +90,336 @@ TEST_F(MIDITest, OmniChannel)
     }
 }
 
+TEST_F(MIDITest, ClockTrackingSmoothsJitter)
+{
+    // 120 BPM clock with up to 4 ms of jitter, received with 1 ms resolution
+    static constexpr uint32_t TOTAL_PULSES    = 24 * 32;
+    static constexpr double   PULSE_PERIOD_MS = 60000.0 / 24 / 120;
+    static constexpr int32_t  MAX_JITTER_US   = 4000;
+
+    std::vector<uint32_t> pulseTimes = {};
+    uint32_t              seed       = 1;
+
+    for (size_t i = 0; i < TOTAL_PULSES; i++)
+    {
+        seed        = seed * 1664525 + 1013904223;
+        auto jitter = static_cast<int32_t>(seed >> 16) % (MAX_JITTER_US + 1) * ((seed & 0x01) ? 1 : -1);
+
+        pulseTimes.push_back(static_cast<uint32_t>((1000000 + (i * PULSE_PERIOD_MS * 1000) + jitter) / 1000));
+    }
+
+    MidiClock.start();
+
+    std::vector<uint32_t> smoothedTimes = {};
+    uint32_t              lastPulses    = 0;
+    size_t                pulseIndex    = 0;
+
+    for (uint32_t ms = pulseTimes.front(); ms <= pulseTimes.back(); ms++)
+    {
+        while ((pulseIndex < pulseTimes.size()) && (pulseTimes.at(pulseIndex) == ms))
+        {
+            MidiClock.pulse(ms);
+            pulseIndex++;
+        }
+
+        auto pulses = MidiClock.pulses(ms);
+
+        // smoothed clock is checked every millisecond so it can never skip a pulse
+        ASSERT_LE(pulses - lastPulses, 1U);
+
+        if (pulses != lastPulses)
+        {
+            smoothedTimes.push_back(ms);
+            lastPulses = pulses;
+        }
+    }
+
+    ASSERT_TRUE(MidiClock.locked());
+    ASSERT_NEAR(1200, MidiClock.bpmX10(), 5);
+
+    // compare the largest deviation of pulse interval once the tracker has settled
+    auto maxDeviation = [&](const std::vector<uint32_t>& times)
+    {
+        double deviation = 0;
+
+        for (size_t i = 24 * 8; i < times.size(); i++)
+        {
+            deviation = std::max(deviation, std::fabs(times.at(i) - times.at(i - 1) - PULSE_PERIOD_MS));
+        }
+
+        return deviation;
+    };
+
+    auto rawDeviation      = maxDeviation(pulseTimes);
+    auto smoothedDeviation = maxDeviation(smoothedTimes);
+
+    LOG(INFO) << "Max pulse interval deviation: raw " << rawDeviation << " ms, smoothed " << smoothedDeviation << " ms";
+    LOG(INFO) << "Reported jitter: average " << MidiClock.stats().averageJitterUs << " us, max " << MidiClock.stats().maxJitterUs << " us";
+
+    ASSERT_LT(smoothedDeviation, rawDeviation / 2);
+}
+
+TEST_F(MIDITest, RawThruBenchmark)
+{
+    static constexpr size_t TOTAL_PACKETS = 10000;
+
+    ASSERT_TRUE(_databaseAdmin.update(database::Config::Section::global_t::MIDI_SETTINGS, midi::setting_t::USB_THRU_USB, 1));
+
+#ifdef PROJECT_TARGET_SUPPORT_DIN_MIDI
+    ASSERT_TRUE(_databaseAdmin.update(database::Config::Section::global_t::MIDI_SETTINGS, midi::setting_t::DIN_ENABLED, 1));
+    ASSERT_TRUE(_databaseAdmin.update(database::Config::Section::global_t::MIDI_SETTINGS, midi::setting_t::USB_THRU_DIN, 1));
+
+    EXPECT_CALL(_midi._hwaSerial, init())
+        .WillRepeatedly(Return(true));
+#endif
+
+    EXPECT_CALL(_midi._hwaSerial, setLoopback(false))
+        .WillOnce(Return(true));
+
+    ASSERT_TRUE(_midi._instance.init());
+
+    // control change on channel 1
+    midi::UsbPacket packet       = {};
+    packet.data[midi::USB_EVENT] = 0x0B;
+    packet.data[midi::USB_DATA1] = 0xB0;
+    packet.data[midi::USB_DATA2] = 64;
+    packet.data[midi::USB_DATA3] = 100;
+
+    auto samePacket = [&](const midi::UsbPacket& written)
+    {
+        return (written.data[midi::USB_EVENT] == packet.data[midi::USB_EVENT]) &&
+               (written.data[midi::USB_DATA1] == packet.data[midi::USB_DATA1]) &&
+               (written.data[midi::USB_DATA2] == packet.data[midi::USB_DATA2]) &&
+               (written.data[midi::USB_DATA3] == packet.data[midi::USB_DATA3]);
+    };
+
+    // latency: forwarded packet must be written out within the same read call, unmodified
+    _midi._hwaUsb._readPackets.push_back(packet);
+    _midi._instance.read();
+
+    ASSERT_EQ(1, _midi._hwaUsb._writePackets.size());
+    ASSERT_TRUE(samePacket(_midi._hwaUsb._writePackets.at(0)));
+
+#ifdef PROJECT_TARGET_SUPPORT_DIN_MIDI
+    ASSERT_EQ(3, _midi._hwaSerial._writePackets.size());
+    ASSERT_EQ(packet.data[midi::USB_DATA1], _midi._hwaSerial._writePackets.at(0).data);
+    ASSERT_EQ(packet.data[midi::USB_DATA2], _midi._hwaSerial._writePackets.at(1).data);
+    ASSERT_EQ(packet.data[midi::USB_DATA3], _midi._hwaSerial._writePackets.at(2).data);
+    _midi._hwaSerial.clear();
+#endif
+
+    _midi._hwaUsb.clear();
+
+    for (size_t i = 0; i < TOTAL_PACKETS; i++)
+    {
+        _midi._hwaUsb._readPackets.push_back(packet);
+    }
+
+    size_t readCalls = 0;
+    auto   start     = std::chrono::steady_clock::now();
+
+    while (_midi._hwaUsb._readPackets.size() || _midi._instance.pending())
+    {
+        _midi._instance.read();
+        readCalls++;
+    }
+
+    auto elapsedNs = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+
+    ASSERT_EQ(TOTAL_PACKETS, _midi._hwaUsb._writePackets.size());
+
+    for (size_t i = 0; i < TOTAL_PACKETS; i++)
+    {
+        ASSERT_TRUE(samePacket(_midi._hwaUsb._writePackets.at(i)));
+    }
+
+    size_t forwardedBytes = TOTAL_PACKETS * midi::RawThru::usbPacketSize(packet);
+
+#ifdef PROJECT_TARGET_SUPPORT_DIN_MIDI
+    ASSERT_EQ(forwardedBytes, _midi._hwaSerial._writePackets.size());
+    forwardedBytes *= 2;
+#endif
+
+    LOG(INFO) << "Forwarded " << forwardedBytes << " bytes in " << readCalls << " read calls, "
+              << (elapsedNs / static_cast<double>(forwardedBytes)) << " ns per forwarded byte (including parsing)";
+}
+
+TEST_F(MIDITest, RawThruSerialFraming)
+{
+    midi::HwaUsbTest    hwaUsb;
+    midi::HwaSerialTest hwaSerial;
+    midi::RawThru       thru(hwaUsb, hwaSerial);
+
+    thru.setRoute(midi::RawThru::route_t::DIN_TO_DIN, true);
+    thru.setRoute(midi::RawThru::route_t::USB_TO_DIN, true);
+
+    // every DIN byte is read separately, just like in the serial transport
+    auto dinIn = [&](const std::vector<uint8_t>& bytes)
+    {
+        for (auto byte : bytes)
+        {
+            midi::SerialPacket packet = {};
+            packet.data               = byte;
+            hwaSerial._readPackets.push_back(packet);
+            ASSERT_TRUE(thru.serial().read(packet));
+        }
+    };
+
+    // application messages are written in full from the transport, one byte at a time
+    auto appOut = [&](const std::vector<uint8_t>& bytes)
+    {
+        for (auto byte : bytes)
+        {
+            midi::SerialPacket packet = {};
+            packet.data               = byte;
+            ASSERT_TRUE(thru.serial().write(packet));
+        }
+    };
+
+    auto written = [&]()
+    {
+        std::vector<uint8_t> bytes = {};
+
+        for (auto& packet : hwaSerial._writePackets)
+        {
+            bytes.push_back(packet.data);
+        }
+
+        hwaSerial.clear();
+        return bytes;
+    };
+
+    // note on split across reads: application message sent in between mustn't end up inside it
+    dinIn({ 0x90, 0x3C });
+    appOut({ 0xB0, 0x07, 0x64 });
+    dinIn({ 0x7F });
+    ASSERT_EQ(std::vector<uint8_t>({ 0xB0, 0x07, 0x64, 0x90, 0x3C, 0x7F }), written());
+
+    // running status from DIN is kept as long as the output is in the same running status
+    dinIn({ 0x3D, 0x7F });
+    ASSERT_EQ(std::vector<uint8_t>({ 0x3D, 0x7F }), written());
+
+    // application relies on running status, but the last status on the output came from thru: resend it
+    appOut({ 0x07, 0x10 });
+    ASSERT_EQ(std::vector<uint8_t>({ 0xB0, 0x07, 0x10 }), written());
+
+    appOut({ 0x07, 0x11 });
+    ASSERT_EQ(std::vector<uint8_t>({ 0x07, 0x11 }), written());
+
+    // same for DIN running status after application message
+    dinIn({ 0x3E, 0x7F });
+    ASSERT_EQ(std::vector<uint8_t>({ 0x90, 0x3E, 0x7F }), written());
+
+    // realtime can be sent in between bytes of any message
+    dinIn({ 0x90, 0x40 });
+    appOut({ 0xF8 });
+    dinIn({ 0x7F });
+    ASSERT_EQ(std::vector<uint8_t>({ 0xF8, 0x90, 0x40, 0x7F }), written());
+
+    // DIN SysEx is written as it arrives, application message is held until it ends
+    dinIn({ 0xF0, 0x01, 0x02 });
+    appOut({ 0xB0, 0x07, 0x20 });
+    ASSERT_EQ(std::vector<uint8_t>({ 0xF0, 0x01, 0x02 }), written());
+
+    // SysEx from another thru source can't be written in the meantime
+    midi::UsbPacket packet       = {};
+    packet.data[midi::USB_EVENT] = 0x07;
+    packet.data[midi::USB_DATA1] = 0xF0;
+    packet.data[midi::USB_DATA2] = 0x05;
+    packet.data[midi::USB_DATA3] = 0xF7;
+    hwaUsb._readPackets.push_back(packet);
+    ASSERT_TRUE(thru.usb().read(packet));
+    ASSERT_EQ(0, written().size());
+
+    dinIn({ 0x03, 0xF7 });
+    ASSERT_EQ(std::vector<uint8_t>({ 0x03, 0xF7, 0xB0, 0x07, 0x20 }), written());
+
+    // application data which doesn't fit in the hold buffer cuts the thru SysEx short
+    dinIn({ 0xF0, 0x01 });
+
+    std::vector<uint8_t> appData = {};
+
+    for (size_t i = 0; i <= (midi::RawThru::SERIAL_HOLD_BUFFER_SIZE / 3); i++)
+    {
+        appData.insert(appData.end(), { 0xB0, 0x07, static_cast<uint8_t>(i) });
+    }
+
+    appOut(appData);
+
+    std::vector<uint8_t> expected = { 0xF0, 0x01, 0xF7 };
+    expected.insert(expected.end(), appData.begin(), appData.end());
+    ASSERT_EQ(expected, written());
+
+    // rest of the SysEx is dropped
+    dinIn({ 0x02, 0x03, 0xF7 });
+    ASSERT_EQ(0, written().size());
+
+    // incomplete message is dropped once the route is disabled
+    dinIn({ 0x90, 0x41 });
+    thru.setRoute(midi::RawThru::route_t::DIN_TO_DIN, false);
+    thru.setRoute(midi::RawThru::route_t::DIN_TO_DIN, true);
+    dinIn({ 0x7F });
+    ASSERT_EQ(0, written().size());
+}
+
+TEST_F(MIDITest, RawThruAppSysExAfterThruSysEx)
+{
+    midi::HwaUsbTest    hwaUsb;
+    midi::HwaSerialTest hwaSerial;
+    midi::RawThru       thru(hwaUsb, hwaSerial);
+
+    thru.setRoute(midi::RawThru::route_t::DIN_TO_DIN, true);
+
+    auto dinIn = [&](const std::vector<uint8_t>& bytes)
+    {
+        for (auto byte : bytes)
+        {
+            midi::SerialPacket packet = {};
+            packet.data               = byte;
+            hwaSerial._readPackets.push_back(packet);
+            ASSERT_TRUE(thru.serial().read(packet));
+        }
+    };
+
+    auto appOut = [&](const std::vector<uint8_t>& bytes)
+    {
+        for (auto byte : bytes)
+        {
+            midi::SerialPacket packet = {};
+            packet.data               = byte;
+            ASSERT_TRUE(thru.serial().write(packet));
+        }
+    };
+
+    auto written = [&]()
+    {
+        std::vector<uint8_t> bytes = {};
+
+        for (auto& packet : hwaSerial._writePackets)
+        {
+            bytes.push_back(packet.data);
+        }
+
+        hwaSerial.clear();
+        return bytes;
+    };
+
+    // application SysEx is started while DIN SysEx is written out: its start is held
+    dinIn({ 0xF0, 0x01 });
+    appOut({ 0xF0, 0x10, 0x11 });
+    ASSERT_EQ(std::vector<uint8_t>({ 0xF0, 0x01 }), written());
+
+    // once DIN SysEx ends, application SysEx takes over the output
+    dinIn({ 0xF7 });
+    ASSERT_EQ(std::vector<uint8_t>({ 0xF7, 0xF0, 0x10, 0x11 }), written());
+
+    // DIN message is now held until the application SysEx is complete
+    dinIn({ 0x90, 0x3C, 0x7F });
+    appOut({ 0x12, 0x13 });
+    ASSERT_EQ(std::vector<uint8_t>({ 0x12, 0x13 }), written());
+
+    appOut({ 0xF7 });
+    ASSERT_EQ(std::vector<uint8_t>({ 0xF7, 0x90, 0x3C, 0x7F }), written());
+}
+
 #endif
\ No newline at end of file
@@ -25,6 +25,9 @@ limitations under the License.
 #include "application/util/configurable/configurable.h"
 #include "core/mcu.h"
 
+#include <chrono>
+#include <algorithm>
+
 using namespace io;
 using namespace protocol;
 
@@ -41,6 +44,7 @@ namespace
         {
             ConfigHandler.clear();
             MidiDispatcher.clear();
+            SysExDispatcher.clear();
             _listener._event.clear();
         }
 
@@ -708,4 +712,755 @@ TEST_F(SystemTest, UsbThruDin)
 }
 #endif
 
+TEST_F(SystemTest, InputLatencyBoundedUnderMidiFlood)
+{
+    // on init, all LEDs are turned off by calling hwa interface - irrelevant here
+    EXPECT_CALL(_system._components._builderLeds._hwa, setState(_, leds::brightness_t::OFF))
+        .Times(leds::Collection::SIZE(leds::GROUP_DIGITAL_OUTPUTS));
+
+    // Loopback state will be set regardless of whether DIN is enabled or not.
+    // Since it is not, it should be called with false argument.
+    EXPECT_CALL(_system._components._builderMidi._hwaSerial, setLoopback(false))
+        .WillOnce(Return(true));
+
+    ASSERT_TRUE(_system._instance.init());
+
+    MidiDispatcher.listen(messaging::eventType_t::MIDI_IN,
+                          [this](const messaging::Event& dispatchMessage)
+                          {
+                              _listener.messageListener(dispatchMessage);
+                          });
+
+    // simulate large feedback dump from DAW with MIDI clock running at the same time
+    static constexpr size_t FLOOD_SIZE     = 5000;
+    static constexpr size_t CLOCK_INTERVAL = 100;
+
+    std::vector<midi::UsbPacket> packets = {};
+    messaging::Event             event   = {};
+
+    for (size_t i = 0; i < FLOOD_SIZE; i++)
+    {
+        if (!(i % CLOCK_INTERVAL))
+        {
+            event.message = midi::messageType_t::SYS_REAL_TIME_CLOCK;
+
+            auto clock = _helper.midiToUsbPackets(event);
+            packets.insert(packets.end(), clock.begin(), clock.end());
+        }
+
+        // message type which doesn't change the state of any component
+        event.message = midi::messageType_t::AFTER_TOUCH_CHANNEL;
+        event.channel = 1;
+        event.value   = i % 128;
+
+        auto afterTouch = _helper.midiToUsbPackets(event);
+        packets.insert(packets.end(), afterTouch.begin(), afterTouch.end());
+    }
+
+    _system._components._builderMidi._hwaUsb._readPackets = packets;
+
+    // don't care about hwa calls here
+    EXPECT_CALL(_system._components._builderButtons._hwa, state(_, _, _))
+        .Times(AnyNumber());
+
+    EXPECT_CALL(_system._components._builderAnalog._hwa, value(_, _))
+        .Times(AnyNumber());
+
+    size_t runs           = 0;
+    size_t totalMessages  = 0;
+    size_t totalClocks    = 0;
+    size_t maxRunMessages = 0;
+
+    while (_system._components._builderMidi._hwaUsb._readPackets.size() || _system._components._builderMidi._instance.pending())
+    {
+        _listener._event.clear();
+        _system._instance.run();
+        runs++;
+
+        size_t runMessages = 0;
+
+        for (const auto& received : _listener._event)
+        {
+            if (received.message == midi::messageType_t::SYS_REAL_TIME_CLOCK)
+            {
+                // realtime messages must never wait behind the queued ones
+                ASSERT_EQ(0, runMessages);
+                totalClocks++;
+            }
+            else
+            {
+                runMessages++;
+            }
+        }
+
+        // input scanning is resumed after a bounded amount of processed messages
+        ASSERT_LE(runMessages, midi::Midi::MAX_MESSAGES_PER_READ);
+
+        totalMessages += runMessages;
+        maxRunMessages = std::max(maxRunMessages, runMessages);
+    }
+
+    LOG(INFO) << "Processed " << totalMessages << " messages in " << runs << " loop runs, at most " << maxRunMessages << " per run";
+
+    // nothing is lost
+    ASSERT_EQ(FLOOD_SIZE, totalMessages);
+    ASSERT_EQ(FLOOD_SIZE / CLOCK_INTERVAL, totalClocks);
+}
+
+#ifdef PROJECT_TARGET_SUPPORT_DIN_MIDI
+TEST_F(SystemTest, DinNotStarvedByUsbFlood)
+{
+    EXPECT_CALL(_system._components._builderLeds._hwa, setState(_, _))
+        .Times(AnyNumber());
+
+    EXPECT_CALL(_system._components._builderMidi._hwaSerial, setLoopback(false))
+        .WillOnce(Return(true));
+
+    EXPECT_CALL(_system._components._builderButtons._hwa, state(_, _, _))
+        .Times(AnyNumber());
+
+    EXPECT_CALL(_system._components._builderAnalog._hwa, value(_, _))
+        .Times(AnyNumber());
+
+    ASSERT_TRUE(_system._instance.init());
+
+    handshake();
+
+    EXPECT_CALL(_system._components._builderMidi._hwaSerial, init())
+        .WillOnce(Return(true));
+
+    ASSERT_TRUE(_helper.databaseWriteToSystemViaSysEx(sys::Config::Section::global_t::MIDI_SETTINGS,
+                                                      protocol::midi::setting_t::DIN_ENABLED,
+                                                      1));
+
+    // USB messages are received on channel 1, DIN ones on channel 2
+    static constexpr size_t USB_FLOOD_SIZE = 1000;
+    static constexpr size_t DIN_SIZE       = 20;
+
+    size_t usbReceived = 0;
+    size_t dinReceived = 0;
+
+    MidiDispatcher.listen(messaging::eventType_t::MIDI_IN,
+                          [&](const messaging::Event& event)
+                          {
+                              if (event.message != midi::messageType_t::AFTER_TOUCH_CHANNEL)
+                              {
+                                  return;
+                              }
+
+                              if (event.channel == 1)
+                              {
+                                  usbReceived++;
+                              }
+                              else if (event.channel == 2)
+                              {
+                                  dinReceived++;
+                              }
+                          });
+
+    std::vector<midi::UsbPacket> packets = {};
+    messaging::Event             event   = {};
+    event.message                        = midi::messageType_t::AFTER_TOUCH_CHANNEL;
+    event.channel                        = 1;
+
+    for (size_t i = 0; i < USB_FLOOD_SIZE; i++)
+    {
+        event.value = i % 128;
+
+        auto converted = _helper.midiToUsbPackets(event);
+        packets.insert(packets.end(), converted.begin(), converted.end());
+    }
+
+    _system._components._builderMidi._hwaUsb._readPackets = packets;
+
+    for (size_t i = 0; i < DIN_SIZE; i++)
+    {
+        _system._components._builderMidi._hwaSerial._readPackets.push_back(midi::SerialPacket{ 0xD1 });
+        _system._components._builderMidi._hwaSerial._readPackets.push_back(midi::SerialPacket{ static_cast<uint8_t>(i) });
+    }
+
+    size_t runs = 0;
+
+    while (dinReceived < DIN_SIZE)
+    {
+        _system._instance.run();
+        ASSERT_LT(++runs, USB_FLOOD_SIZE);
+    }
+
+    LOG(INFO) << "All " << DIN_SIZE << " DIN messages processed in " << runs << " loop runs, along with " << usbReceived << " USB messages";
+
+    // DIN input is handled while USB is still flooded: both interfaces get their share of each read
+    ASSERT_FALSE(_system._components._builderMidi._hwaUsb._readPackets.empty());
+    ASSERT_LE(runs, (DIN_SIZE + midi::Midi::MAX_QUEUED_MESSAGES_PER_INTERFACE - 1) / midi::Midi::MAX_QUEUED_MESSAGES_PER_INTERFACE * 2);
+
+    while (_system._components._builderMidi._hwaUsb._readPackets.size() || _system._components._builderMidi._instance.pending())
+    {
+        _system._instance.run();
+    }
+
+    // nothing is lost
+    ASSERT_EQ(USB_FLOOD_SIZE, usbReceived);
+    ASSERT_EQ(DIN_SIZE, dinReceived);
+}
+#endif
+
+TEST_F(SystemTest, SysExKeepsOrder)
+{
+    EXPECT_CALL(_system._components._builderLeds._hwa, setState(_, _))
+        .Times(AnyNumber());
+
+    EXPECT_CALL(_system._components._builderMidi._hwaSerial, setLoopback(false))
+        .WillOnce(Return(true));
+
+    EXPECT_CALL(_system._components._builderButtons._hwa, state(_, _, _))
+        .Times(AnyNumber());
+
+    EXPECT_CALL(_system._components._builderAnalog._hwa, value(_, _))
+        .Times(AnyNumber());
+
+    ASSERT_TRUE(_system._instance.init());
+
+    // SysEx is marked with invalid MIDI value
+    // messages before it have to fit in the share of the queue available to single interface
+    static constexpr int16_t SYS_EX_MARKER = -1;
+    static constexpr size_t  BEFORE        = midi::Midi::MAX_QUEUED_MESSAGES_PER_INTERFACE - 1;
+    static constexpr size_t  AFTER         = 5;
+
+    std::vector<int16_t> received = {};
+
+    MidiDispatcher.listen(messaging::eventType_t::MIDI_IN,
+                          [&received](const messaging::Event& event)
+                          {
+                              if (event.message == midi::messageType_t::AFTER_TOUCH_CHANNEL)
+                              {
+                                  received.push_back(static_cast<int16_t>(event.value));
+                              }
+                          });
+
+    SysExDispatcher.listen(messaging::eventType_t::MIDI_IN,
+                           [&received](const messaging::SysExView& sysEx)
+                           {
+                               received.push_back(SYS_EX_MARKER);
+                           });
+
+    std::vector<midi::UsbPacket> packets = {};
+    std::vector<int16_t>         expected = {};
+    messaging::Event             event    = {};
+
+    event.message = midi::messageType_t::AFTER_TOUCH_CHANNEL;
+    event.channel = 1;
+
+    auto afterTouch = [&](size_t count)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            event.value = expected.size();
+            expected.push_back(static_cast<int16_t>(event.value));
+
+            auto converted = _helper.midiToUsbPackets(event);
+            packets.insert(packets.end(), converted.begin(), converted.end());
+        }
+    };
+
+    afterTouch(BEFORE);
+
+    std::vector<uint8_t> sysEx     = { 0xF0, 0x01, 0x02, 0x03, 0xF7 };
+    auto                 converted = _helper.rawSysExToUSBPackets(sysEx);
+    packets.insert(packets.end(), converted.begin(), converted.end());
+    expected.push_back(SYS_EX_MARKER);
+
+    afterTouch(AFTER);
+
+    _system._components._builderMidi._hwaUsb._readPackets = packets;
+
+    size_t runs       = 0;
+    size_t sysExRun   = 0;
+    auto   start      = std::chrono::steady_clock::now();
+    auto   sysExNs    = std::chrono::steady_clock::now() - start;
+    bool   sysExFound = false;
+
+    while (_system._components._builderMidi._hwaUsb._readPackets.size() || _system._components._builderMidi._instance.pending())
+    {
+        _system._instance.run();
+        runs++;
+
+        if (!sysExFound && (std::find(received.begin(), received.end(), SYS_EX_MARKER) != received.end()))
+        {
+            sysExFound = true;
+            sysExRun   = runs;
+            sysExNs    = std::chrono::steady_clock::now() - start;
+        }
+    }
+
+    LOG(INFO) << "SysEx processed in loop run " << sysExRun << " of " << runs << ", after "
+              << std::chrono::duration_cast<std::chrono::microseconds>(sysExNs).count() << " us";
+
+    // SysEx doesn't overtake the messages received before it
+    ASSERT_EQ(expected, received);
+
+    // all of it fits in the queue: SysEx is processed in the same run in which it's received
+    ASSERT_TRUE(sysExFound);
+    ASSERT_EQ(1, sysExRun);
+}
+
+TEST_F(SystemTest, TrafficIdle)
+{
+    EXPECT_CALL(_system._components._builderLeds._hwa, setState(_, _))
+        .Times(AnyNumber());
+
+    EXPECT_CALL(_system._components._builderMidi._hwaSerial, setLoopback(false))
+        .WillRepeatedly(Return(true));
+
+    ASSERT_TRUE(_system._instance.init());
+
+    std::vector<messaging::systemMessage_t> messages;
+
+    MidiDispatcher.listen(messaging::eventType_t::SYSTEM,
+                          [&messages](const messaging::Event& event)
+                          {
+                              if ((event.systemMessage == messaging::systemMessage_t::TRAFFIC_ACTIVE) ||
+                                  (event.systemMessage == messaging::systemMessage_t::TRAFFIC_IDLE))
+                              {
+                                  messages.push_back(event.systemMessage);
+                              }
+                          });
+
+    messaging::Event event = {};
+    event.channel          = 1;
+    event.index            = 0;
+    event.value            = 127;
+    event.message          = midi::messageType_t::NOTE_ON;
+
+    _helper.processIncoming(event);
+
+    ASSERT_EQ(1, messages.size());
+    ASSERT_EQ(messaging::systemMessage_t::TRAFFIC_ACTIVE, messages.at(0));
+
+    // ongoing traffic only postpones the idle state
+    core::mcu::timing::setMs(core::mcu::timing::ms() + sys::TRAFFIC_IDLE_DELAY - 1);
+    _helper.processIncoming(event);
+
+    ASSERT_EQ(1, messages.size());
+
+    core::mcu::timing::setMs(core::mcu::timing::ms() + sys::TRAFFIC_IDLE_DELAY - 1);
+    _system._instance.run();
+
+    ASSERT_EQ(1, messages.size());
+
+    core::mcu::timing::setMs(core::mcu::timing::ms() + 1);
+    _system._instance.run();
+
+    ASSERT_EQ(2, messages.size());
+    ASSERT_EQ(messaging::systemMessage_t::TRAFFIC_IDLE, messages.at(1));
+}
+
+TEST_F(SystemTest, TrafficIgnoresRealTime)
+{
+    EXPECT_CALL(_system._components._builderLeds._hwa, setState(_, _))
+        .Times(AnyNumber());
+
+    EXPECT_CALL(_system._components._builderMidi._hwaSerial, setLoopback(false))
+        .WillRepeatedly(Return(true));
+
+    ASSERT_TRUE(_system._instance.init());
+
+    std::vector<messaging::systemMessage_t> messages;
+
+    MidiDispatcher.listen(messaging::eventType_t::SYSTEM,
+                          [&messages](const messaging::Event& event)
+                          {
+                              if ((event.systemMessage == messaging::systemMessage_t::TRAFFIC_ACTIVE) ||
+                                  (event.systemMessage == messaging::systemMessage_t::TRAFFIC_IDLE))
+                              {
+                                  messages.push_back(event.systemMessage);
+                              }
+                          });
+
+    // clock runs all the time, even when nothing is played: it shouldn't defer the writes
+    for (auto message : { midi::messageType_t::SYS_REAL_TIME_CLOCK,
+                          midi::messageType_t::SYS_REAL_TIME_START,
+                          midi::messageType_t::SYS_REAL_TIME_CONTINUE,
+                          midi::messageType_t::SYS_REAL_TIME_STOP,
+                          midi::messageType_t::SYS_REAL_TIME_ACTIVE_SENSING,
+                          midi::messageType_t::SYS_REAL_TIME_SYSTEM_RESET })
+    {
+        messaging::Event event = {};
+        event.message          = message;
+
+        _helper.processIncoming(event);
+        core::mcu::timing::setMs(core::mcu::timing::ms() + 1);
+    }
+
+    ASSERT_TRUE(messages.empty());
+}
+
+TEST_F(SystemTest, TrafficDeferralBound)
+{
+    EXPECT_CALL(_system._components._builderLeds._hwa, setState(_, _))
+        .Times(AnyNumber());
+
+    EXPECT_CALL(_system._components._builderMidi._hwaSerial, setLoopback(false))
+        .WillRepeatedly(Return(true));
+
+    ASSERT_TRUE(_system._instance.init());
+
+    std::vector<messaging::systemMessage_t> messages;
+
+    MidiDispatcher.listen(messaging::eventType_t::SYSTEM,
+                          [&messages](const messaging::Event& event)
+                          {
+                              if ((event.systemMessage == messaging::systemMessage_t::TRAFFIC_ACTIVE) ||
+                                  (event.systemMessage == messaging::systemMessage_t::TRAFFIC_IDLE))
+                              {
+                                  messages.push_back(event.systemMessage);
+                              }
+                          });
+
+    messaging::Event event = {};
+    event.channel          = 1;
+    event.index            = 0;
+    event.value            = 127;
+    event.message          = midi::messageType_t::NOTE_ON;
+
+    // traffic which never stops long enough for idle state
+    constexpr uint32_t INTERVAL = sys::TRAFFIC_IDLE_DELAY / 2;
+
+    for (uint32_t elapsed = 0; elapsed < sys::MAX_TRAFFIC_DEFERRAL; elapsed += INTERVAL)
+    {
+        _helper.processIncoming(event);
+        _system._instance.run();
+        core::mcu::timing::setMs(core::mcu::timing::ms() + INTERVAL);
+    }
+
+    ASSERT_EQ(1, messages.size());
+    ASSERT_EQ(messaging::systemMessage_t::TRAFFIC_ACTIVE, messages.at(0));
+
+    // deferral bound reached: cached writes get stored and new deferral period starts
+    _helper.processIncoming(event);
+
+    ASSERT_EQ(3, messages.size());
+    ASSERT_EQ(messaging::systemMessage_t::TRAFFIC_IDLE, messages.at(1));
+    ASSERT_EQ(messaging::systemMessage_t::TRAFFIC_ACTIVE, messages.at(2));
+}
+
+TEST_F(SystemTest, TrafficDeferralEndsOnSysEx)
+{
+    EXPECT_CALL(_system._components._builderLeds._hwa, setState(_, _))
+        .Times(AnyNumber());
+
+    EXPECT_CALL(_system._components._builderMidi._hwaSerial, setLoopback(false))
+        .WillRepeatedly(Return(true));
+
+    ASSERT_TRUE(_system._instance.init());
+
+    std::vector<messaging::systemMessage_t> messages;
+
+    MidiDispatcher.listen(messaging::eventType_t::SYSTEM,
+                          [&messages](const messaging::Event& event)
+                          {
+                              if ((event.systemMessage == messaging::systemMessage_t::TRAFFIC_ACTIVE) ||
+                                  (event.systemMessage == messaging::systemMessage_t::TRAFFIC_IDLE))
+                              {
+                                  messages.push_back(event.systemMessage);
+                              }
+                          });
+
+    messaging::Event event = {};
+    event.channel          = 1;
+    event.index            = 0;
+    event.value            = 127;
+    event.message          = midi::messageType_t::NOTE_ON;
+
+    _helper.processIncoming(event);
+
+    ASSERT_EQ(1, messages.size());
+    ASSERT_EQ(messaging::systemMessage_t::TRAFFIC_ACTIVE, messages.at(0));
+
+    // SysEx not meant for this device is just another traffic
+    std::vector<uint8_t> sysEx = { 0xF0, 0x41, 0x10, 0x42, 0x12, 0xF7 };
+    _helper.processIncoming(_helper.rawSysExToUSBPackets(sysEx));
+
+    ASSERT_EQ(1, messages.size());
+
+    // acknowledged configuration changes are never deferred
+    handshake();
+
+    ASSERT_EQ(2, messages.size());
+    ASSERT_EQ(messaging::systemMessage_t::TRAFFIC_IDLE, messages.at(1));
+}
+
+TEST_F(SystemTest, BootTime)
+{
+    EXPECT_CALL(_system._components._builderLeds._hwa, setState(_, _))
+        .Times(AnyNumber());
+
+    EXPECT_CALL(_system._components._builderMidi._hwaSerial, setLoopback(false))
+        .WillRepeatedly(Return(true));
+
+    ASSERT_TRUE(_system._instance.init());
+    ASSERT_TRUE(_system._components._database.update(database::Config::Section::leds_t::GLOBAL, leds::setting_t::USE_STARTUP_ANIMATION, 1));
+
+    using ledState_t = std::pair<size_t, leds::brightness_t>;
+
+    std::vector<ledState_t> states = {};
+
+    EXPECT_CALL(_system._components._builderLeds._hwa, setState(_, _))
+        .WillRepeatedly(Invoke([&states](size_t index, leds::brightness_t brightness)
+                               {
+                                   states.push_back({ index, brightness });
+                               }));
+
+    // startup animation must not delay the init: it's shown while the system is already running
+    auto start   = std::chrono::steady_clock::now();
+    auto startMs = core::mcu::timing::ms();
+
+    ASSERT_TRUE(_system._instance.init());
+
+    auto elapsedMs = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+
+    LOG(INFO) << "Init with startup animation enabled: " << elapsedMs << " ms";
+    ASSERT_EQ(startMs, core::mcu::timing::ms());
+    ASSERT_LT(elapsedMs, static_cast<decltype(elapsedMs)>(leds::Leds::STARTUP_ANIMATION_HOLD_TIME));
+
+    // system must respond while the animation is still running
+    handshake();
+
+    // state set during the animation is shown once the animation is done
+    const size_t TOTAL_LEDS = leds::Collection::SIZE(leds::GROUP_DIGITAL_OUTPUTS);
+
+    if (TOTAL_LEDS)
+    {
+        _system._components._builderLeds._instance.setColor(0, leds::color_t::RED, leds::brightness_t::B100);
+    }
+
+    // all LEDs on, then passes over all LEDs, then LED states are restored
+    std::vector<ledState_t> expected = {};
+
+    for (size_t pass = 0; pass < leds::Leds::STARTUP_ANIMATION_PASSES; pass++)
+    {
+        for (size_t i = 0; i < TOTAL_LEDS; i++)
+        {
+            if (pass == 1)
+            {
+                expected.push_back({ TOTAL_LEDS - 1 - i, leds::brightness_t::B100 });
+            }
+            else
+            {
+                expected.push_back({ i, leds::brightness_t::OFF });
+            }
+        }
+    }
+
+    for (size_t i = 0; i < TOTAL_LEDS; i++)
+    {
+        expected.push_back({ i, i ? leds::brightness_t::OFF : leds::brightness_t::B100 });
+    }
+
+    states.clear();
+
+    const uint32_t ANIMATION_TIME = leds::Leds::STARTUP_ANIMATION_HOLD_TIME +
+                                    (TOTAL_LEDS * leds::Leds::STARTUP_ANIMATION_PASSES * leds::Leds::STARTUP_ANIMATION_FRAME_TIME);
+
+    for (uint32_t i = 1; i <= ANIMATION_TIME; i++)
+    {
+        core::mcu::timing::setMs(startMs + i);
+        _system._instance.run();
+
+        if (i < leds::Leds::STARTUP_ANIMATION_HOLD_TIME)
+        {
+            // all LEDs are still on
+            ASSERT_TRUE(states.empty());
+        }
+    }
+
+    ASSERT_EQ(expected, states);
+}
+
+TEST_F(SystemTest, BackupTime)
+{
+    // backup switches through all presets: component refresh on each switch is irrelevant here
+    EXPECT_CALL(_system._components._builderLeds._hwa, setState(_, _))
+        .Times(AnyNumber());
+
+    EXPECT_CALL(_system._components._builderMidi._hwaSerial, setLoopback(false))
+        .WillRepeatedly(Return(true));
+
+    ASSERT_TRUE(_system._instance.init());
+
+    handshake();
+
+    auto presets = supportedPresets();
+
+    std::vector<uint8_t> request = { 0xF0,
+                                     0x00,
+                                     0x53,
+                                     0x43,
+                                     0x00,
+                                     0x00,
+                                     SYSEX_CR_FULL_BACKUP,
+                                     0xF7 };
+
+    auto start = std::chrono::steady_clock::now();
+
+    _helper.sendRawSysExToStub(request);
+
+    auto elapsedUs = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    auto responses = _system._components._builderMidi._hwaUsb._writeParser.writtenMessages();
+
+    // restore start marker, per-preset preset change and section responses, restore end marker and end marker
+    ASSERT_GT(responses.size(), static_cast<size_t>(presets));
+
+    // backup must be terminated with the same custom request
+    std::vector<uint8_t> endMarker(responses.back().sysexArray, responses.back().sysexArray + responses.back().length);
+    ASSERT_EQ(SYSEX_CR_FULL_BACKUP, endMarker.at(6));
+
+    LOG(INFO) << "Full backup: " << responses.size() << " responses in " << elapsedUs << " us, "
+              << (elapsedUs / static_cast<double>(responses.size())) << " us per response";
+}
+
+#ifdef PROJECT_TARGET_SUPPORT_DIN_MIDI
+TEST_F(SystemTest, ConfigTransaction)
+{
+    EXPECT_CALL(_system._components._builderLeds._hwa, setState(_, _))
+        .Times(AnyNumber());
+
+    EXPECT_CALL(_system._components._builderMidi._hwaSerial, setLoopback(false))
+        .WillOnce(Return(true));
+
+    ASSERT_TRUE(_system._instance.init());
+
+    handshake();
+
+    auto customRequest = [this](uint8_t request)
+    {
+        auto response = _helper.sendRawSysExToStub(std::vector<uint8_t>({ 0xF0,
+                                                                          0x00,
+                                                                          0x53,
+                                                                          0x43,
+                                                                          0x00,
+                                                                          0x00,
+                                                                          request,
+                                                                          0xF7 }));
+
+        ASSERT_EQ(static_cast<uint8_t>(sys::Config::Status::ACK), response.at(4));
+    };
+
+    // within the transaction every change is stored right away, but DIN MIDI is
+    // reinitialized only once, on commit, with the most recently requested state
+    EXPECT_CALL(_system._components._builderMidi._hwaSerial, deInit())
+        .Times(0);
+
+    EXPECT_CALL(_system._components._builderMidi._hwaSerial, init())
+        .Times(0);
+
+    customRequest(SYSEX_CR_CONFIG_TRANSACTION_BEGIN);
+
+    constexpr size_t TOGGLES = 8;
+
+    auto start = std::chrono::steady_clock::now();
+
+    for (size_t i = 0; i < TOGGLES; i++)
+    {
+        ASSERT_TRUE(_helper.databaseWriteToSystemViaSysEx(sys::Config::Section::global_t::MIDI_SETTINGS,
+                                                          protocol::midi::setting_t::DIN_ENABLED,
+                                                          (i % 2) ? 0 : 1));
+
+        ASSERT_TRUE(_helper.databaseWriteToSystemViaSysEx(sys::Config::Section::global_t::MIDI_SETTINGS,
+                                                          protocol::midi::setting_t::DIN_THRU_DIN,
+                                                          (i % 2) ? 0 : 1));
+    }
+
+    // last change enables DIN again
+    ASSERT_TRUE(_helper.databaseWriteToSystemViaSysEx(sys::Config::Section::global_t::MIDI_SETTINGS,
+                                                      protocol::midi::setting_t::DIN_ENABLED,
+                                                      1));
+
+    ::testing::Mock::VerifyAndClearExpectations(&_system._components._builderMidi._hwaSerial);
+
+    EXPECT_CALL(_system._components._builderMidi._hwaSerial, init())
+        .WillOnce(Return(true));
+
+    // loopback isn't set separately once the interface is initialized
+    EXPECT_CALL(_system._components._builderMidi._hwaSerial, setLoopback(_))
+        .Times(0);
+
+    customRequest(SYSEX_CR_CONFIG_TRANSACTION_COMMIT);
+
+    auto elapsedUs = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+    LOG(INFO) << "Config transaction with " << (TOGGLES * 2 + 1) << " values applied in " << elapsedUs << " us";
+
+    ASSERT_EQ(1, _helper.databaseReadFromSystemViaSysEx(sys::Config::Section::global_t::MIDI_SETTINGS, protocol::midi::setting_t::DIN_ENABLED));
+}
+
+TEST_F(SystemTest, ConfigTransactionTimeout)
+{
+    EXPECT_CALL(_system._components._builderLeds._hwa, setState(_, _))
+        .Times(AnyNumber());
+
+    EXPECT_CALL(_system._components._builderMidi._hwaSerial, setLoopback(false))
+        .WillOnce(Return(true));
+
+    ASSERT_TRUE(_system._instance.init());
+
+    handshake();
+
+    auto response = _helper.sendRawSysExToStub(std::vector<uint8_t>({ 0xF0,
+                                                                      0x00,
+                                                                      0x53,
+                                                                      0x43,
+                                                                      0x00,
+                                                                      0x00,
+                                                                      SYSEX_CR_CONFIG_TRANSACTION_BEGIN,
+                                                                      0xF7 }));
+
+    ASSERT_EQ(static_cast<uint8_t>(sys::Config::Status::ACK), response.at(4));
+
+    EXPECT_CALL(_system._components._builderMidi._hwaSerial, init())
+        .Times(0);
+
+    ASSERT_TRUE(_helper.databaseWriteToSystemViaSysEx(sys::Config::Section::global_t::MIDI_SETTINGS,
+                                                      protocol::midi::setting_t::DIN_ENABLED,
+                                                      1));
+
+    // host went away without commit: any configuration message pushes the timeout back
+    core::mcu::timing::setMs(core::mcu::timing::ms() + sys::CONFIG_TRANSACTION_TIMEOUT - 1);
+    _system._instance.run();
+
+    ASSERT_EQ(1, _helper.databaseReadFromSystemViaSysEx(sys::Config::Section::global_t::MIDI_SETTINGS, protocol::midi::setting_t::DIN_ENABLED));
+
+    core::mcu::timing::setMs(core::mcu::timing::ms() + sys::CONFIG_TRANSACTION_TIMEOUT - 1);
+    _system._instance.run();
+
+    ::testing::Mock::VerifyAndClearExpectations(&_system._components._builderMidi._hwaSerial);
+
+    // once it expires, the transaction is committed on its own
+    EXPECT_CALL(_system._components._builderMidi._hwaSerial, init())
+        .WillOnce(Return(true));
+
+    EXPECT_CALL(_system._components._builderMidi._hwaSerial, setLoopback(_))
+        .Times(0);
+
+    core::mcu::timing::setMs(core::mcu::timing::ms() + 1);
+    _system._instance.run();
+
+    ::testing::Mock::VerifyAndClearExpectations(&_system._components._builderMidi._hwaSerial);
+
+    // commit without open transaction does nothing
+    EXPECT_CALL(_system._components._builderMidi._hwaSerial, init())
+        .Times(0);
+
+    response = _helper.sendRawSysExToStub(std::vector<uint8_t>({ 0xF0,
+                                                                 0x00,
+                                                                 0x53,
+                                                                 0x43,
+                                                                 0x00,
+                                                                 0x00,
+                                                                 SYSEX_CR_CONFIG_TRANSACTION_COMMIT,
+                                                                 0xF7 }));
+
+    ASSERT_EQ(static_cast<uint8_t>(sys::Config::Status::ACK), response.at(4));
+}
+#endif
+
 #endif
\ No newline at end of file